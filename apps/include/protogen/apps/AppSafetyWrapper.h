@@ -14,6 +14,8 @@ public:
     void setActive(bool active) override;
     void receiveRenderSurface(std::shared_ptr<IRenderSurface> render_surface) override;
     void receiveSensors(std::vector<std::shared_ptr<sensor::ISensor>> sensors) override;
+    bool usesFrameScheduler() const override;
+    void render(ICanvas& canvas, const FrameInfo& frame) override;
 
 private:
     std::shared_ptr<IProtogenApp> m_app;
@@ -0,0 +1,132 @@
+#ifndef PROTOGEN_FRAME_SCHEDULER_H
+#define PROTOGEN_FRAME_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <protogen/FrameInfo.hpp>
+#include <protogen/IProtogenApp.hpp>
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/presentation/FrameMetrics.h>
+
+namespace protogen {
+
+/**
+ * The core render loop. On its own thread, it ticks at a frame rate and
+ * calls `IProtogenApp::render` of the current app, if the app uses the
+ * frame scheduler, inside `drawFrame` of the app's render surface.
+ *
+ * With Mode::Fixed, frames are due every 1 / fps seconds. With
+ * Mode::Adaptive, the period grows when frames take longer than it, down
+ * to `min_fps`, and shrinks back toward `fps` once they are fast again,
+ * so a slow app runs smoothly at a lower rate instead of missing every
+ * deadline. A frame finished after the next one was due counts as a
+ * missed deadline and the clock restarts from then, rather than rendering
+ * the missed frames in a burst.
+ *
+ * Without a current app, or with one which draws on its own thread, the
+ * loop sleeps and uses no CPU.
+ */
+class FrameScheduler {
+public:
+    enum class Mode {
+        Fixed,
+        Adaptive,
+    };
+
+    struct Config {
+        double fps;
+        Mode mode;
+        // Lowest frame rate Mode::Adaptive slows down to.
+        double min_fps;
+    };
+
+    static constexpr Config DEFAULT_CONFIG = {60.0, Mode::Adaptive, 15.0};
+
+    explicit FrameScheduler(Config config = DEFAULT_CONFIG);
+    ~FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /**
+     * The default configuration, changed by PROTOGEN_FRAME_RATE, a frame
+     * rate such as "60", and PROTOGEN_FRAME_RATE_MODE, "fixed" or
+     * "adaptive".
+     */
+    static Config configFromEnvironment();
+    static std::optional<Mode> parseMode(const std::string& mode);
+
+    void start();
+    /**
+     * Stops the loop after the frame being rendered, if any.
+     */
+    void stop();
+
+    /**
+     * Renders `app` onto `surface` from the next frame on, or nothing if
+     * `app` is null. Waits for a frame of the previous app being rendered
+     * to finish, so once this returns, the previous app is not rendered
+     * anymore.
+     */
+    void setApp(std::shared_ptr<IProtogenApp> app, std::shared_ptr<IRenderSurface> surface);
+
+    /**
+     * Frames rendered so far.
+     */
+    uint64_t frames() const;
+    /**
+     * Frames which finished after the next frame was due.
+     */
+    uint64_t missedDeadlines() const;
+    /**
+     * The current frame rate.
+     */
+    double fps() const;
+
+private:
+    void loop();
+    /**
+     * Renders one frame of the current app. Returns how long it took, or
+     * nothing if there is no app to render.
+     */
+    std::optional<std::chrono::nanoseconds> renderFrame(std::chrono::steady_clock::time_point due);
+    void adapt(std::chrono::nanoseconds work);
+    /**
+     * Counts a missed deadline in the frame metrics of the current app.
+     */
+    void recordMissedDeadline();
+
+    Config m_config;
+    std::chrono::nanoseconds m_targetPeriod;
+    std::chrono::nanoseconds m_maxPeriod;
+    std::atomic<int64_t> m_period;  // Nanoseconds.
+
+    // Held while rendering, so `setApp` can wait for a frame to finish.
+    std::mutex m_renderMutex;
+    std::shared_ptr<IProtogenApp> m_app;
+    std::shared_ptr<IRenderSurface> m_surface;
+    std::shared_ptr<FrameTimings> m_appTimings;
+    std::optional<std::chrono::steady_clock::time_point> m_previousDue;  // Of the current app.
+    bool m_reportedFailure;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_hasApp;      // Guarded by m_wakeMutex.
+    bool m_stopping;    // Guarded by m_wakeMutex.
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_frames;
+    std::atomic<uint64_t> m_missedDeadlines;
+};
+
+}   // namespace
+
+#endif
@@ -4,6 +4,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <filesystem>
 #include <optional>
 #include <dlfcn.h>
@@ -28,10 +29,24 @@ public:
     );
     Initialization initialize(ExtensionOriginBundle extension) override;
 
+    /**
+     * The render surface given to `app` when it was initialized, or the
+     * render surface of this initializer if it was not initialized here.
+     */
+    std::shared_ptr<IRenderSurface> renderSurfaceOf(const IProtogenApp& app) const;
+
 private:
+    /**
+     * The render surface to give `app`, scaled to its preferred resolution
+     * if it has one.
+     */
+    std::shared_ptr<IRenderSurface> renderSurfaceFor(const IProtogenApp& app) const;
+
     std::shared_ptr<IExtensionInitializer> m_initialExtensionInitializer;
     std::vector<std::shared_ptr<sensor::ISensor>> m_sensors;
     std::shared_ptr<IRenderSurface> m_renderSurface;
+    mutable std::mutex m_appSurfacesMutex;
+    std::map<const IProtogenApp *, std::shared_ptr<IRenderSurface>> m_appSurfaces;
 };
 
 }   // namespace
@@ -45,3 +45,22 @@ void protogen::AppSafetyWrapper::receiveSensors(std::vector<std::shared_ptr<sens
         std::cerr << "An exception occurred while receiving sensors for an app." << std::endl;
     }
 }
+
+bool protogen::AppSafetyWrapper::usesFrameScheduler() const
+{
+    try {
+        return m_app->usesFrameScheduler();
+    } catch(...) {
+        std::cerr << "An exception occurred while asking whether an app uses the frame scheduler." << std::endl;
+        return false;
+    }
+}
+
+void protogen::AppSafetyWrapper::render(ICanvas &canvas, const FrameInfo &frame)
+{
+    try {
+        m_app->render(canvas, frame);
+    } catch(...) {
+        std::cerr << "An exception occurred while rendering an app." << std::endl;
+    }
+}
@@ -0,0 +1,243 @@
+#include <protogen/apps/FrameScheduler.h>
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/FrameMetrics.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+using namespace protogen;
+
+namespace {
+
+std::chrono::nanoseconds periodOf(double fps) {
+    return std::chrono::nanoseconds(static_cast<int64_t>(1e9 / fps));
+}
+
+} // namespace
+
+protogen::FrameScheduler::FrameScheduler(Config config)
+    : m_config(config),
+    m_targetPeriod(),
+    m_maxPeriod(),
+    m_period(0),
+    m_renderMutex(),
+    m_app(),
+    m_surface(),
+    m_appTimings(),
+    m_previousDue(),
+    m_reportedFailure(false),
+    m_wakeMutex(),
+    m_wake(),
+    m_hasApp(false),
+    m_stopping(false),
+    m_thread(),
+    m_frames(0),
+    m_missedDeadlines(0)
+{
+    if(!(m_config.fps > 0)) {
+        m_config.fps = DEFAULT_CONFIG.fps;
+    }
+    if(!(m_config.min_fps > 0) || m_config.min_fps > m_config.fps) {
+        m_config.min_fps = m_config.fps;
+    }
+    m_targetPeriod = periodOf(m_config.fps);
+    m_maxPeriod = periodOf(m_config.min_fps);
+    m_period = m_targetPeriod.count();
+}
+
+protogen::FrameScheduler::~FrameScheduler()
+{
+    stop();
+}
+
+FrameScheduler::Config protogen::FrameScheduler::configFromEnvironment()
+{
+    Config config = DEFAULT_CONFIG;
+    if(const char * fps_env = std::getenv("PROTOGEN_FRAME_RATE")) {
+        const double fps = std::strtod(fps_env, nullptr);
+        if(fps > 0) {
+            config.fps = fps;
+            config.min_fps = std::min(config.min_fps, fps);
+        }
+    }
+    if(const char * mode_env = std::getenv("PROTOGEN_FRAME_RATE_MODE")) {
+        const auto mode = parseMode(mode_env);
+        if(mode.has_value()) {
+            config.mode = mode.value();
+        } else {
+            std::cerr << "Unknown frame rate mode `" << mode_env << "`. Expected `fixed` or `adaptive`." << std::endl;
+        }
+    }
+    return config;
+}
+
+std::optional<FrameScheduler::Mode> protogen::FrameScheduler::parseMode(const std::string &mode)
+{
+    if(mode == "fixed") {
+        return Mode::Fixed;
+    }
+    if(mode == "adaptive") {
+        return Mode::Adaptive;
+    }
+    return {};
+}
+
+void protogen::FrameScheduler::start()
+{
+    if(m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = false;
+    }
+    m_thread = std::thread(&FrameScheduler::loop, this);
+}
+
+void protogen::FrameScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if(m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void protogen::FrameScheduler::setApp(std::shared_ptr<IProtogenApp> app, std::shared_ptr<IRenderSurface> surface)
+{
+    bool uses_frame_scheduler = false;
+    std::shared_ptr<FrameTimings> app_timings;
+    if(app != nullptr && surface != nullptr) {
+        try {
+            uses_frame_scheduler = app->usesFrameScheduler();
+            if(uses_frame_scheduler) {
+                app_timings = FrameMetrics::global().timings(FrameMetrics::Source::App, app->getAttribute(attributes::A_ID).value_or("<no id>"));
+            }
+        } catch(...) {
+            uses_frame_scheduler = false;
+            std::cerr << "An exception occurred while asking an app whether it uses the frame scheduler." << std::endl;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_renderMutex);
+        m_app = uses_frame_scheduler ? app : nullptr;
+        m_surface = uses_frame_scheduler ? surface : nullptr;
+        m_appTimings = app_timings;
+        m_previousDue.reset();
+        m_reportedFailure = false;
+        m_period = m_targetPeriod.count();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_hasApp = uses_frame_scheduler;
+    }
+    m_wake.notify_all();
+}
+
+uint64_t protogen::FrameScheduler::frames() const
+{
+    return m_frames.load();
+}
+
+uint64_t protogen::FrameScheduler::missedDeadlines() const
+{
+    return m_missedDeadlines.load();
+}
+
+double protogen::FrameScheduler::fps() const
+{
+    return 1e9 / m_period.load();
+}
+
+void protogen::FrameScheduler::loop()
+{
+    using Clock = std::chrono::steady_clock;
+    auto next = Clock::now();
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            if(!m_hasApp && !m_stopping) {
+                m_wake.wait(lock, [this]{ return m_stopping || m_hasApp; });
+                // Start a new clock rather than catching up on the idle time.
+                next = Clock::now();
+            }
+            if(m_stopping) {
+                return;
+            }
+        }
+
+        const auto due = next;
+        const auto work = renderFrame(due);
+        if(!work.has_value()) {
+            continue;
+        }
+        adapt(work.value());
+
+        next = due + std::chrono::nanoseconds(m_period.load());
+        const auto now = Clock::now();
+        if(now > next) {
+            ++m_missedDeadlines;
+            recordMissedDeadline();
+            next = now;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait_until(lock, next, [this]{ return m_stopping; });
+    }
+}
+
+std::optional<std::chrono::nanoseconds> protogen::FrameScheduler::renderFrame(std::chrono::steady_clock::time_point due)
+{
+    std::lock_guard<std::mutex> lock(m_renderMutex);
+    if(m_app == nullptr) {
+        return {};
+    }
+    const FrameInfo frame{
+        m_frames.load() + 1,
+        due,
+        m_previousDue.has_value() ? std::chrono::duration_cast<std::chrono::nanoseconds>(due - m_previousDue.value()) : std::chrono::nanoseconds(0),
+        std::chrono::nanoseconds(m_period.load())
+    };
+    m_previousDue = due;
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        m_surface->drawFrame([this, &frame](ICanvas& canvas){
+            canvas.fill(0, 0, 0);
+            m_app->render(canvas, frame);
+        });
+    } catch(...) {
+        // Keep the frame clock going; report once per app, not per frame.
+        if(!m_reportedFailure) {
+            std::cerr << "An exception occurred while rendering the app of id `" << m_app->getAttribute(attributes::A_ID).value_or("<no id>") << "`." << std::endl;
+            m_reportedFailure = true;
+        }
+    }
+    ++m_frames;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
+
+void protogen::FrameScheduler::recordMissedDeadline()
+{
+    std::lock_guard<std::mutex> lock(m_renderMutex);
+    if(m_appTimings != nullptr) {
+        m_appTimings->recordMissedDeadline();
+    }
+}
+
+void protogen::FrameScheduler::adapt(std::chrono::nanoseconds work)
+{
+    if(m_config.mode != Mode::Adaptive) {
+        return;
+    }
+    const int64_t period = m_period.load();
+    if(work.count() > period) {
+        m_period = std::min(m_maxPeriod.count(), work.count() * 5 / 4);
+    } else if(work.count() < period / 2) {
+        m_period = std::max(m_targetPeriod.count(), period * 9 / 10);
+    }
+}
@@ -1,6 +1,10 @@
 #include <protogen/apps/ProtogenAppInitializer.h>
 
 #include <protogen/IProtogenApp.hpp>
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/ScalingRenderSurface.h>
+#include <protogen/presentation/FrameTimingRenderSurface.h>
+#include <protogen/presentation/FrameMetrics.h>
 
 namespace protogen
 {
@@ -12,7 +16,9 @@ ProtogenAppInitializer::ProtogenAppInitializer(
 )
     : m_initialExtensionInitializer(initialExtensionInitializer),
     m_sensors(sensors),
-    m_renderSurface(renderSurface)
+    m_renderSurface(renderSurface),
+    m_appSurfacesMutex(),
+    m_appSurfaces()
 {
 }
 
@@ -29,9 +35,49 @@ IExtensionInitializer::Initialization ProtogenAppInitializer::initialize(Extensi
         std::cerr << "Tried to initialize app but extension is not an app from directory: `" << extension.extension_directory.generic_string() << "`." << std::endl;
         return IExtensionInitializer::Initialization::Failure;
     }
-    app->receiveRenderSurface(m_renderSurface);
+    // Timed per app, on top of the timings of the surface itself.
+    const auto timings = FrameMetrics::global().timings(FrameMetrics::Source::App, app->getAttribute(attributes::A_ID).value_or("<no id>"));
+    const auto render_surface = std::make_shared<FrameTimingRenderSurface>(renderSurfaceFor(*app), timings);
+    {
+        std::lock_guard<std::mutex> lock(m_appSurfacesMutex);
+        m_appSurfaces[app] = render_surface;
+    }
+    app->receiveRenderSurface(render_surface);
     app->receiveSensors(m_sensors);
     return IExtensionInitializer::Initialization::Success;
 }
 
-} // namespace
\ No newline at end of file
+std::shared_ptr<IRenderSurface> ProtogenAppInitializer::renderSurfaceOf(const IProtogenApp &app) const
+{
+    std::lock_guard<std::mutex> lock(m_appSurfacesMutex);
+    const auto found = m_appSurfaces.find(&app);
+    if(found == m_appSurfaces.end()) {
+        return m_renderSurface;
+    }
+    return found->second;
+}
+
+std::shared_ptr<IRenderSurface> ProtogenAppInitializer::renderSurfaceFor(const IProtogenApp &app) const
+{
+    const auto preferred_resolution_string = app.getAttribute(attributes::A_PREFERRED_RESOLUTION);
+    if(!preferred_resolution_string.has_value()) {
+        return m_renderSurface;
+    }
+    const auto id = app.getAttribute(attributes::A_ID).value_or("<no id>");
+    const auto preferred_resolution = ScalingRenderSurface::parseResolution(preferred_resolution_string.value());
+    if(!preferred_resolution.has_value()) {
+        std::cerr << "App of id `" << id << "` has an invalid preferred resolution `" << preferred_resolution_string.value() << "`. It draws at the resolution of the render surface instead." << std::endl;
+        return m_renderSurface;
+    }
+    const auto resolution = m_renderSurface->resolution();
+    if(preferred_resolution->width() == resolution.width() && preferred_resolution->height() == resolution.height()) {
+        return m_renderSurface;
+    }
+    const auto filter = ScalingRenderSurface::parseFilter(app.getAttribute(attributes::A_SCALING_FILTER).value_or("nearest"));
+    if(!filter.has_value()) {
+        std::cerr << "App of id `" << id << "` has an unknown scaling filter. Nearest is used instead." << std::endl;
+    }
+    return std::shared_ptr<IRenderSurface>(new ScalingRenderSurface(m_renderSurface, preferred_resolution.value(), filter.value_or(ImageScaler::Filter::Nearest)));
+}
+
+} // namespace
@@ -0,0 +1,85 @@
+/**
+ * Measures how banded rendering scales with the number of threads.
+ *
+ * A scene of filled polygons, ellipses, lines and blended sprites is
+ * recorded once and then rendered with 1 to N threads, where N defaults to
+ * the number of hardware threads. Usage:
+ *     banded_rendering_benchmark [width height [max_threads [frames]]]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <protogen/presentation/BandedRenderer.h>
+#include <protogen/presentation/DisplayList.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/RecordingCanvas.h>
+
+using namespace protogen;
+
+namespace {
+
+void drawScene(ICanvas& canvas, const std::vector<uint8_t>& sprite, int sprite_size) {
+    const int width = canvas.width();
+    const int height = canvas.height();
+    canvas.fill(8, 8, 16);
+    for(int i = 0; i < 64; ++i) {
+        const int x = (i * 97) % width;
+        const int y = (i * 53) % height;
+        canvas.drawPolygon({{x, y}, {x + width / 6, y + height / 9}, {x + width / 12, y + height / 3}, {x - width / 16, y + height / 5}}, i * 4, 255 - i * 4, 128, true);
+        canvas.drawEllipse(width - x - width / 10, y, width / 10, height / 6, 255, i * 4, 0, true);
+        canvas.drawLine(0, y, width - 1, height - 1 - y, 255, 255, 255);
+    }
+    for(int i = 0; i < 32; ++i) {
+        canvas.blendBlit(sprite.data(), sprite_size * 4, (i * 131) % width, (i * 71) % height, sprite_size, sprite_size);
+    }
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    const int width = argc > 2 ? std::atoi(argv[1]) : 1920;
+    const int height = argc > 2 ? std::atoi(argv[2]) : 480;
+    const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int max_threads = argc > 3 ? std::atoi(argv[3]) : hardware_threads;
+    const int frames = argc > 4 ? std::atoi(argv[4]) : 100;
+
+    const int sprite_size = 64;
+    std::vector<uint8_t> sprite(sprite_size * sprite_size * 4);
+    for(std::size_t i = 0; i < sprite.size(); ++i) {
+        sprite[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    DisplayList list;
+    RecordingCanvas recorder(list, width, height);
+    drawScene(recorder, sprite, sprite_size);
+    MemoryCanvas frame(width, height);
+
+    std::cout << "Banded rendering at " << width << "x" << height << ", " << frames << " frames, "
+        << list.size() << " commands per frame" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "frames/s" << std::setw(10) << "speedup" << std::endl;
+
+    double single_threaded_fps = 0;
+    for(unsigned int threads = 1; threads <= max_threads; ++threads) {
+        BandedRenderer renderer(threads);
+        renderer.render(list, frame); // Warm up caches and thread stacks.
+
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < frames; ++i) {
+            frame.clear();
+            renderer.render(list, frame);
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const double fps = frames / elapsed.count();
+        if(threads == 1) {
+            single_threaded_fps = fps;
+        }
+        std::cout << std::setw(8) << threads
+            << std::setw(12) << std::fixed << std::setprecision(1) << fps
+            << std::setw(9) << std::setprecision(2) << fps / single_threaded_fps << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * Measures how long ImageScaler takes per frame for common pairs of
+ * logical and physical resolutions, with both filters. Usage:
+ *     image_scaling_benchmark [frames]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <protogen/presentation/ImageScaler.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+using namespace protogen;
+
+namespace {
+
+struct Case {
+    int source_width;
+    int source_height;
+    int target_width;
+    int target_height;
+};
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const std::vector<Case> cases = {
+        {128, 32, 512, 128},
+        {512, 512, 128, 32},
+        {128, 32, 1920, 480},
+        {64, 16, 128, 32},
+    };
+
+    std::cout << "Image scaling, " << frames << " frames per case" << std::endl;
+    std::cout << std::setw(12) << "from" << std::setw(12) << "to" << std::setw(12) << "nearest" << std::setw(12) << "bilinear" << "  (us/frame)" << std::endl;
+    for(const auto& c : cases) {
+        MemoryCanvas source(c.source_width, c.source_height);
+        for(int y = 0; y < c.source_height; ++y) {
+            for(int x = 0; x < c.source_width; ++x) {
+                source.setPixel(x, y, x * 7, y * 13, (x + y) * 3);
+            }
+        }
+        MemoryCanvas target(c.target_width, c.target_height);
+        std::cout << std::setw(12) << (std::to_string(c.source_width) + "x" + std::to_string(c.source_height))
+            << std::setw(12) << (std::to_string(c.target_width) + "x" + std::to_string(c.target_height));
+        for(const auto filter : {ImageScaler::Filter::Nearest, ImageScaler::Filter::Bilinear}) {
+            ImageScaler scaler(c.source_width, c.source_height, c.target_width, c.target_height, filter);
+            scaler.scale(source, target); // Warm up caches.
+            const auto start = std::chrono::steady_clock::now();
+            for(int i = 0; i < frames; ++i) {
+                scaler.scale(source, target);
+            }
+            const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << std::setw(12) << std::fixed << std::setprecision(1) << elapsed.count() / frames;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * Replays a frame recording, made by running the protogen software with
+ * PROTOGEN_RECORD_FILE set, through a render surface and prints how long
+ * the surface took, so surfaces can be compared on the same frames.
+ *
+ * The surface is "sdl" (SdlRenderSurface), "hub75" (ProtogenHeadMatrices)
+ * or "fake". Frames are replayed as fast as possible unless --realtime is
+ * given, in which case they keep their recorded timing. Both surfaces
+ * present on their own thread and drop frames the replay outruns, so the
+ * frames they presented and dropped are printed too, when they report
+ * them. SDL_VIDEODRIVER defaults to "dummy" so the benchmark runs headless.
+ * Usage:
+ *     replay_benchmark <recording> [sdl|hub75|fake] [--realtime] [--loops N]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/FrameRecording.h>
+#include <protogen/presentation/FrameReplay.h>
+#include <protogen/presentation/protogen.h>
+#include <protogen/presentation/render_surface.h>
+#include <protogen/presentation/sdl_render_surface.h>
+
+using namespace protogen;
+
+namespace {
+
+std::shared_ptr<IRenderSurface> makeSurface(const std::string& name, const FrameRecording& recording) {
+    if(name == "sdl") {
+        setenv("SDL_VIDEODRIVER", "dummy", 0);
+        setenv("PROTOGEN_SDL_RENDER_SURFACE_WIDTH", std::to_string(recording.width()).c_str(), 0);
+        setenv("PROTOGEN_SDL_RENDER_SURFACE_HEIGHT", std::to_string(recording.height()).c_str(), 0);
+        return std::shared_ptr<IRenderSurface>(new SdlRenderSurface());
+    }
+    if(name == "hub75") {
+        return std::shared_ptr<IRenderSurface>(new ProtogenHeadMatrices());
+    }
+    if(name == "fake") {
+        return std::shared_ptr<IRenderSurface>(new FakeRenderSurface(Resolution(recording.width(), recording.height())));
+    }
+    return nullptr;
+}
+
+void printAttribute(const IRenderSurface& surface, const char * key) {
+    const auto value = surface.getAttribute(key);
+    if(value.has_value()) {
+        std::cout << std::setw(20) << key << ": " << *value << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <recording> [sdl|hub75|fake] [--realtime] [--loops N]" << std::endl;
+        return 1;
+    }
+    std::string surface_name = "sdl";
+    auto timing = FrameReplay::Timing::AsFastAsPossible;
+    int loops = 1;
+    for(int i = 2; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--realtime") == 0) {
+            timing = FrameReplay::Timing::Original;
+        } else if(std::strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+            loops = std::max(std::atoi(argv[++i]), 1);
+        } else {
+            surface_name = argv[i];
+        }
+    }
+
+    try
+    {
+        const FrameRecording recording(argv[1]);
+        auto surface = makeSurface(surface_name, recording);
+        if(surface == nullptr) {
+            std::cerr << "Unknown render surface: " << surface_name << std::endl;
+            return 1;
+        }
+        if(surface->initialize() != IRenderSurface::Initialization::Success) {
+            std::cerr << "Could not initialize render surface: " << surface_name << std::endl;
+            return 1;
+        }
+
+        std::cout << "Replaying " << recording.frameCount() << " frames of " << recording.width() << "x" << recording.height()
+            << " (" << std::chrono::duration<double>(recording.duration()).count() << " s recorded) through " << surface_name
+            << (timing == FrameReplay::Timing::Original ? " at the recorded timing" : " as fast as possible")
+            << ", " << loops << " time(s)" << std::endl;
+        FrameReplay replay(recording, surface);
+        const auto result = replay.run(timing, loops);
+
+        const auto micros = [](std::chrono::nanoseconds duration) {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        };
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << std::setw(20) << "frames" << ": " << result.frames << std::endl;
+        std::cout << std::setw(20) << "frames per second" << ": " << result.framesPerSecond() << std::endl;
+        std::cout << std::setw(20) << "draw us/frame" << ": " << (result.frames == 0 ? 0.0 : micros(result.draw_time) / result.frames) << std::endl;
+        std::cout << std::setw(20) << "longest draw us" << ": " << micros(result.longest_draw) << std::endl;
+        if(timing == FrameReplay::Timing::Original) {
+            std::cout << std::setw(20) << "most late us" << ": " << micros(result.most_late) << std::endl;
+        }
+        if(result.malformed_frames != 0) {
+            std::cout << std::setw(20) << "malformed frames" << ": " << result.malformed_frames << std::endl;
+        }
+        printAttribute(*surface, attributes::A_PRESENTED_FRAMES);
+        printAttribute(*surface, attributes::A_DROPPED_FRAMES);
+        printAttribute(*surface, attributes::A_LATE_FRAMES);
+        printAttribute(*surface, attributes::A_PRESENT_TIME);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Could not replay " << argv[1] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
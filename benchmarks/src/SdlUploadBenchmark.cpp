@@ -0,0 +1,132 @@
+/**
+ * Compares drawing straight to an SDL renderer with SdlRenderSurface, which
+ * draws into an offscreen canvas and uploads it through a streaming
+ * texture.
+ *
+ * An animated scene of filled polygons, lines, a sprite and individually
+ * set pixels is drawn at 128x32, 512x128 and 1920x480. The surface presents
+ * on its own thread and skips frames the app outruns, so its rate is the
+ * number of frames it presented, with pacing disabled. SDL_VIDEODRIVER defaults to "dummy" so the benchmark runs
+ * headless with SDL's software renderer; set it to benchmark a real
+ * display and GPU. Usage:
+ *     sdl_upload_benchmark [frames]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/sdl_render_surface.h>
+
+using namespace protogen;
+
+namespace {
+
+void drawScene(ICanvas& canvas, int frame, const std::vector<uint8_t>& sprite, int sprite_size) {
+    const int width = canvas.width();
+    const int height = canvas.height();
+    const int offset = frame % width;
+    canvas.fill(0, 0, 0);
+    for(int i = 0; i < 8; ++i) {
+        const int x = (offset + i * width / 8) % width;
+        canvas.drawPolygon({{x, height / 4}, {x + width / 12, height / 2}, {x, height * 3 / 4}, {x - width / 12, height / 2}}, 0, 255 - i * 16, i * 16, true);
+        canvas.drawLine(x, 0, width - 1 - x, height - 1, 255, 255, 255);
+    }
+    canvas.blit(sprite.data(), sprite_size * 3, offset, height / 2 - sprite_size / 2, sprite_size, sprite_size);
+    // Apps often draw sparse effects pixel by pixel.
+    for(int i = 0; i < width * height / 16; ++i) {
+        canvas.setPixel((i * 7919 + frame) % width, (i * 104729) % height, 255, i % 256, 0);
+    }
+}
+
+struct Result {
+    double frames_per_second;
+    bool ok;
+};
+
+Result benchmarkRenderer(int width, int height, int frames, const std::vector<uint8_t>& sprite, int sprite_size) {
+    if(SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::cerr << "Could not initialize SDL: " << SDL_GetError() << std::endl;
+        return {0, false};
+    }
+    SDL_Window * window = SDL_CreateWindow("benchmark", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_HIDDEN);
+    SDL_Renderer * renderer = window ? SDL_CreateRenderer(window, -1, 0) : NULL;
+    if(renderer == NULL) {
+        std::cerr << "Could not create renderer: " << SDL_GetError() << std::endl;
+        if(window) {
+            SDL_DestroyWindow(window);
+        }
+        SDL_Quit();
+        return {0, false};
+    }
+    SDL_RenderSetLogicalSize(renderer, width, height);
+
+    SdlRendererToICanvasAdapter canvas(renderer, width, height);
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < frames; ++i) {
+        drawScene(canvas, i, sprite, sprite_size);
+        SDL_RenderPresent(renderer);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return {frames / elapsed.count(), true};
+}
+
+Result benchmarkSurface(int width, int height, int frames, const std::vector<uint8_t>& sprite, int sprite_size) {
+    setenv("PROTOGEN_SDL_RENDER_SURFACE_WIDTH", std::to_string(width).c_str(), 1);
+    setenv("PROTOGEN_SDL_RENDER_SURFACE_HEIGHT", std::to_string(height).c_str(), 1);
+    SdlRenderSurface surface;
+    if(surface.initialize() != IRenderSurface::Initialization::Success) {
+        return {0, false};
+    }
+    int frame = 0;
+    const auto drawer = [&](ICanvas& canvas) { drawScene(canvas, frame, sprite, sprite_size); };
+    const auto start = std::chrono::steady_clock::now();
+    for(; frame < frames; ++frame) {
+        surface.drawFrame(drawer);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const int presented = std::atoi(surface.getAttribute(attributes::A_PRESENTED_FRAMES).value_or("0").c_str());
+    return {presented / elapsed.count(), true};
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 60;
+    setenv("SDL_VIDEODRIVER", "dummy", 0);
+    // Banded rendering is measured by banded_rendering_benchmark.
+    unsetenv("PROTOGEN_SDL_RENDER_SURFACE_THREADS");
+    // Present as fast as possible instead of following vsync.
+    setenv("PROTOGEN_SDL_RENDER_SURFACE_FPS", "100000", 1);
+
+    const int sprite_size = 16;
+    std::vector<uint8_t> sprite(sprite_size * sprite_size * 3);
+    for(std::size_t i = 0; i < sprite.size(); ++i) {
+        sprite[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    std::cout << "SDL frame upload, " << frames << " frames, video driver " << std::getenv("SDL_VIDEODRIVER") << std::endl;
+    std::cout << std::setw(10) << "size" << std::setw(14) << "direct fps" << std::setw(17) << "streaming fps" << std::setw(10) << "speedup" << std::endl;
+    const int sizes[][2] = {{128, 32}, {512, 128}, {1920, 480}};
+    for(const auto& size : sizes) {
+        const Result direct = benchmarkRenderer(size[0], size[1], frames, sprite, sprite_size);
+        const Result streaming = benchmarkSurface(size[0], size[1], frames, sprite, sprite_size);
+        if(!direct.ok || !streaming.ok) {
+            return 1;
+        }
+        std::cout << std::setw(10) << (std::to_string(size[0]) + "x" + std::to_string(size[1]))
+            << std::setw(14) << std::fixed << std::setprecision(1) << direct.frames_per_second
+            << std::setw(17) << streaming.frames_per_second
+            << std::setw(9) << std::setprecision(2) << streaming.frames_per_second / direct.frames_per_second << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef PROTOGEN_COMPOSITE_EXTENSION_FINDER_H
+#define PROTOGEN_COMPOSITE_EXTENSION_FINDER_H
+
+#include <memory>
+#include <vector>
+
+#include <protogen/extensions/ExtensionOriginBundle.h>
+#include <protogen/extensions/IExtensionFinder.h>
+
+namespace protogen {
+
+/**
+ * Finds the extensions of several finders, in the order of the finders.
+ */
+class CompositeExtensionFinder : public IExtensionFinder {
+public:
+    CompositeExtensionFinder(const std::vector<std::shared_ptr<IExtensionFinder>>& finders);
+    std::vector<ExtensionOriginBundle> find() override;
+private:
+    std::vector<std::shared_ptr<IExtensionFinder>> m_finders;
+};
+
+} // namespace
+
+#endif
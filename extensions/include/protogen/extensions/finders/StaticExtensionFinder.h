@@ -0,0 +1,25 @@
+#ifndef PROTOGEN_STATIC_EXTENSION_FINDER_H
+#define PROTOGEN_STATIC_EXTENSION_FINDER_H
+
+#include <vector>
+
+#include <protogen/extensions/ExtensionOriginBundle.h>
+#include <protogen/extensions/IExtensionFinder.h>
+
+namespace protogen {
+
+/**
+ * Finds extensions which are built into the protogen software, so they can
+ * be loaded the same way as extensions found on disk.
+ */
+class StaticExtensionFinder : public IExtensionFinder {
+public:
+    StaticExtensionFinder(const std::vector<ExtensionOriginBundle>& extensions);
+    std::vector<ExtensionOriginBundle> find() override;
+private:
+    std::vector<ExtensionOriginBundle> m_extensions;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,18 @@
+#include <protogen/extensions/finders/CompositeExtensionFinder.h>
+
+using namespace protogen;
+
+CompositeExtensionFinder::CompositeExtensionFinder(const std::vector<std::shared_ptr<IExtensionFinder>> &finders)
+    : m_finders(finders)
+{
+}
+
+std::vector<ExtensionOriginBundle> CompositeExtensionFinder::find()
+{
+    std::vector<ExtensionOriginBundle> extensions;
+    for(auto& finder : m_finders) {
+        auto found = finder->find();
+        extensions.insert(extensions.end(), found.begin(), found.end());
+    }
+    return extensions;
+}
@@ -0,0 +1,13 @@
+#include <protogen/extensions/finders/StaticExtensionFinder.h>
+
+using namespace protogen;
+
+StaticExtensionFinder::StaticExtensionFinder(const std::vector<ExtensionOriginBundle> &extensions)
+    : m_extensions(extensions)
+{
+}
+
+std::vector<ExtensionOriginBundle> StaticExtensionFinder::find()
+{
+    return m_extensions;
+}
@@ -0,0 +1,29 @@
+#ifndef PROTOGEN_FRAMEINFO_HPP
+#define PROTOGEN_FRAMEINFO_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace protogen {
+
+/**
+ * Timing of a frame the core protogen software asks an app to render with
+ * `IProtogenApp::render`. Animate with these rather than with the clock, so
+ * motion stays smooth when the core changes the frame rate.
+ */
+struct FrameInfo {
+    // Counts every frame the core rendered, for any app, starting at 1.
+    uint64_t frame_number;
+    // When the frame was due to start. Frames are shown as soon as they
+    // are rendered.
+    std::chrono::steady_clock::time_point time;
+    // Time since the previous frame of the same app was due, or zero for
+    // its first frame after it became active.
+    std::chrono::nanoseconds delta;
+    // Time until the next frame is due, at the current frame rate.
+    std::chrono::nanoseconds period;
+};
+
+}   // namespace
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef PROTOGEN_FRAMERECORDING_HPP
+#define PROTOGEN_FRAMERECORDING_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace protogen::frame_recording {
+
+/**
+ * Layout of files which the core protogen software records shown frames
+ * to, so they can be replayed through any render surface later.
+ *
+ * A recording is a Header, followed by one record per frame, followed by
+ * an index. All numbers are little-endian and every record starts at a
+ * multiple of RECORD_ALIGNMENT, so the file can be `mmap`ed and read in
+ * place. Each record is a FrameHeader followed by `size` bytes of frame
+ * data, encoded like web preview frames (see
+ * protogen/presentation/PreviewEncoding.h): key frames stand alone
+ * and delta frames are encoded against the frame before them.
+ *
+ * The index is `frame_count` u64 offsets from the start of the file to
+ * each record. `frame_count` and `index_offset` are only written when the
+ * recording is finished; while they are 0, find the frames by walking the
+ * records from `header_size` until one does not fit in the file.
+ */
+
+static constexpr char MAGIC[8] = {'P', 'R', 'O', 'T', 'O', 'R', 'E', 'C'};
+static constexpr uint32_t VERSION = 1;
+static constexpr std::size_t RECORD_ALIGNMENT = 8;
+
+/**
+ * Pixel formats of recorded frames.
+ */
+enum class Format : uint32_t {
+    // 3 bytes per pixel: red, green, blue.
+    RGB888 = 1,
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    // Bytes from the start of the file to the first record.
+    uint32_t header_size;
+    uint32_t width;
+    uint32_t height;
+    Format format;
+    // Every `key_interval`th frame, starting with the first, is a key frame.
+    uint32_t key_interval;
+    // Number of frames, or 0 if the recording was not finished.
+    uint64_t frame_count;
+    // Bytes from the start of the file to the index, or 0 if the recording
+    // was not finished.
+    uint64_t index_offset;
+    // Nanoseconds between the first and the last frame.
+    uint64_t duration_ns;
+    uint64_t reserved;
+};
+
+struct FrameHeader {
+    // Nanoseconds since the first frame was finished.
+    uint64_t timestamp_ns;
+    // Bytes of frame data which follow, not counting padding.
+    uint32_t size;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 64 && sizeof(FrameHeader) == 16, "Recording headers must not be padded.");
+
+/**
+ * Bytes from the start of a record with `size` bytes of frame data to the
+ * start of the next one.
+ */
+constexpr uint64_t recordSize(uint32_t size) {
+    return (sizeof(FrameHeader) + size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef PROTOGEN_FRAMETAP_HPP
+#define PROTOGEN_FRAMETAP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace protogen::frame_tap {
+
+/**
+ * Layout of the shared memory ring which the core protogen software
+ * exports every shown frame to, so that other processes can see exactly
+ * what the render surface shows.
+ *
+ * The shared memory object is named by the PROTOGEN_FRAME_TAP_NAME
+ * environment variable of the core software, "/protogen_frames" by
+ * default. Open it with `shm_open(name, O_RDONLY, 0)`, `mmap` it with
+ * PROT_READ and read the Header at its start. Frame `n` is written to slot
+ * `n % slot_count`; each slot is a SlotHeader followed by the pixels.
+ *
+ * Slots are guarded by a seqlock. To read a frame in place:
+ *     1. `beginRead(slot)`; if it returns false the slot is being written.
+ *     2. Use the pixels.
+ *     3. `endRead(slot, sequence)`; if it returns false the frame was
+ *        overwritten while reading and what was read must be discarded.
+ * Readers never block the writer.
+ */
+
+static constexpr char MAGIC[8] = {'P', 'R', 'O', 'T', 'O', 'T', 'A', 'P'};
+static constexpr uint32_t VERSION = 1;
+
+/**
+ * Pixel formats of exported frames.
+ */
+enum class Format : uint32_t {
+    // 4 bytes per pixel in memory: red, green, blue, unused.
+    RGBX8888 = 1,
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+    "Frame tap atomics must be lock-free to work across processes.");
+
+struct SlotHeader {
+    // Odd while the slot is being written.
+    std::atomic<uint32_t> sequence;
+    uint32_t width;
+    uint32_t height;
+    // Bytes between the start of consecutive rows.
+    uint32_t stride;
+    Format format;
+    uint32_t reserved;
+    uint64_t frame_number;
+    // CLOCK_MONOTONIC nanoseconds at which the frame was finished.
+    uint64_t timestamp_ns;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_count;
+    // Bytes from the start of one slot to the next, including its SlotHeader.
+    uint64_t slot_size;
+    // Bytes from the start of the shared memory to the first slot.
+    uint64_t slots_offset;
+    // Number of the newest frame which was completely written, or 0 before
+    // the first frame. Frame numbers start at 1.
+    std::atomic<uint64_t> latest_frame;
+};
+
+inline SlotHeader * slot(Header * header, uint64_t frame_number) {
+    auto * base = reinterpret_cast<unsigned char *>(header) + header->slots_offset;
+    return reinterpret_cast<SlotHeader *>(base + (frame_number % header->slot_count) * header->slot_size);
+}
+
+inline const SlotHeader * slot(const Header * header, uint64_t frame_number) {
+    const auto * base = reinterpret_cast<const unsigned char *>(header) + header->slots_offset;
+    return reinterpret_cast<const SlotHeader *>(base + (frame_number % header->slot_count) * header->slot_size);
+}
+
+inline unsigned char * pixels(SlotHeader * slot) {
+    return reinterpret_cast<unsigned char *>(slot) + sizeof(SlotHeader);
+}
+
+inline const unsigned char * pixels(const SlotHeader * slot) {
+    return reinterpret_cast<const unsigned char *>(slot) + sizeof(SlotHeader);
+}
+
+inline bool beginRead(const SlotHeader * slot, uint32_t& sequence) {
+    sequence = slot->sequence.load(std::memory_order_acquire);
+    return (sequence & 1) == 0;
+}
+
+inline bool endRead(const SlotHeader * slot, uint32_t sequence) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+} // namespace
+
+#endif
@@ -4,6 +4,11 @@
 #include <cstdint>
 #include <vector>
 #include <algorithm>
+#include <optional>
+#include <utility>
+#include <limits>
+
+#include <protogen/PolygonRasterizer.hpp>
 
 namespace protogen {
 
@@ -66,30 +71,117 @@ public:
             height = this->height() - y;
         }
 
-        for (int i = 0; i < width; ++i) {
-            for (int j = 0; j < height; ++j) {
-                setPixel(x + i, y + j, red, green, blue);
+        for (int j = 0; j < height; ++j) {
+            drawSpan(x, x + width - 1, y + j, red, green, blue);
+        }
+    };
+    /**
+     * Draws a horizontal run of pixels from x0 to x1, both inclusive, on
+     * row y with provided color. The order of x0 and x1 does not matter.
+     * If the span is out of bounds, it is clipped.
+     *
+     * All of the default fill algorithms are built on this method, so
+     * implementations are encouraged to override it with a fast row fill.
+     */
+    virtual void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) {
+        const auto span = clipSpan(x0, x1, y);
+        if (!span.has_value()) {
+            return;
+        }
+        for (int x = span->first; x <= span->second; ++x) {
+            setPixel(x, y, red, green, blue);
+        }
+    };
+    /**
+     * Copies a block of packed RGB888 pixels onto the canvas with its
+     * top-left corner at (x, y).
+     *
+     * @param rgb Pointer to the first pixel of the block. Each pixel is 3
+     * bytes in red, green, blue order.
+     * @param stride Number of bytes between the start of consecutive rows
+     * in `rgb`.
+     *
+     * Parts of the block that are out of bounds are clipped. Implementations
+     * are encouraged to override this with a faster bulk copy.
+     */
+    virtual void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) {
+        const auto clip = clipBlit(x, y, width, height);
+        if (!clip.has_value()) {
+            return;
+        }
+        for (int j = 0; j < clip->height; ++j) {
+            const uint8_t* row = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+            for (int i = 0; i < clip->width; ++i) {
+                setPixel(clip->dst_x + i, clip->dst_y + j, row[i * 3], row[i * 3 + 1], row[i * 3 + 2]);
+            }
+        }
+    };
+    /**
+     * Same as `blit`, but a pixel is only drawn if its corresponding byte in
+     * `mask` is non-zero. `mask` has one byte per pixel and `mask_stride`
+     * is the number of bytes between the start of consecutive mask rows.
+     */
+    virtual void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) {
+        const auto clip = clipBlit(x, y, width, height);
+        if (!clip.has_value()) {
+            return;
+        }
+        for (int j = 0; j < clip->height; ++j) {
+            const uint8_t* row = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+            const uint8_t* mask_row = mask + (clip->src_y + j) * mask_stride + clip->src_x;
+            for (int i = 0; i < clip->width; ++i) {
+                if (mask_row[i] != 0) {
+                    setPixel(clip->dst_x + i, clip->dst_y + j, row[i * 3], row[i * 3 + 1], row[i * 3 + 2]);
+                }
+            }
+        }
+    };
+    /**
+     * Draws a pixel with the provided color over the existing content of
+     * the canvas, using `alpha` as its opacity. The color is not
+     * premultiplied.
+     *
+     * ICanvas cannot read back pixels, so the default implementation does
+     * not blend: fully transparent pixels are skipped and every other pixel
+     * is set to the color, as if it were opaque. Implementations that can
+     * read their pixels should override this to blend with the existing
+     * content.
+     */
+    virtual void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) {
+        if (alpha == 0) {
+            return;
+        }
+        setPixel(x, y, red, green, blue);
+    };
+    /**
+     * Draws a block of RGBA8888 pixels over the existing content of the
+     * canvas with its top-left corner at (x, y). Each pixel is 4 bytes in
+     * red, green, blue, alpha order and is not premultiplied.
+     *
+     * @param stride Number of bytes between the start of consecutive rows
+     * in `rgba`.
+     *
+     * Parts of the block that are out of bounds are clipped. See
+     * `setPixelRGBA` for how the default implementation blends.
+     */
+    virtual void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) {
+        const auto clip = clipBlit(x, y, width, height);
+        if (!clip.has_value()) {
+            return;
+        }
+        for (int j = 0; j < clip->height; ++j) {
+            const uint8_t* row = rgba + (clip->src_y + j) * stride + clip->src_x * 4;
+            for (int i = 0; i < clip->width; ++i) {
+                setPixelRGBA(clip->dst_x + i, clip->dst_y + j, row[i * 4], row[i * 4 + 1], row[i * 4 + 2], row[i * 4 + 3]);
             }
         }
     };
     /**
      * Draws a line between two points with provided color.
+     * Both end points are drawn.
      */
     virtual void drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue) {
-        int dx = x2 - x1;
-        int dy = y2 - y1;
-        const int abs_dx = dx < 0 ? -dx : dx;
-        const int abs_dy = dy < 0 ? -dy : dy;
-        int steps = abs_dx > abs_dy ? abs_dx : abs_dy;
-        float xInc = dx / (float)steps;
-        float yInc = dy / (float)steps;
-        float x = x1;
-        float y = y1;
-        for (int i = 0; i <= steps; ++i) {
-            setPixel(x, y, red, green, blue);
-            x += xInc;
-            y += yInc;
-        }
+        drawLineRows(x1, y1, x2, y2, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), red, green, blue);
     };
     /**
      * Draws a polygon with the provided color.
@@ -107,29 +199,21 @@ public:
         drawLine(points.at(points.size() - 1).first, points.at(points.size() - 1).second, points.at(0).first, points.at(0).second, red, green, blue);
 
         if (fill) {
-            // Filling the polygon using scanline algorithm
-            int minY = points.at(0).second, maxY = points.at(0).second;
-            for (const auto& point : points) {
-                if (point.second < minY) minY = point.second;
-                if (point.second > maxY) maxY = point.second;
-            }
-
-            for (int y = minY; y <= maxY; ++y) {
-                std::vector<int> nodes;
-                size_t j = points.size() - 1;
-                for (size_t i = 0; i < points.size(); ++i) {
-                    if ((points.at(i).second < y && points.at(j).second >= y) || (points.at(j).second < y && points.at(i).second >= y)) {
-                        nodes.push_back(points.at(i).first + (y - points.at(i).second) * (points.at(j).first - points.at(i).first) / (points.at(j).second - points.at(i).second));
-                    }
-                    j = i;
-                }
-                std::sort(nodes.begin(), nodes.end());
-                for (size_t i = 0; i < nodes.size(); i += 2) {
-                    if (i + 1 < nodes.size()) {
-                        drawLine(nodes.at(i), y, nodes.at(i + 1), y, red, green, blue);
-                    }
-                }
-            }
+            // One rasterizer per thread keeps its edge storage between
+            // polygons, so redrawing every frame does not allocate. A fill
+            // started from within a drawSpan of another fill gets a
+            // rasterizer of its own, so the outer fill is not disturbed.
+            thread_local PolygonRasterizer shared_rasterizer;
+            thread_local int fill_depth = 0;
+            struct DepthGuard {
+                int& depth;
+                ~DepthGuard() { --depth; }
+            } guard{++fill_depth};
+            PolygonRasterizer nested_rasterizer;
+            PolygonRasterizer& rasterizer = guard.depth == 1 ? shared_rasterizer : nested_rasterizer;
+            rasterizer.fill(points, 0, height() - 1, [&](int x0, int x1, int y) {
+                drawSpan(x0, x1, y, red, green, blue);
+            });
         }
     };
 
@@ -162,18 +246,28 @@ public:
         int y1 = b;
         int sigma = 2 * b2 + a2 * (1 - 2 * b);
 
-        // Draw the outline of the ellipse
-        while (b2 * x1 <= a2 * y1) {
-            setPixel(x0 + x1, y0 + y1, red, green, blue);
-            setPixel(x0 - x1, y0 + y1, red, green, blue);
-            setPixel(x0 + x1, y0 - y1, red, green, blue);
-            setPixel(x0 - x1, y0 - y1, red, green, blue);
+        // When filling, only remember the widest extent of each row while
+        // walking the outline, then fill every row once with a single span.
+        std::vector<int> half_widths;
+        if (fill) {
+            half_widths.assign(std::max(b, 0) + 1, -1);
+        }
+        auto plot = [&](int dx, int dy) {
             if (fill) {
-                for (int i = x0 - x1; i <= x0 + x1; ++i) {
-                    setPixel(i, y0 + y1, red, green, blue);
-                    setPixel(i, y0 - y1, red, green, blue);
+                if (dy >= 0 && dy <= b && dx > half_widths[dy]) {
+                    half_widths[dy] = dx;
                 }
+                return;
             }
+            setPixel(x0 + dx, y0 + dy, red, green, blue);
+            setPixel(x0 - dx, y0 + dy, red, green, blue);
+            setPixel(x0 + dx, y0 - dy, red, green, blue);
+            setPixel(x0 - dx, y0 - dy, red, green, blue);
+        };
+
+        // Draw the outline of the ellipse
+        while (b2 * x1 <= a2 * y1) {
+            plot(x1, y1);
             if (sigma >= 0) {
                 sigma += fa2 * (1 - y1);
                 y1--;
@@ -188,16 +282,7 @@ public:
 
         // Draw the outline of the ellipse
         while (a2 * y1 <= b2 * x1) {
-            setPixel(x0 + x1, y0 + y1, red, green, blue);
-            setPixel(x0 - x1, y0 + y1, red, green, blue);
-            setPixel(x0 + x1, y0 - y1, red, green, blue);
-            setPixel(x0 - x1, y0 - y1, red, green, blue);
-            if (fill) {
-                for (int i = x0 - x1; i <= x0 + x1; ++i) {
-                    setPixel(i, y0 + y1, red, green, blue);
-                    setPixel(i, y0 - y1, red, green, blue);
-                }
-            }
+            plot(x1, y1);
             if (sigma >= 0) {
                 sigma += fb2 * (1 - x1);
                 x1--;
@@ -205,6 +290,125 @@ public:
             sigma += a2 * ((4 * y1) + 6);
             y1++;
         }
+
+        if (fill) {
+            for (int dy = 0; dy <= b; ++dy) {
+                if (half_widths[dy] < 0) {
+                    continue;
+                }
+                drawSpan(x0 - half_widths[dy], x0 + half_widths[dy], y0 + dy, red, green, blue);
+                if (dy != 0) {
+                    drawSpan(x0 - half_widths[dy], x0 + half_widths[dy], y0 - dy, red, green, blue);
+                }
+            }
+        }
+    }
+
+protected:
+    /**
+     * Draws the part of a line which lies on the rows from `first_row` to
+     * `last_row`, both inclusive. This is how `drawLine` draws, so drawing
+     * a line in several row ranges gives exactly the pixels of drawing it
+     * at once.
+     *
+     * Every row of the line is computed directly with integer arithmetic,
+     * the same pixels a Bresenham walk would pick, so rows outside the
+     * range cost nothing. Mostly horizontal lines are drawn with one span
+     * per row, mostly vertical ones with one pixel per row.
+     */
+    void drawLineRows(int x1, int y1, int x2, int y2, int first_row, int last_row, uint8_t red, uint8_t green, uint8_t blue) {
+        if (y1 > y2) {
+            std::swap(x1, x2);
+            std::swap(y1, y2);
+        }
+        if (y2 < first_row || y1 > last_row) {
+            return;
+        }
+        if (y1 == y2) {
+            drawSpan(x1, x2, y1, red, green, blue);
+            return;
+        }
+        const int64_t dy = static_cast<int64_t>(y2) - y1;
+        const int64_t dx = x2 > x1 ? static_cast<int64_t>(x2) - x1 : static_cast<int64_t>(x1) - x2;
+        const int step_x = x1 < x2 ? 1 : -1;
+        const int64_t first = std::max<int64_t>(0, static_cast<int64_t>(first_row) - y1);
+        const int64_t last = std::min<int64_t>(dy, static_cast<int64_t>(last_row) - y1);
+        for (int64_t row = first; row <= last; ++row) {
+            const int y = static_cast<int>(y1 + row);
+            if (dx > dy) {
+                // Pixel t of the line is on row round(t * dy / dx), so row r
+                // holds every t from ceil((2r - 1) dx / 2dy) to the start of
+                // the next row minus one.
+                const int64_t t0 = row == 0 ? 0 : ((2 * row - 1) * dx + 2 * dy - 1) / (2 * dy);
+                const int64_t t1 = row == dy ? dx : ((2 * row + 1) * dx + 2 * dy - 1) / (2 * dy) - 1;
+                drawSpan(static_cast<int>(x1 + step_x * t0), static_cast<int>(x1 + step_x * t1), y, red, green, blue);
+            } else {
+                const int64_t t = (2 * row * dx + dy) / (2 * dy);
+                setPixel(static_cast<int>(x1 + step_x * t), y, red, green, blue);
+            }
+        }
+    }
+
+    /**
+     * The visible part of a block of pixels drawn at some position.
+     * `src_x` and `src_y` are offsets into the block and `dst_x` and `dst_y`
+     * are the matching canvas coordinates.
+     */
+    struct BlitClip {
+        int src_x;
+        int src_y;
+        int dst_x;
+        int dst_y;
+        int width;
+        int height;
+    };
+
+    /**
+     * Clips a block of size `width` by `height` drawn at (x, y) to the
+     * bounds of this canvas. Returns nothing if no pixel is visible.
+     */
+    std::optional<BlitClip> clipBlit(int x, int y, int width, int height) const {
+        BlitClip clip{0, 0, x, y, width, height};
+        if (clip.dst_x < 0) {
+            clip.src_x = -clip.dst_x;
+            clip.width += clip.dst_x;
+            clip.dst_x = 0;
+        }
+        if (clip.dst_y < 0) {
+            clip.src_y = -clip.dst_y;
+            clip.height += clip.dst_y;
+            clip.dst_y = 0;
+        }
+        if (clip.dst_x + clip.width > this->width()) {
+            clip.width = this->width() - clip.dst_x;
+        }
+        if (clip.dst_y + clip.height > this->height()) {
+            clip.height = this->height() - clip.dst_y;
+        }
+        if (clip.width <= 0 || clip.height <= 0) {
+            return {};
+        }
+        return clip;
+    }
+
+    /**
+     * Orders and clips the span from x0 to x1, both inclusive, on row y to
+     * the bounds of this canvas. Returns the first and last visible x, or
+     * nothing if no pixel is visible.
+     */
+    std::optional<std::pair<int, int>> clipSpan(int x0, int x1, int y) const {
+        if (y < 0 || y >= this->height()) {
+            return {};
+        }
+        if (x0 > x1) {
+            std::swap(x0, x1);
+        }
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, this->width() - 1);
+        if (x0 > x1) {
+            return {};
+        }
+        return std::make_pair(x0, x1);
     }
 };
 
@@ -8,6 +8,7 @@
 #include <functional>
 
 #include <protogen/ICanvas.hpp>
+#include <protogen/FrameInfo.hpp>
 #include <protogen/IProportionProvider.hpp>
 #include <protogen/Resolution.hpp>
 #include <protogen/IAttributeStore.hpp>
@@ -90,6 +91,29 @@ public:
     virtual void receiveSensors(std::vector<std::shared_ptr<protogen::sensor::ISensor>> sensors) {
         (void)sensors;
     };
+
+    /**
+     * Return true to have the core draw your frames, instead of drawing
+     * them on your own thread with the render surface.
+     *
+     * The core then calls `render` once per frame on its render thread,
+     * and only while your app is active, so the app needs no thread of its
+     * own and costs no rendering time while inactive. All apps rendered
+     * this way share one frame clock.
+     */
+    virtual bool usesFrameScheduler() const {
+        return false;
+    }
+
+    /**
+     * Draws one frame onto `canvas`, which is already cleared to black.
+     * Only called if `usesFrameScheduler` returns true. Return quickly;
+     * the frame rate drops while frames take longer than `frame.period`.
+     */
+    virtual void render(ICanvas& canvas, const FrameInfo& frame) {
+        (void)canvas;
+        (void)frame;
+    }
 };
 
 using CreateAppFunction = IProtogenApp * (*)();
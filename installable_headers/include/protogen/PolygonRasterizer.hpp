@@ -0,0 +1,126 @@
+#ifndef PROTOGEN_POLYGONRASTERIZER_H
+#define PROTOGEN_POLYGONRASTERIZER_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+namespace protogen {
+
+/**
+ * Scanline polygon filler using an edge table and an active edge list.
+ *
+ * Edges are sorted once by their first scanline and then stepped down the
+ * polygon in 16.16 fixed point, so no division or allocation happens per
+ * row. Rows are filled with the even-odd rule. An edge covers the rows
+ * strictly below its upper vertex down to and including its lower vertex,
+ * which makes shared vertices count once.
+ *
+ * The edge storage is kept between calls, so reusing one instance for
+ * every polygon avoids allocating once it has grown to the largest
+ * polygon drawn. Not thread-safe.
+ */
+class PolygonRasterizer {
+public:
+    /**
+     * Calls `span(x0, x1, y)` for every horizontal run inside `points`, with
+     * x0 <= x1, both inclusive. Only rows from `min_y` to `max_y`, both
+     * inclusive, are produced. Spans are not clipped horizontally.
+     */
+    template<typename SpanFunction>
+    void fill(const std::vector<std::pair<int, int>>& points, int min_y, int max_y, SpanFunction&& span) {
+        m_edges.clear();
+        m_active.clear();
+        if (points.size() < 3 || min_y > max_y) {
+            return;
+        }
+
+        size_t previous = points.size() - 1;
+        for (size_t i = 0; i < points.size(); ++i) {
+            addEdge(points[previous], points[i], min_y, max_y);
+            previous = i;
+        }
+        if (m_edges.empty()) {
+            return;
+        }
+        std::sort(m_edges.begin(), m_edges.end(), [](const Edge& a, const Edge& b) {
+            return a.y_start < b.y_start;
+        });
+
+        size_t next_edge = 0;
+        for (int y = m_edges.front().y_start; y <= max_y; ++y) {
+            while (next_edge < m_edges.size() && m_edges[next_edge].y_start == y) {
+                m_active.push_back(&m_edges[next_edge]);
+                ++next_edge;
+            }
+            m_active.erase(std::remove_if(m_active.begin(), m_active.end(), [y](const Edge* edge) {
+                return edge->y_end < y;
+            }), m_active.end());
+            if (m_active.empty()) {
+                if (next_edge == m_edges.size()) {
+                    break;
+                }
+                continue;
+            }
+
+            // Edges only swap order where they cross, so the list is almost
+            // sorted from the previous row and insertion sort is linear.
+            for (size_t i = 1; i < m_active.size(); ++i) {
+                Edge* edge = m_active[i];
+                size_t j = i;
+                while (j > 0 && m_active[j - 1]->x > edge->x) {
+                    m_active[j] = m_active[j - 1];
+                    --j;
+                }
+                m_active[j] = edge;
+            }
+
+            for (size_t i = 0; i + 1 < m_active.size(); i += 2) {
+                span(round(m_active[i]->x), round(m_active[i + 1]->x), y);
+            }
+            for (Edge* edge : m_active) {
+                edge->x += edge->slope;
+            }
+        }
+    }
+
+private:
+    static constexpr int FRACTION_BITS = 16;
+
+    struct Edge {
+        int y_start;
+        int y_end;
+        int64_t x;     // 16.16 fixed point x at the current row.
+        int64_t slope; // 16.16 fixed point change of x per row.
+    };
+
+    void addEdge(std::pair<int, int> a, std::pair<int, int> b, int min_y, int max_y) {
+        if (a.second == b.second) {
+            // Horizontal edges never cross a scanline.
+            return;
+        }
+        if (a.second > b.second) {
+            std::swap(a, b);
+        }
+        const int y_start = std::max(a.second + 1, min_y);
+        const int y_end = std::min(b.second, max_y);
+        if (y_start > y_end) {
+            return;
+        }
+        const int64_t slope = (static_cast<int64_t>(b.first - a.first) << FRACTION_BITS) / (b.second - a.second);
+        const int64_t x = (static_cast<int64_t>(a.first) << FRACTION_BITS) + slope * (y_start - a.second);
+        m_edges.push_back({y_start, y_end, x, slope});
+    }
+
+    static int round(int64_t x) {
+        return static_cast<int>((x + (int64_t(1) << (FRACTION_BITS - 1))) >> FRACTION_BITS);
+    }
+
+    std::vector<Edge> m_edges;
+    std::vector<Edge*> m_active;
+};
+
+}   // namespace
+
+#endif
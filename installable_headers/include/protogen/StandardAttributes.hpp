@@ -72,6 +72,56 @@ namespace protogen::attributes {
 // write access to files, this is the directory to use. If you need read-only
 // access to files, use the resources directory instead.
 [[maybe_unused]] static const char * A_USER_DATA_DIRECTORY = "user_data_directory";
+
+// Resolution an app draws at, as "<width>x<height>", for example "128x32".
+// If it differs from the resolution of the render surface, the core
+// protogen software gives the app a render surface of this resolution and
+// scales its frames to the real one, so the app does not have to handle
+// every resolution itself.
+[[maybe_unused]] static const char * A_PREFERRED_RESOLUTION = "preferred_resolution";
+
+// How frames drawn at A_PREFERRED_RESOLUTION are scaled: "nearest", which
+// keeps hard pixel edges, or "bilinear", which smooths them. Nearest if not
+// set.
+[[maybe_unused]] static const char * A_SCALING_FILTER = "scaling_filter";
+
+// Number of pixels which may differ between the two most recent frames of a
+// render surface. This attribute is set after every frame by render surfaces
+// which track changed regions, and is meant to be read as a metric.
+[[maybe_unused]] static const char * A_DIRTY_AREA = "dirty_area";
+
+// Microseconds the drawer of the most recent frame ran on the app's thread.
+// Set after every frame by render surfaces which measure it.
+[[maybe_unused]] static const char * A_DRAWER_TIME = "drawer_time_us";
+
+// Microseconds the render surface took to put the most recent frame on the
+// display, including waiting for vsync. Set after every frame by render
+// surfaces which measure it.
+[[maybe_unused]] static const char * A_PRESENT_TIME = "present_time_us";
+
+// Microseconds from the app finishing the most recent frame to the render
+// surface showing it. Set after every frame by render surfaces which
+// measure it.
+[[maybe_unused]] static const char * A_FRAME_LATENCY = "frame_latency_us";
+
+// Number of frames a render surface has shown since it was initialized.
+[[maybe_unused]] static const char * A_PRESENTED_FRAMES = "presented_frames";
+
+// Number of frames an app finished but a render surface replaced with a
+// newer one before showing them.
+[[maybe_unused]] static const char * A_DROPPED_FRAMES = "dropped_frames";
+
+// Number of frames a render surface showed more than one frame period after
+// the app finished drawing them.
+[[maybe_unused]] static const char * A_LATE_FRAMES = "late_frames";
+
+// Estimated milliwatts the display draws showing the most recent frame. Set
+// after every frame by render surfaces which estimate it.
+[[maybe_unused]] static const char * A_ESTIMATED_POWER = "estimated_power_mw";
+
+// Percent of full brightness the most recent frame was shown at, when a
+// render surface dims frames to stay within a power budget.
+[[maybe_unused]] static const char * A_BRIGHTNESS_LIMIT = "brightness_limit_percent";
     
 } // namespace
 
@@ -12,6 +12,8 @@
 #include <functional>
 #include <signal.h>
 #include <cmath>
+#include <cstdlib>
+#include <vector>
 
 #include <httplib.h>
 
@@ -28,6 +30,12 @@
 #include <protogen/presentation/protogen.h>
 #include <protogen/presentation/render_surface.h>
 #include <protogen/presentation/sdl_render_surface.h>
+#include <protogen/presentation/FrameTapSink.h>
+#include <protogen/presentation/PreviewSink.h>
+#include <protogen/presentation/RecorderSink.h>
+#include <protogen/presentation/TeeRenderSurface.h>
+#include <protogen/presentation/FanOutRenderSurface.h>
+#include <protogen/presentation/CompositorRenderSurface.h>
 #include <protogen/server/web_server.h>
 #include <protogen/extensions/IExtensionFinder.h>
 #include <protogen/extensions/IExtensionCheck.h>
@@ -38,15 +46,21 @@
 #include <protogen/extensions/data_locators/ExtensionHomeDirUserDataLocator.h>
 #include <protogen/extensions/data_locators/ExtensionDirResourceDataLocator.h>
 #include <protogen/extensions/finders/DirectoryExtensionFinder.h>
+#include <protogen/extensions/finders/StaticExtensionFinder.h>
+#include <protogen/extensions/finders/CompositeExtensionFinder.h>
 #include <protogen/extensions/checks/RequiredAttributesCheck.h>
 #include <protogen/sensors/SensorOriginBundle.h>
 #include <protogen/sensors/SensorsProvider.h>
 #include <protogen/apps/ProtogenAppInitializer.h>
 #include <protogen/apps/AppsProvider.h>
+#include <protogen/apps/FrameScheduler.h>
+#include <protogen/render_surfaces/RenderSurfacesProvider.h>
 #include <cmake_config.h>
 
 using namespace protogen;
 
+static constexpr std::size_t SERVER_THREADS = 32;
+
 std::string red(const std::string& s) {
 	return "\033[31m" + s + "\033[0m";
 }
@@ -100,37 +114,93 @@ std::optional<std::filesystem::path> getResourcesDir() {
 	return {};
 }
 
-std::unique_ptr<IRenderSurface> getRenderSurface() {
-	// Try Hub75 type led matrices.
-	printServiceLocationSubsection("HUB75 interface LED Matrices");
-	auto protogen_head_matrices = std::unique_ptr<ProtogenHeadMatrices>(new ProtogenHeadMatrices());
-	if(protogen_head_matrices->initialize() == IExtension::Initialization::Success) {
-		std::cout << green("Video device found: Protogen Head Matrices.") << std::endl;
-		return protogen_head_matrices;
-	} else {
-		printNotFound();
+RenderSurfacesProvider makeRenderSurfacesProvider(std::shared_ptr<IExtensionInitializer> initializer, std::shared_ptr<IExtensionCheck> check) {
+	// Built in render surfaces are probed alongside render surface
+	// extensions.
+	std::vector<std::shared_ptr<IExtensionFinder>> finders = {
+		std::shared_ptr<IExtensionFinder>(new StaticExtensionFinder({
+			ExtensionOriginBundle{std::shared_ptr<IExtension>(new ProtogenHeadMatrices()), {}},
+			ExtensionOriginBundle{std::shared_ptr<IExtension>(new SdlRenderSurface()), {}},
+		})),
+	};
+	if(std::filesystem::is_directory(PROTOGEN_RENDER_SURFACES_DIR)) {
+		finders.push_back(std::shared_ptr<IExtensionFinder>(new DirectoryExtensionFinder(PROTOGEN_RENDER_SURFACES_DIR)));
 	}
+	auto probe_timeout = RenderSurfacesProvider::DEFAULT_PROBE_TIMEOUT;
+	if(const char * timeout_env = std::getenv("PROTOGEN_RENDER_SURFACE_PROBE_TIMEOUT_MS")) {
+		if(std::atoi(timeout_env) > 0) {
+			probe_timeout = std::chrono::milliseconds(std::atoi(timeout_env));
+		}
+	}
+	return RenderSurfacesProvider(
+		std::shared_ptr<IExtensionFinder>(new CompositeExtensionFinder(finders)),
+		initializer,
+		check,
+		probe_timeout
+	);
+}
+
+std::shared_ptr<IRenderSurface> getRenderSurface(RenderSurfacesProvider& render_surfaces_provider) {
+	// With PROTOGEN_FAKE_RENDER_SURFACE set, no device is used and what apps
+	// draw is only measured, to profile them on machines without a display.
+	if(std::getenv(FakeRenderSurface::ENV_VAR_RESOLUTION) != nullptr) {
+		auto fake = FakeRenderSurface::fromEnvironment();
+		std::cout << yellow("Using a fake render surface of " + std::to_string(fake->resolution().width()) + "x" + std::to_string(fake->resolution().height()) + " to measure apps.") << std::endl;
+		return fake;
+	}
+
+	// Most preferred first. PROTOGEN_RENDER_SURFACE_PRIORITY is a comma
+	// separated list of render surface ids.
+	const char * priority_env = std::getenv("PROTOGEN_RENDER_SURFACE_PRIORITY");
+	const auto priority = RenderSurfacesProvider::parsePriority(priority_env != nullptr ? priority_env : "hub75_display,sdl_window");
 
-	// Try using SDL to display imagery. This will usually be
-	// in a window in a desktop environment.
-	printServiceLocationSubsection("SDL Video");
-	auto sdl_device = std::unique_ptr<IRenderSurface>(new SdlRenderSurface());
-	if(sdl_device->initialize() == IExtension::Initialization::Success) {
-		std::cout << green("Video device found: SDL") << std::endl;
-		return sdl_device;
+	// With PROTOGEN_FAN_OUT set, every device found shows the imagery
+	// instead of only the most preferred one, so every device is probed.
+	// Otherwise devices are probed in order of preference until one works.
+	const char * fan_out_env = std::getenv("PROTOGEN_FAN_OUT");
+	const bool fan_out = fan_out_env != nullptr && std::string(fan_out_env) != "" && std::string(fan_out_env) != "0";
+
+	if(!fan_out) {
+		const auto preferred = render_surfaces_provider.loadPreferredRenderSurface(priority);
+		if(preferred.has_value()) {
+			const auto& chosen = preferred->second.render_surface;
+			std::cout << green("Using video device: " + chosen->getAttribute(attributes::A_NAME).value_or(preferred->first)) << std::endl;
+			return chosen;
+		}
 	} else {
-		printNotFound();
+		auto render_surfaces = render_surfaces_provider.loadRenderSurfaces();
+		const auto ids = RenderSurfacesProvider::byPriority(render_surfaces, priority);
+		for(const auto& id : ids) {
+			const auto name = render_surfaces.at(id).render_surface->getAttribute(attributes::A_NAME).value_or(id);
+			std::cout << green("Video device found: " + name) << std::endl;
+		}
+		if(ids.size() == 1) {
+			std::cout << green("Using video device: " + render_surfaces.at(ids.front()).render_surface->getAttribute(attributes::A_NAME).value_or(ids.front())) << std::endl;
+			return render_surfaces.at(ids.front()).render_surface;
+		}
+		if(ids.size() > 1) {
+			// Draw at the resolution of the preferred device and scale for the others.
+			std::cout << green("Showing imagery on all " + std::to_string(ids.size()) + " video devices.") << std::endl;
+			const auto resolution = render_surfaces.at(ids.front()).render_surface->resolution();
+			std::vector<FanOutRenderSurface::Output> outputs;
+			for(const auto& id : ids) {
+				outputs.push_back({render_surfaces.at(id).render_surface, FanOutRenderSurface::Fit::Scale});
+			}
+			return std::shared_ptr<IRenderSurface>(new FanOutRenderSurface(std::move(outputs), resolution));
+		}
 	}
 
 	// As a fallback, use a fake surface.
 	std::cout << red("Video device not found. You will have no way to visualize the imagery.") << std::endl;
-	return std::unique_ptr<IRenderSurface>(new FakeRenderSurface());
+	return FakeRenderSurface::fromEnvironment();
 }
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
 	Magick::InitializeMagick(*argv);
 
 	auto srv = std::shared_ptr<httplib::Server>(new httplib::Server());
+	// Every browser watching the preview holds on to a worker thread.
+	srv->new_task_queue = [] { return new httplib::ThreadPool(SERVER_THREADS); };
 
 	auto extension_user_data_locator = std::shared_ptr<IExtensionUserDataLocator>(new ExtensionHomeDirUserDataLocator(".protogen", "userdata"));
 	auto extension_resource_data_locator = std::shared_ptr<IExtensionResourceDataLocator>(new ExtensionDirResourceDataLocator("resources"));
@@ -143,7 +213,41 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
 	auto extension_check = std::shared_ptr<IExtensionCheck>(new RequiredAttributesCheck());
 	
 	printServiceLocationHeader("Display Device");
-	auto data_viewer = std::shared_ptr(getRenderSurface());
+	// Outlives startup, so probes which timed out can finish.
+	auto render_surfaces_provider = makeRenderSurfacesProvider(extension_base_initializer, extension_check);
+	auto data_viewer = getRenderSurface(render_surfaces_provider);
+	printServiceLocationFooter();
+
+	printServiceLocationHeader("Frame Export");
+	// Frames are recorded once and handed to every tool which needs them.
+	auto tee = std::shared_ptr<TeeRenderSurface>(new TeeRenderSurface(data_viewer));
+	// Export every frame to shared memory for external tools.
+	auto frame_tap = std::shared_ptr<FrameTapSink>(new FrameTapSink(data_viewer->resolution(), FrameTapSink::nameFromEnvironment()));
+	if(frame_tap->initialize() == IInitializable::Initialization::Success) {
+		std::cout << green("Frames are exported to shared memory at: " + FrameTapSink::nameFromEnvironment()) << std::endl;
+		tee->addSink(frame_tap, TeeRenderSurface::Delivery::Latest);
+	} else {
+		std::cout << yellow("Frames are not exported.") << std::endl;
+	}
+	// Record every frame to a file for replay, when asked to.
+	if(const char * record_path = std::getenv(RecorderSink::ENV_VAR_PATH); record_path != NULL && record_path[0] != '\0') {
+		auto recorder = std::shared_ptr<RecorderSink>(new RecorderSink(data_viewer->resolution(), record_path));
+		if(recorder->initialize() == IInitializable::Initialization::Success) {
+			std::cout << green("Frames are recorded to: " + std::string(record_path)) << std::endl;
+			tee->addSink(recorder, TeeRenderSurface::Delivery::EveryFrame);
+		} else {
+			std::cout << yellow("Frames are not recorded.") << std::endl;
+		}
+	}
+	// Stream a preview of the frames to web browsers.
+	auto preview = std::shared_ptr<PreviewSink>(new PreviewSink(data_viewer->resolution()));
+	std::shared_ptr<PreviewStream> preview_stream = preview->stream();
+	tee->addSink(preview, TeeRenderSurface::Delivery::Latest);
+	data_viewer = tee;
+	// Core overlays and notifications are drawn over every app. They are
+	// shown in the preview, the recording and the exported frames too.
+	auto compositor = std::shared_ptr<CompositorRenderSurface>(new CompositorRenderSurface(data_viewer));
+	data_viewer = compositor;
 	printServiceLocationFooter();
 
 	printServiceLocationHeader("Sensor Devices");
@@ -162,7 +266,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
 	for(auto& sensor : sensors) {
 		sensors_vector.push_back(sensor.second.sensor);
 	}
-	auto app_initializer = std::shared_ptr<IExtensionInitializer>(new ProtogenAppInitializer(extension_base_initializer, sensors_vector, data_viewer));
+	auto app_initializer = std::shared_ptr<ProtogenAppInitializer>(new ProtogenAppInitializer(extension_base_initializer, sensors_vector, data_viewer));
 	auto apps_provider = std::shared_ptr<AppsProvider>(new AppsProvider(app_finder, app_initializer, app_checker));
 	auto apps = apps_provider->loadApps();
 	printServiceLocationFooter();
@@ -185,7 +289,19 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
 		app_state->addApp(std::dynamic_pointer_cast<IProtogenApp>(app.second.app));
 	}
 
+	// Apps which use the frame scheduler are rendered by the core, on one
+	// frame clock, while they are active.
+	auto frame_scheduler = std::shared_ptr<FrameScheduler>(new FrameScheduler(FrameScheduler::configFromEnvironment()));
+	app_state->setActiveAppListener([frame_scheduler, app_initializer](std::shared_ptr<IProtogenApp> app){
+		frame_scheduler->setApp(app, app != nullptr ? app_initializer->renderSurfaceOf(*app) : nullptr);
+	});
+	frame_scheduler->start();
+
 	setup_web_server(srv, app_state, html_files_dir, static_web_resources_dir);
+	if(preview_stream) {
+		setup_web_server_for_preview(srv, preview_stream);
+	}
+	setup_web_server_for_overlays(srv, compositor);
 
 	srv->listen("0.0.0.0", 8080);
 }
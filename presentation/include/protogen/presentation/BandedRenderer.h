@@ -0,0 +1,55 @@
+#ifndef PROTOGEN_BANDEDRENDERER_H
+#define PROTOGEN_BANDEDRENDERER_H
+
+#include <cstddef>
+
+#include <protogen/presentation/DisplayList.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/WorkStealingPool.h>
+
+namespace protogen {
+
+/**
+ * Draws a display list onto a MemoryCanvas with several threads.
+ *
+ * The canvas is split into horizontal bands. Each band replays the whole
+ * list, but only rasterizes the rows inside the band, so bands write to
+ * disjoint memory and need no synchronization. There are more bands than
+ * threads so that bands which happen to be busier than others are
+ * balanced by work stealing.
+ *
+ * `render` may be called from several threads; the calls run one after
+ * another.
+ */
+class BandedRenderer {
+public:
+    /**
+     * @param threads Number of threads to render with, including the
+     * calling thread.
+     */
+    explicit BandedRenderer(std::size_t threads);
+
+    std::size_t threads() const;
+
+    /**
+     * Replays `list` onto `target` band by band.
+     */
+    void render(const DisplayList& list, MemoryCanvas& target);
+
+    /**
+     * Bands are at least this many rows high, so that short canvases are
+     * not split into bands with too little work.
+     */
+    static constexpr int MIN_BAND_HEIGHT = 8;
+    /**
+     * Number of bands per thread, to give work stealing something to take.
+     */
+    static constexpr int BANDS_PER_THREAD = 4;
+
+private:
+    WorkStealingPool m_pool;
+};
+
+} // namespace
+
+#endif
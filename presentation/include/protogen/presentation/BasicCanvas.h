@@ -0,0 +1,189 @@
+#ifndef PROTOGEN_BASICCANVAS_H
+#define PROTOGEN_BASICCANVAS_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include <protogen/ICanvas.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/PixelFormat.h>
+#include <protogen/presentation/PixelKernels.h>
+#include <protogen/presentation/Rect.h>
+
+namespace protogen {
+
+/**
+ * An offscreen canvas whose pixels are stored in the pixel format of the
+ * device they are shown on, chosen at compile time.
+ *
+ * `Format` is one of the formats in PixelFormat.h. Colors are packed with
+ * its constexpr `pack` when they are drawn, so spans and fills write a
+ * value computed once per call, and blits convert RGB888 rows with a loop
+ * the compiler specialises for the format. Nothing is swizzled when the
+ * pixels are handed to the device.
+ *
+ * Not thread-safe.
+ */
+template<typename Format>
+class BasicCanvas : public ICanvas {
+public:
+    using Pixel = typename Format::Pixel;
+
+    BasicCanvas(int width, int height)
+        : m_width(std::max(width, 0)),
+        m_height(std::max(height, 0)),
+        m_pixels(static_cast<std::size_t>(m_width) * m_height, Pixel{0}),
+        m_rgbScratch()
+    {
+    }
+    explicit BasicCanvas(const Resolution& resolution)
+        : BasicCanvas(resolution.width(), resolution.height())
+    {
+    }
+
+    int width() const override {
+        return m_width;
+    }
+    int height() const override {
+        return m_height;
+    }
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+        if(x < 0 || x >= m_width || y < 0 || y >= m_height) {
+            return;
+        }
+        row(y)[x] = Format::pack(red, green, blue);
+    }
+    void clear() override {
+        std::fill(m_pixels.begin(), m_pixels.end(), Format::pack(0, 0, 0));
+    }
+    void fill(uint8_t red, uint8_t green, uint8_t blue) override {
+        std::fill(m_pixels.begin(), m_pixels.end(), Format::pack(red, green, blue));
+    }
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override {
+        const auto clip = clipBlit(x, y, width, height);
+        if(!clip.has_value()) {
+            return;
+        }
+        const Pixel value = Format::pack(red, green, blue);
+        for(int j = 0; j < clip->height; ++j) {
+            std::fill_n(row(clip->dst_y + j) + clip->dst_x, clip->width, value);
+        }
+    }
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+        const auto span = clipSpan(x0, x1, y);
+        if(!span.has_value()) {
+            return;
+        }
+        std::fill_n(row(y) + span->first, span->second - span->first + 1, Format::pack(red, green, blue));
+    }
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override {
+        const auto clip = clipBlit(x, y, width, height);
+        if(!clip.has_value()) {
+            return;
+        }
+        for(int j = 0; j < clip->height; ++j) {
+            const uint8_t * source = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+            Pixel * destination = row(clip->dst_y + j) + clip->dst_x;
+            for(int i = 0; i < clip->width; ++i) {
+                destination[i] = Format::pack(source[i * 3], source[i * 3 + 1], source[i * 3 + 2]);
+            }
+        }
+    }
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override {
+        const auto clip = clipBlit(x, y, width, height);
+        if(!clip.has_value()) {
+            return;
+        }
+        for(int j = 0; j < clip->height; ++j) {
+            const uint8_t * source = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+            const uint8_t * mask_row = mask + (clip->src_y + j) * mask_stride + clip->src_x;
+            Pixel * destination = row(clip->dst_y + j) + clip->dst_x;
+            for(int i = 0; i < clip->width; ++i) {
+                if(mask_row[i] != 0) {
+                    destination[i] = Format::pack(source[i * 3], source[i * 3 + 1], source[i * 3 + 2]);
+                }
+            }
+        }
+    }
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override {
+        if(x < 0 || x >= m_width || y < 0 || y >= m_height) {
+            return;
+        }
+        Pixel& destination = row(y)[x];
+        destination = blend(destination, red, green, blue, alpha);
+    }
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override {
+        const auto clip = clipBlit(x, y, width, height);
+        if(!clip.has_value()) {
+            return;
+        }
+        for(int j = 0; j < clip->height; ++j) {
+            const uint8_t * source = rgba + (clip->src_y + j) * stride + clip->src_x * 4;
+            Pixel * destination = row(clip->dst_y + j) + clip->dst_x;
+            for(int i = 0; i < clip->width; ++i) {
+                const uint8_t * s = source + i * 4;
+                if(s[3] == 255) {
+                    destination[i] = Format::pack(s[0], s[1], s[2]);
+                } else if(s[3] != 0) {
+                    destination[i] = blend(destination[i], s[0], s[1], s[2], s[3]);
+                }
+            }
+        }
+    }
+
+    Pixel * row(int y) {
+        return m_pixels.data() + static_cast<std::size_t>(y) * m_width;
+    }
+    const Pixel * row(int y) const {
+        return m_pixels.data() + static_cast<std::size_t>(y) * m_width;
+    }
+    Pixel pixel(int x, int y) const {
+        return row(y)[x];
+    }
+    pixel_formats::Rgb color(int x, int y) const {
+        return Format::unpack(pixel(x, y));
+    }
+
+    /**
+     * Draws only `region` of this canvas onto the same position of `target`
+     * with a single RGB888 blit. `region` is clipped to this canvas.
+     */
+    void copyTo(ICanvas& target, const Rect& region) const {
+        const Rect clipped = region.intersected(Rect{0, 0, m_width, m_height});
+        if(clipped.empty()) {
+            return;
+        }
+        const std::size_t row_bytes = static_cast<std::size_t>(clipped.width) * 3;
+        m_rgbScratch.resize(row_bytes * clipped.height);
+        for(int j = 0; j < clipped.height; ++j) {
+            const Pixel * source = row(clipped.y + j) + clipped.x;
+            uint8_t * destination = m_rgbScratch.data() + j * row_bytes;
+            for(int i = 0; i < clipped.width; ++i) {
+                const auto color = Format::unpack(source[i]);
+                destination[i * 3] = color.red;
+                destination[i * 3 + 1] = color.green;
+                destination[i * 3 + 2] = color.blue;
+            }
+        }
+        target.blit(m_rgbScratch.data(), static_cast<int>(row_bytes), clipped.x, clipped.y, clipped.width, clipped.height);
+    }
+
+private:
+    static Pixel blend(Pixel destination, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) {
+        const auto below = Format::unpack(destination);
+        return Format::pack(
+            pixel_kernels::blendByte(red, below.red, alpha),
+            pixel_kernels::blendByte(green, below.green, alpha),
+            pixel_kernels::blendByte(blue, below.blue, alpha));
+    }
+
+    int m_width;
+    int m_height;
+    std::vector<Pixel> m_pixels;
+    mutable std::vector<uint8_t> m_rgbScratch; // RGB888 staging for `copyTo`.
+};
+
+} // namespace
+
+#endif
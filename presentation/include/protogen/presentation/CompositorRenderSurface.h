@@ -0,0 +1,125 @@
+#ifndef PROTOGEN_COMPOSITORRENDERSURFACE_H
+#define PROTOGEN_COMPOSITORRENDERSURFACE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/DirtyRegion.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+namespace protogen {
+
+/**
+ * Sits between apps and a render surface and draws layers of the core
+ * software, such as battery or connection indicators and notifications,
+ * over the frames of whatever app is active.
+ *
+ * Layers are stacked in order: the app's frames at the bottom, then core
+ * overlays, then notifications; within a level, in the order they were
+ * added. Each layer is drawn into its own offscreen canvas, which starts
+ * transparent, and is only drawn again after it was invalidated. Every
+ * frame, the app is drawn into its own canvas and the layers are
+ * composited over it with the premultiplied blend kernels of
+ * PixelKernels.h. Only the rectangles the app and the visible layers drew
+ * are composited and handed to the wrapped surface, so surfaces which
+ * only update what changed keep doing so.
+ *
+ * Layers may be added, changed and removed from any thread. Without any
+ * layer, frames are passed to the wrapped surface untouched. Attributes
+ * are those of the wrapped surface.
+ */
+class CompositorRenderSurface : public IRenderSurface {
+public:
+    enum class Level {
+        CoreOverlay,
+        Notification,
+    };
+
+    class Layer {
+    public:
+        Level level() const;
+        /**
+         * Replaces what the layer draws. Also invalidates it.
+         */
+        void setDrawer(std::function<void(ICanvas&)> drawer);
+        /**
+         * Draws the layer again before the next frame, for example because
+         * what it shows changed.
+         */
+        void invalidate();
+        void setVisible(bool visible);
+        bool visible() const;
+
+    private:
+        friend class CompositorRenderSurface;
+
+        Layer(Level level, std::function<void(ICanvas&)> drawer, Resolution resolution);
+
+        const Level m_level;
+        mutable std::mutex m_drawerMutex;
+        std::function<void(ICanvas&)> m_drawer;
+        std::atomic<bool> m_dirty;   // Must be drawn again.
+        std::atomic<bool> m_changed; // Must be composited again.
+        std::atomic<bool> m_visible;
+
+        // Only used by the compositor, while composing.
+        MemoryCanvas m_canvas;
+        DirtyRegion m_drawn; // Pixels of `m_canvas` which are not transparent.
+    };
+
+    /**
+     * `surface` must already be initialized.
+     */
+    explicit CompositorRenderSurface(std::shared_ptr<IRenderSurface> surface);
+
+    Initialization initialize() override;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override;
+    Resolution resolution() const override;
+    std::optional<std::string> getAttribute(const std::string& key) const override;
+    std::vector<std::string> listAttributes() const override;
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override;
+    RemoveAttributeResult removeAttribute(const std::string& key) override;
+    bool hasAttribute(const std::string& key) const override;
+
+    /**
+     * Adds a layer on top of the others of its level, drawn with `drawer`.
+     * The layer is shown from the next frame on.
+     */
+    std::shared_ptr<Layer> addLayer(Level level, std::function<void(ICanvas&)> drawer);
+    void removeLayer(const std::shared_ptr<Layer>& layer);
+    /**
+     * Shows the layers over the last app frame again, if any of them
+     * changed since. Changes are otherwise shown with the next app frame,
+     * so call this after changing a layer while the app may not draw for a
+     * while. Does nothing until an app frame was drawn with layers present.
+     */
+    void refresh();
+
+private:
+    /**
+     * Draws invalidated layers, composites every visible layer over the
+     * app frame into `m_frame` and shows what the app and the layers drew.
+     * Must hold `m_mutex`.
+     */
+    void compose();
+
+    std::shared_ptr<IRenderSurface> m_surface;
+    Resolution m_resolution;
+
+    std::mutex m_mutex; // Held while drawing, composing and showing frames.
+    std::vector<std::shared_ptr<Layer>> m_layers; // Bottom to top.
+    bool m_layersChanged;
+    MemoryCanvas m_app;      // The last app frame.
+    DirtyRegion m_appDrawn;  // Pixels of `m_app` which are not black.
+    bool m_hasAppFrame;      // `m_app` holds the last app frame.
+    MemoryCanvas m_frame;    // What was last shown, within what was drawn.
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef PROTOGEN_COUNTINGCANVAS_H
+#define PROTOGEN_COUNTINGCANVAS_H
+
+#include <array>
+#include <cstdint>
+
+#include <protogen/ICanvas.hpp>
+
+namespace protogen {
+
+/**
+ * How much drawing a drawer did: the calls it made to each canvas
+ * primitive, and the pixels and spans those calls wrote.
+ */
+struct DrawCounts {
+    enum Primitive {
+        SetPixel,
+        Clear,
+        Fill,
+        FillRegion,
+        DrawSpan,
+        Blit,
+        BlitMasked,
+        SetPixelRGBA,
+        BlendBlit,
+        DrawLine,
+        DrawPolygon,
+        DrawEllipse,
+        PRIMITIVE_COUNT,
+    };
+
+    std::array<uint64_t, PRIMITIVE_COUNT> calls{};
+    // Pixels written after clipping, counting a pixel every time it is
+    // written.
+    uint64_t pixels = 0;
+    // Rows filled by spans, including those shapes are rasterized into.
+    uint64_t spans = 0;
+
+    DrawCounts& operator+=(const DrawCounts& other);
+    uint64_t totalCalls() const;
+    static const char * name(Primitive primitive);
+};
+
+/**
+ * Draws onto another canvas and counts what is drawn into a DrawCounts.
+ *
+ * Lines, polygons and ellipses are rasterized with the ICanvas defaults,
+ * so the spans and pixels they produce are counted too; only the call
+ * itself is counted as the shape. Every other call is passed on to the
+ * target canvas as it is.
+ *
+ * Does NOT take ownership of the target canvas or the counts.
+ */
+class CountingCanvas : public ICanvas {
+public:
+    CountingCanvas(ICanvas& target, DrawCounts& counts);
+
+    int width() const override;
+    int height() const override;
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void clear() override;
+    void fill(uint8_t red, uint8_t green, uint8_t blue) override;
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override;
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override;
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override;
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override;
+    void drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawPolygon(const std::vector<std::pair<int, int>>& points, uint8_t red, uint8_t green, uint8_t blue, bool fill) override;
+    void drawEllipse(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue, bool fill) override;
+
+private:
+    /**
+     * Counts a call to `primitive`, unless it is made while rasterizing a
+     * shape.
+     */
+    void countCall(DrawCounts::Primitive primitive);
+    void countArea(int x, int y, int width, int height);
+
+    ICanvas& m_target;
+    DrawCounts& m_counts;
+    int m_shapeDepth;
+};
+
+} // namespace
+
+#endif
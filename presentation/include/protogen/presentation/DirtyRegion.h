@@ -0,0 +1,47 @@
+#ifndef PROTOGEN_DIRTYREGION_H
+#define PROTOGEN_DIRTYREGION_H
+
+#include <cstddef>
+#include <vector>
+
+#include <protogen/presentation/Rect.h>
+
+namespace protogen {
+
+/**
+ * A set of non-overlapping rectangles covering every pixel that changed.
+ *
+ * Rectangles that touch are merged as they are added. The set is kept
+ * small so iterating it stays cheap: once more than `MAX_RECTS` remain,
+ * they are collapsed into their bounding box. The covered area may
+ * therefore be larger than the pixels that actually changed, but it never
+ * misses one.
+ */
+class DirtyRegion {
+public:
+    static constexpr std::size_t MAX_RECTS = 8;
+
+    DirtyRegion();
+
+    void add(Rect rect);
+    void add(const DirtyRegion& other);
+    void clear();
+    bool empty() const;
+    const std::vector<Rect>& rects() const;
+    /**
+     * Number of pixels covered.
+     */
+    int area() const;
+    /**
+     * Smallest rectangle containing the whole region. Empty if the region
+     * is empty.
+     */
+    Rect bounds() const;
+
+private:
+    std::vector<Rect> m_rects;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef PROTOGEN_DIRTYTRACKINGCANVAS_H
+#define PROTOGEN_DIRTYTRACKINGCANVAS_H
+
+#include <protogen/ICanvas.hpp>
+#include <protogen/presentation/DirtyRegion.h>
+
+namespace protogen {
+
+/**
+ * Forwards every drawing call to a target canvas and records which pixels
+ * were touched, so a render surface can update only what changed.
+ *
+ * If the target is known to be clear when tracking starts, `clear()` only
+ * erases what was drawn since then instead of the whole target, and does
+ * not add to the dirty region.
+ *
+ * Does NOT take ownership of the target canvas.
+ */
+class DirtyTrackingCanvas : public ICanvas {
+public:
+    DirtyTrackingCanvas(ICanvas& target_canvas, bool target_is_clear = false);
+
+    /**
+     * Pixels touched since construction or the last `resetDirtyRegion()`,
+     * clipped to the canvas.
+     */
+    const DirtyRegion& dirtyRegion() const;
+    void resetDirtyRegion();
+
+    int width() const override;
+    int height() const override;
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void clear() override;
+    void fill(uint8_t red, uint8_t green, uint8_t blue) override;
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override;
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override;
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override;
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override;
+    void drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawPolygon(const std::vector<std::pair<int, int>>& points, uint8_t red, uint8_t green, uint8_t blue, bool fill) override;
+    void drawEllipse(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue, bool fill) override;
+
+private:
+    void markDirty(int x, int y, int width, int height);
+
+    ICanvas& m_targetCanvas;
+    DirtyRegion m_dirtyRegion;
+    bool m_targetWasClear; // if true, everything outside the dirty region is black.
+};
+
+} // namespace
+
+#endif
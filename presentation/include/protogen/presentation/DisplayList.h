@@ -0,0 +1,138 @@
+#ifndef PROTOGEN_DISPLAYLIST_H
+#define PROTOGEN_DISPLAYLIST_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include <protogen/ICanvas.hpp>
+
+namespace protogen {
+
+/**
+ * A recorded sequence of drawing calls which can be replayed onto any
+ * canvas later, possibly on another thread.
+ *
+ * Commands and their pixel data are stored back to back in one byte
+ * arena. `clear()` keeps the arena's capacity, so a list that is reused
+ * every frame stops allocating once it has grown to the largest frame.
+ * Lists are recorded with RecordingCanvas.
+ *
+ * Not thread-safe, but a list may be moved to another thread and
+ * replayed there.
+ */
+class DisplayList {
+public:
+    enum class Op : uint8_t {
+        SetPixel,
+        Clear,
+        Fill,
+        FillRegion,
+        DrawSpan,
+        Blit,
+        BlitMasked,
+        SetPixelRGBA,
+        BlendBlit,
+        DrawLine,
+        DrawPolygon,
+        DrawEllipse,
+    };
+
+    DisplayList();
+    DisplayList(const DisplayList& other) = default;
+    DisplayList& operator=(const DisplayList& other) = default;
+    DisplayList(DisplayList&& other) noexcept;
+    DisplayList& operator=(DisplayList&& other) noexcept;
+
+    /**
+     * Removes every command but keeps the allocated storage.
+     */
+    void clear();
+    bool empty() const;
+    /**
+     * Number of recorded commands.
+     */
+    std::size_t size() const;
+    /**
+     * Number of bytes used by the recorded commands.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * Draws every recorded command onto `target` in recording order.
+     */
+    void replay(ICanvas& target) const;
+    /**
+     * Same as `replay`, but skips commands which cannot touch any row from
+     * `first_row` to `last_row`, both inclusive. Used to replay one band of
+     * a frame without walking the commands of other bands.
+     */
+    void replay(ICanvas& target, int first_row, int last_row) const;
+
+    /**
+     * Appends a command. `arguments` is the fixed size part of the command.
+     * Returns where `data_size` bytes of variable size payload, such as
+     * pixels, must be written. The pointer is valid until the next append.
+     * Intended for RecordingCanvas.
+     */
+    uint8_t * append(Op op, const void * arguments, std::size_t arguments_size, std::size_t data_size = 0);
+
+    // Fixed size arguments of the commands.
+    struct ColorArguments {
+        uint8_t red;
+        uint8_t green;
+        uint8_t blue;
+    };
+    struct PixelArguments {
+        int32_t x;
+        int32_t y;
+        uint8_t red;
+        uint8_t green;
+        uint8_t blue;
+        uint8_t alpha;
+    };
+    // Used by FillRegion and DrawEllipse, and by the blits whose pixels
+    // follow in rows of `width` pixels without padding.
+    struct RegionArguments {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+        uint8_t red;
+        uint8_t green;
+        uint8_t blue;
+        bool fill;
+    };
+    // Used by DrawSpan as (x1, y1, x2) and by DrawLine.
+    struct LineArguments {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+        uint8_t red;
+        uint8_t green;
+        uint8_t blue;
+    };
+    // Followed by `count` pairs of int32_t coordinates.
+    struct PolygonArguments {
+        uint32_t count;
+        uint8_t red;
+        uint8_t green;
+        uint8_t blue;
+        bool fill;
+    };
+
+private:
+    struct Header {
+        Op op;
+        uint32_t size; // Size of the whole command including this header.
+    };
+
+    std::vector<uint8_t> m_arena; // Only grows; `m_used` bytes are in use.
+    std::size_t m_used;
+    std::size_t m_commands;
+};
+
+} // namespace
+
+#endif
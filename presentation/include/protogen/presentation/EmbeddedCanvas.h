@@ -16,6 +16,12 @@ public:
     void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
     void clear() override;
     void fill(uint8_t red, uint8_t green, uint8_t blue) override;
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override;
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override;
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override;
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override;
 private:
     struct Point {
         int x;
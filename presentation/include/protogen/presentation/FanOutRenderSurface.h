@@ -0,0 +1,80 @@
+#ifndef PROTOGEN_FANOUTRENDERSURFACE_H
+#define PROTOGEN_FANOUTRENDERSURFACE_H
+
+#include <memory>
+#include <vector>
+
+#include <protogen/IAttributeStore.hpp>
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/DirtyRegion.h>
+#include <protogen/presentation/ImageScaler.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/WorkStealingPool.h>
+
+namespace protogen {
+
+/**
+ * Shows the same frames on several render surfaces at once.
+ *
+ * The drawer runs once per frame, into an offscreen canvas of this
+ * surface's resolution. The canvas is then presented to every output in
+ * parallel. Outputs with the same resolution only receive the pixels which
+ * changed; other outputs are scaled or cropped to their resolution. So
+ * drawing costs the same no matter how many outputs there are.
+ *
+ * Outputs must already be initialized and must accept `drawFrame` from
+ * any thread, one call at a time.
+ */
+class FanOutRenderSurface : public IRenderSurface {
+public:
+    enum class Fit {
+        // Stretch the frame to the output with nearest neighbour sampling.
+        Scale,
+        // Center the frame on the output, cutting off what does not fit and
+        // leaving the rest black.
+        Crop,
+    };
+
+    struct Output {
+        std::shared_ptr<IRenderSurface> surface;
+        Fit fit;
+    };
+
+    FanOutRenderSurface(std::vector<Output> outputs, Resolution resolution);
+
+    Initialization initialize() override;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override;
+    Resolution resolution() const override;
+    std::optional<std::string> getAttribute(const std::string& key) const override;
+    std::vector<std::string> listAttributes() const override;
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override;
+    RemoveAttributeResult removeAttribute(const std::string& key) override;
+    bool hasAttribute(const std::string& key) const override;
+
+private:
+    struct Target {
+        Output output;
+        int width;
+        int height;
+        // A view of the frame with its own staging buffer, so that several
+        // outputs can copy from the frame at the same time.
+        std::unique_ptr<MemoryCanvas> frame;
+        // Only used for scaled outputs.
+        std::unique_ptr<MemoryCanvas> scaled;
+        std::unique_ptr<ImageScaler> scaler;
+    };
+
+    void present(Target& target, const DirtyRegion& changed);
+
+    Resolution m_resolution;
+    MemoryCanvas m_frame;
+    DirtyRegion m_drawnLastFrame; // Pixels drawn by the previous drawer.
+    std::vector<Target> m_targets;
+    WorkStealingPool m_pool;
+    std::shared_ptr<attributes::IAttributeStore> m_attributes;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef PROTOGEN_FRAMEMETRICS_H
+#define PROTOGEN_FRAMEMETRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <protogen/presentation/Histogram.h>
+
+namespace protogen {
+
+/**
+ * Frame time histograms of one render surface or app, in nanoseconds:
+ * - drawer time: how long the drawer ran,
+ * - present time: how long putting the frame on the display took after
+ *   the drawer, including waiting for a swap or vsync,
+ * - frame interval: time from the start of one frame to the next,
+ * and the number of frames which missed their deadline, which each source
+ * defines for itself (shown late, dropped or started late).
+ *
+ * Every method is lock-free and may be called from any thread. Frame
+ * intervals assume frames are started from one thread at a time.
+ */
+class FrameTimings {
+public:
+    struct Snapshot {
+        uint64_t frames;
+        uint64_t missed_deadlines;
+        Histogram::Snapshot drawer_time;
+        Histogram::Snapshot present_time;
+        Histogram::Snapshot frame_interval;
+    };
+
+    FrameTimings();
+
+    /**
+     * Counts a frame which started at `started` and whose drawer ran for
+     * `drawer_time`.
+     */
+    void recordFrame(std::chrono::steady_clock::time_point started, std::chrono::nanoseconds drawer_time);
+    void recordPresent(std::chrono::nanoseconds present_time);
+    void recordMissedDeadline();
+
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    std::atomic<uint64_t> m_frames;
+    std::atomic<uint64_t> m_missedDeadlines;
+    std::atomic<int64_t> m_previousStart; // Nanoseconds since the clock's epoch, or 0.
+    Histogram m_drawerTime;
+    Histogram m_presentTime;
+    Histogram m_frameInterval;
+};
+
+/**
+ * The FrameTimings of every render surface and app, by id, so they can be
+ * read in one place. Looking timings up takes a lock; recording into them
+ * does not, so keep the shared pointer rather than looking them up every
+ * frame.
+ */
+class FrameMetrics {
+public:
+    enum class Source {
+        Surface,
+        App,
+    };
+
+    struct Entry {
+        Source source;
+        std::string id;
+        FrameTimings::Snapshot timings;
+    };
+
+    /**
+     * The metrics of this process, which the built-in render surfaces and
+     * the app initializer record into.
+     */
+    static FrameMetrics& global();
+
+    /**
+     * The timings of the source with `id`, created on first use.
+     */
+    std::shared_ptr<FrameTimings> timings(Source source, const std::string& id);
+    /**
+     * New timings for one instance of the source with `id`, for sources of
+     * which there can be several, such as render surfaces. The first
+     * instance is listed as `id`, later ones as `id#2`, `id#3` and so on.
+     */
+    std::shared_ptr<FrameTimings> addInstance(Source source, const std::string& id);
+    std::vector<Entry> snapshot() const;
+    /**
+     * Every source as JSON, with times in microseconds:
+     *     {"surfaces": {"<id>": <timings>, ...}, "apps": {"<id>": <timings>, ...}}
+     * where <timings> is
+     *     {"frames": n, "missed_deadlines": n, "drawer_time_us": <histogram>,
+     *      "present_time_us": <histogram>, "frame_interval_us": <histogram>}
+     * and <histogram> is
+     *     {"count": n, "mean": x, "min": x, "p50": x, "p90": x, "p99": x, "max": x}
+     */
+    std::string toJson() const;
+    /**
+     * Resets the timings of every source. Sources stay listed.
+     */
+    void reset();
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<std::pair<Source, std::string>, std::shared_ptr<FrameTimings>> m_timings;
+    std::map<std::pair<Source, std::string>, unsigned int> m_instances;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef PROTOGEN_FRAMERECORDING_H
+#define PROTOGEN_FRAMERECORDING_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <protogen/FrameRecording.hpp>
+
+namespace protogen {
+
+/**
+ * A frame recording written by RecorderSink, mapped into memory
+ * read-only.
+ *
+ * Recordings which were not finished, for example because the software
+ * crashed, are read up to their last complete frame.
+ */
+class FrameRecording {
+public:
+    /**
+     * Maps the recording at `path`. Throws std::system_error if the file
+     * cannot be mapped and std::runtime_error if it is not a recording.
+     */
+    explicit FrameRecording(const std::string& path);
+    ~FrameRecording();
+
+    FrameRecording(const FrameRecording&) = delete;
+    FrameRecording& operator=(const FrameRecording&) = delete;
+
+    int width() const;
+    int height() const;
+    std::size_t frameCount() const;
+    /**
+     * Time from the first frame to the last.
+     */
+    std::chrono::nanoseconds duration() const;
+    /**
+     * Time from the first frame to frame `index`.
+     */
+    std::chrono::nanoseconds timestamp(std::size_t index) const;
+    bool isKeyFrame(std::size_t index) const;
+    /**
+     * Applies frame `index` to `rgb`, `width() * height()` RGB888 pixels
+     * which must hold frame `index - 1` unless it is a key frame. Returns
+     * false if the frame is malformed.
+     */
+    bool decode(std::size_t index, std::vector<uint8_t>& rgb) const;
+    /**
+     * Decodes frame `index` into `rgb` from the nearest key frame before
+     * it. Returns false if a frame on the way is malformed.
+     */
+    bool seek(std::size_t index, std::vector<uint8_t>& rgb) const;
+
+private:
+    const frame_recording::FrameHeader * frame(std::size_t index) const;
+    void unmap();
+
+    const unsigned char * m_data;
+    std::size_t m_size;
+    const frame_recording::Header * m_header;
+    std::vector<uint64_t> m_offsets;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef PROTOGEN_FRAMEREPLAY_H
+#define PROTOGEN_FRAMEREPLAY_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/presentation/FrameRecording.h>
+
+namespace protogen {
+
+/**
+ * Pushes the frames of a FrameRecording through a render surface, so the
+ * same workload can be shown on, and measured against, any surface.
+ *
+ * Every frame is decoded before it is drawn and drawn with a single blit
+ * at the top left corner, so the time spent in `drawFrame` is the cost of
+ * the surface alone. Frames larger than the surface are clipped; wrap the
+ * surface in a ScalingRenderSurface to fit them instead.
+ */
+class FrameReplay {
+public:
+    enum class Timing {
+        // Each frame is drawn when it was drawn in the recording.
+        Original,
+        // Each frame is drawn as soon as the previous one was.
+        AsFastAsPossible,
+    };
+
+    struct Result {
+        uint64_t frames;
+        // Wall time from the first frame to the end of the last one.
+        std::chrono::nanoseconds elapsed;
+        // Time spent in `drawFrame` of the surface.
+        std::chrono::nanoseconds draw_time;
+        std::chrono::nanoseconds longest_draw;
+        // With Timing::Original, the longest time a frame was drawn after
+        // it was due.
+        std::chrono::nanoseconds most_late;
+        // Frames which were not drawn: those which could not be decoded,
+        // and the delta frames after them up to the next key frame.
+        uint64_t malformed_frames;
+
+        double framesPerSecond() const;
+    };
+
+    /**
+     * `surface` must already be initialized. Does NOT take ownership of
+     * `recording`, which must outlive the replay.
+     */
+    FrameReplay(const FrameRecording& recording, std::shared_ptr<IRenderSurface> surface);
+
+    /**
+     * Draws every frame of the recording, `loops` times over, and returns
+     * when the last one was drawn.
+     */
+    Result run(Timing timing, int loops = 1);
+
+private:
+    const FrameRecording& m_recording;
+    std::shared_ptr<IRenderSurface> m_surface;
+    std::vector<uint8_t> m_rgb;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef PROTOGEN_FRAMETAPSINK_H
+#define PROTOGEN_FRAMETAPSINK_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <protogen/FrameTap.hpp>
+#include <protogen/IInitializable.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/TeeRenderSurface.h>
+
+namespace protogen {
+
+/**
+ * Exports a copy of every frame of a TeeRenderSurface to a POSIX shared
+ * memory ring, laid out as described in FrameTap.hpp, so other processes
+ * can read what is shown.
+ *
+ * Frames are rasterized straight into the shared memory. Add it to the
+ * tee with `Delivery::Latest` once `initialize` succeeded.
+ */
+class FrameTapSink : public TeeRenderSurface::Sink, public IInitializable {
+public:
+    /**
+     * `name` is the shared memory object name passed to `shm_open`,
+     * starting with a slash.
+     */
+    FrameTapSink(Resolution resolution, std::string name);
+    ~FrameTapSink() override;
+
+    /**
+     * The shared memory name set in PROTOGEN_FRAME_TAP_NAME, or
+     * DEFAULT_NAME.
+     */
+    static std::string nameFromEnvironment();
+
+    /**
+     * Creates the shared memory ring.
+     */
+    Initialization initialize() override;
+    void consumeFrame(const TeeRenderSurface::RecordedFrame& frame) override;
+
+    static constexpr const char * ENV_VAR_NAME = "PROTOGEN_FRAME_TAP_NAME";
+    static constexpr const char * DEFAULT_NAME = "/protogen_frames";
+    static constexpr uint32_t SLOT_COUNT = 4;
+
+private:
+    void unmap();
+
+    int m_width;
+    int m_height;
+    std::string m_name;
+    frame_tap::Header * m_header;
+    std::size_t m_mappedSize;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef PROTOGEN_FRAMETIMINGRENDERSURFACE_H
+#define PROTOGEN_FRAMETIMINGRENDERSURFACE_H
+
+#include <memory>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/FrameMetrics.h>
+
+namespace protogen {
+
+/**
+ * Passes frames to another render surface and records their timings, so
+ * the frames of one app can be told apart from those of the others drawing
+ * on the same surface. The drawer time is the time spent in the drawer;
+ * the present time is the rest of the wrapped surface's `drawFrame`.
+ *
+ * Attributes are those of the wrapped surface.
+ */
+class FrameTimingRenderSurface : public IRenderSurface {
+public:
+    /**
+     * `surface` must already be initialized.
+     */
+    FrameTimingRenderSurface(std::shared_ptr<IRenderSurface> surface, std::shared_ptr<FrameTimings> timings);
+
+    Initialization initialize() override;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override;
+    Resolution resolution() const override;
+    std::optional<std::string> getAttribute(const std::string& key) const override;
+    std::vector<std::string> listAttributes() const override;
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override;
+    RemoveAttributeResult removeAttribute(const std::string& key) override;
+    bool hasAttribute(const std::string& key) const override;
+
+    const std::shared_ptr<FrameTimings>& timings() const;
+
+private:
+    std::shared_ptr<IRenderSurface> m_surface;
+    std::shared_ptr<FrameTimings> m_timings;
+};
+
+} // namespace
+
+#endif
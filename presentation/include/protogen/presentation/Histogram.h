@@ -0,0 +1,79 @@
+#ifndef PROTOGEN_HISTOGRAM_H
+#define PROTOGEN_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace protogen {
+
+/**
+ * Counts how often values, such as frame times in microseconds, fall into
+ * buckets of bounded relative size, so percentiles can be read without
+ * keeping every value.
+ *
+ * Values below SUB_BUCKETS each have their own bucket. Above that, every
+ * power of two is split into SUB_BUCKETS buckets of equal width, so a
+ * percentile is never off by more than 1 / SUB_BUCKETS of its value, and
+ * the whole uint64_t range fits in a fixed array.
+ *
+ * `record` is lock-free and wait-free, and can be called from any number of
+ * threads while others take snapshots. A snapshot taken while values are
+ * recorded may miss some of them, but never sees a torn count.
+ */
+class Histogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    /**
+     * A copy of the counts at one point in time.
+     */
+    struct Snapshot {
+        uint64_t count;
+        uint64_t sum;
+        uint64_t min;   // 0 if `count` is 0.
+        uint64_t max;
+        std::vector<uint64_t> buckets;
+
+        /**
+         * The smallest value which at least `percentile` percent of the
+         * recorded values are lower than or equal to, rounded up to the end
+         * of its bucket but never above `max`. 0 if nothing was recorded.
+         */
+        uint64_t percentile(double percentile) const;
+        double mean() const;
+    };
+
+    Histogram();
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t value);
+    Snapshot snapshot() const;
+    /**
+     * Forgets every value. Values recorded at the same time may be kept.
+     */
+    void reset();
+
+    static std::size_t bucketOf(uint64_t value);
+    /**
+     * The largest value which falls into `bucket`.
+     */
+    static uint64_t bucketUpperBound(std::size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef PROTOGEN_IMAGESCALER_H
+#define PROTOGEN_IMAGESCALER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <protogen/presentation/MemoryCanvas.h>
+
+namespace protogen {
+
+/**
+ * Scales images of one fixed size to another fixed size.
+ *
+ * Which source pixels make up every target pixel is worked out once, when
+ * the scaler is made, and kept in per-column and per-row tables. Scaling a
+ * frame only follows the tables, so it costs the same every frame and does
+ * no division. Pixel centers are aligned, so scaling by a whole factor
+ * repeats every source pixel the same number of times.
+ *
+ * Not thread-safe.
+ */
+class ImageScaler {
+public:
+    enum class Filter {
+        // Each target pixel is its closest source pixel. Keeps hard edges,
+        // which suits pixel art.
+        Nearest,
+        // Each target pixel mixes the four closest source pixels.
+        Bilinear,
+    };
+
+    ImageScaler(int source_width, int source_height, int target_width, int target_height, Filter filter);
+
+    /**
+     * Scales all of `source` onto all of `target`. Both must have the sizes
+     * the scaler was made for.
+     */
+    void scale(const MemoryCanvas& source, MemoryCanvas& target);
+
+    Filter filter() const;
+
+private:
+    // A target column or row is the `first` source column or row mixed with
+    // `weight` / 255 of the `second`.
+    struct Tap {
+        int first;
+        int second;
+        uint8_t weight;
+    };
+
+    static std::vector<Tap> makeTaps(int source_size, int target_size, Filter filter);
+    void scaleNearest(const MemoryCanvas& source, MemoryCanvas& target);
+    void scaleBilinear(const MemoryCanvas& source, MemoryCanvas& target);
+
+    Filter m_filter;
+    std::vector<Tap> m_columns;
+    std::vector<Tap> m_rows;
+    // Bilinear only: source rows scaled to the target width, and which of
+    // them the target rows use.
+    MemoryCanvas m_scaledRows;
+    std::vector<bool> m_rowUsed;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef PROTOGEN_MEMORYCANVAS_H
+#define PROTOGEN_MEMORYCANVAS_H
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+#include <bit>
+
+#include <protogen/ICanvas.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/Rect.h>
+
+namespace protogen {
+
+/**
+ * An offscreen canvas backed by a contiguous, aligned framebuffer in memory.
+ *
+ * Each pixel is 32 bits and is laid out in memory as red, green, blue,
+ * alpha. Drawing methods write opaque pixels while `clear()` resets every
+ * byte to zero, so a cleared MemoryCanvas is fully transparent and can be
+ * used as a premultiplied-alpha layer as well as a plain RGBX framebuffer.
+ *
+ * Rows are padded so that every row starts on a 32-byte boundary. Bulk
+ * operations use the SIMD kernels in PixelKernels.h which are selected for
+ * the running CPU.
+ *
+ * Not thread-safe.
+ */
+class MemoryCanvas : public ICanvas {
+public:
+    MemoryCanvas(int width, int height);
+    explicit MemoryCanvas(const Resolution& resolution);
+    /**
+     * Creates a canvas which draws into existing pixels without taking
+     * ownership of them. `stride` is the number of pixels between the start
+     * of consecutive rows and must be at least `width`; `pixels` must hold
+     * `stride * height` pixels and outlive the canvas. Rows of a view are
+     * only aligned if the caller aligned them. Copies of a view own their
+     * pixels.
+     */
+    MemoryCanvas(uint32_t * pixels, int width, int height, int stride);
+    MemoryCanvas(const MemoryCanvas& other);
+    MemoryCanvas& operator=(const MemoryCanvas& other);
+    MemoryCanvas(MemoryCanvas&& other) = default;
+    MemoryCanvas& operator=(MemoryCanvas&& other) = default;
+
+    int width() const override;
+    int height() const override;
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void clear() override;
+    void fill(uint8_t red, uint8_t green, uint8_t blue) override;
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override;
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override;
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override;
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override;
+
+    /**
+     * Number of pixels between the start of consecutive rows. At least
+     * `width()`.
+     */
+    int stride() const;
+    uint32_t * row(int y);
+    const uint32_t * row(int y) const;
+    uint32_t * data();
+    const uint32_t * data() const;
+    uint32_t pixel(int x, int y) const;
+    /**
+     * A canvas which draws into `count` rows of this canvas, starting at
+     * row `first_row`. The rows must be within this canvas and the view
+     * must not outlive it.
+     */
+    MemoryCanvas rows(int first_row, int count);
+
+    /**
+     * Copies `source` onto this canvas with its top-left corner at (x, y).
+     * Out of bounds parts are clipped.
+     */
+    void copyFrom(const MemoryCanvas& source, int x = 0, int y = 0);
+    /**
+     * Mixes `source` into this canvas with a constant `alpha`, with its
+     * top-left corner at (x, y). Out of bounds parts are clipped.
+     */
+    void blendFrom(const MemoryCanvas& source, uint8_t alpha, int x = 0, int y = 0);
+    /**
+     * Composites `source` over this canvas using its per-pixel alpha, with
+     * its top-left corner at (x, y). `source` is treated as premultiplied,
+     * which is what drawing into a cleared MemoryCanvas produces, so several
+     * layers can be stacked by compositing them in order.
+     */
+    void compositeFrom(const MemoryCanvas& source, int x = 0, int y = 0);
+    /**
+     * Draws the whole content of this canvas onto `target` with a single
+     * blit. If `target` is also a MemoryCanvas, rows are copied directly.
+     */
+    void copyTo(ICanvas& target, int x = 0, int y = 0) const;
+    /**
+     * Draws only `region` of this canvas onto the same position of `target`
+     * with a single blit. `region` is clipped to this canvas.
+     */
+    void copyTo(ICanvas& target, const Rect& region) const;
+
+    static constexpr uint32_t pack(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha = 255) {
+        if constexpr (std::endian::native == std::endian::little) {
+            return red | (green << 8) | (blue << 16) | (static_cast<uint32_t>(alpha) << 24);
+        } else {
+            return (static_cast<uint32_t>(red) << 24) | (green << 16) | (blue << 8) | alpha;
+        }
+    }
+    static constexpr uint8_t red(uint32_t pixel) { return channel(pixel, 0); }
+    static constexpr uint8_t green(uint32_t pixel) { return channel(pixel, 1); }
+    static constexpr uint8_t blue(uint32_t pixel) { return channel(pixel, 2); }
+    static constexpr uint8_t alpha(uint32_t pixel) { return channel(pixel, 3); }
+
+    static constexpr std::size_t ALIGNMENT = 64;
+
+private:
+    static constexpr uint8_t channel(uint32_t pixel, int index) {
+        if constexpr (std::endian::native == std::endian::little) {
+            return static_cast<uint8_t>(pixel >> (index * 8));
+        } else {
+            return static_cast<uint8_t>(pixel >> ((3 - index) * 8));
+        }
+    }
+
+    struct AlignedDeleter {
+        bool owning;
+        void operator()(uint32_t * pixels) const {
+            if(owning) {
+                ::operator delete[](pixels, std::align_val_t(ALIGNMENT));
+            }
+        }
+    };
+
+    int m_width;
+    int m_height;
+    int m_stride;
+    std::unique_ptr<uint32_t[], AlignedDeleter> m_pixels;
+    mutable std::vector<uint8_t> m_rgbScratch; // RGB888 staging for `copyTo`.
+    std::vector<uint32_t> m_premultipliedScratch; // One premultiplied row for `blendBlit`.
+};
+
+} // namespace
+
+#endif
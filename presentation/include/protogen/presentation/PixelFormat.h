@@ -0,0 +1,125 @@
+#ifndef PROTOGEN_PIXELFORMAT_H
+#define PROTOGEN_PIXELFORMAT_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace protogen::pixel_formats {
+
+/**
+ * An unpacked 8-bit per channel color.
+ */
+struct Rgb {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+
+    constexpr bool operator==(const Rgb&) const = default;
+};
+
+/**
+ * 24-bit color stored in the low three bytes of a 32-bit pixel. `RED`,
+ * `GREEN` and `BLUE` are the byte index of each channel, so byte 0 is the
+ * first channel a panel expects on the wire. The top byte is unused.
+ *
+ * Every pixel format has the same shape: a `Pixel` storage type, a `NAME`,
+ * and constexpr `pack` and `unpack` functions, so that BasicCanvas can be
+ * instantiated for any of them and convert colors without branching.
+ */
+template<int RED, int GREEN, int BLUE>
+struct Ordered888 {
+    static_assert(RED != GREEN && RED != BLUE && GREEN != BLUE, "Every channel needs its own byte.");
+    static_assert(RED >= 0 && RED < 3 && GREEN >= 0 && GREEN < 3 && BLUE >= 0 && BLUE < 3, "Channels must be in the low three bytes.");
+
+    using Pixel = uint32_t;
+
+    static constexpr int RED_BYTE = RED;
+    static constexpr int GREEN_BYTE = GREEN;
+    static constexpr int BLUE_BYTE = BLUE;
+
+    static constexpr Pixel pack(uint8_t red, uint8_t green, uint8_t blue) {
+        return (static_cast<Pixel>(red) << (RED * 8)) | (static_cast<Pixel>(green) << (GREEN * 8)) | (static_cast<Pixel>(blue) << (BLUE * 8));
+    }
+    static constexpr Rgb unpack(Pixel pixel) {
+        return Rgb{byte(pixel, RED), byte(pixel, GREEN), byte(pixel, BLUE)};
+    }
+    /**
+     * The channel at byte `index`, in the order the format stores them.
+     */
+    static constexpr uint8_t byte(Pixel pixel, int index) {
+        return static_cast<uint8_t>(pixel >> (index * 8));
+    }
+};
+
+struct Rgb888 : Ordered888<0, 1, 2> {
+    static constexpr const char * NAME = "RGB888";
+};
+
+struct Bgr888 : Ordered888<2, 1, 0> {
+    static constexpr const char * NAME = "BGR888";
+};
+
+/**
+ * The channel order of the HUB75 panels of the protogen head.
+ */
+struct Rbg888 : Ordered888<0, 2, 1> {
+    static constexpr const char * NAME = "RBG888";
+};
+
+struct Grb888 : Ordered888<1, 0, 2> {
+    static constexpr const char * NAME = "GRB888";
+};
+
+/**
+ * 16-bit color with 5 bits of red, 6 of green and 5 of blue, red in the
+ * most significant bits. Unpacking repeats the high bits into the low bits
+ * so full intensity stays 255.
+ */
+struct Rgb565 {
+    using Pixel = uint16_t;
+    static constexpr const char * NAME = "RGB565";
+
+    static constexpr Pixel pack(uint8_t red, uint8_t green, uint8_t blue) {
+        return static_cast<Pixel>(((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3));
+    }
+    static constexpr Rgb unpack(Pixel pixel) {
+        const uint8_t red = (pixel >> 11) & 0x1f;
+        const uint8_t green = (pixel >> 5) & 0x3f;
+        const uint8_t blue = pixel & 0x1f;
+        return Rgb{
+            static_cast<uint8_t>((red << 3) | (red >> 2)),
+            static_cast<uint8_t>((green << 2) | (green >> 4)),
+            static_cast<uint8_t>((blue << 3) | (blue >> 2))
+        };
+    }
+};
+
+/**
+ * True if `sequence` (for example "RBG", as used by the rgb_matrix
+ * `led_rgb_sequence` option) names the byte order of `Format`. Only
+ * meaningful for Ordered888 formats.
+ */
+template<typename Format>
+constexpr bool matchesSequence(std::string_view sequence) {
+    if(sequence.size() != 3) {
+        return false;
+    }
+    constexpr auto p = Format::pack(1, 2, 3);
+    const char names[] = {'?', 'R', 'G', 'B'};
+    for(int i = 0; i < 3; ++i) {
+        const uint8_t channel = static_cast<uint8_t>(p >> (i * 8));
+        if(channel > 3 || names[channel] != sequence[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(matchesSequence<Rgb888>("RGB"));
+static_assert(matchesSequence<Rbg888>("RBG"));
+static_assert(Rgb565::unpack(Rgb565::pack(255, 255, 255)) == Rgb{255, 255, 255});
+static_assert(Bgr888::unpack(Bgr888::pack(1, 2, 3)) == Rgb{1, 2, 3});
+
+} // namespace
+
+#endif
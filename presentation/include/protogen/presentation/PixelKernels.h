@@ -0,0 +1,100 @@
+#ifndef PROTOGEN_PIXELKERNELS_H
+#define PROTOGEN_PIXELKERNELS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace protogen::pixel_kernels {
+
+/**
+ * A set of row kernels that operate on 32-bit pixels. Each pixel is 4 bytes
+ * in memory in red, green, blue, alpha order. Kernels that composite with
+ * per-pixel alpha expect premultiplied pixels.
+ *
+ * Several implementations exist (scalar, SSE, AVX2, NEON). All of them
+ * produce bit-identical results. Use `kernels()` to get the fastest set the
+ * running CPU supports.
+ */
+struct Kernels {
+    /**
+     * Name of the implementation, for example "avx2".
+     */
+    const char * name;
+    /**
+     * Sets `count` pixels of `dst` to `value`.
+     */
+    void (*fill)(uint32_t * dst, uint32_t value, std::size_t count);
+    /**
+     * Copies `count` pixels from `src` to `dst`. The rows must not overlap.
+     */
+    void (*copy)(uint32_t * dst, const uint32_t * src, std::size_t count);
+    /**
+     * Mixes `count` pixels of `src` into `dst` with a constant `alpha`:
+     * dst = (src * alpha + dst * (255 - alpha)) / 255, rounded, for every
+     * byte including alpha.
+     */
+    void (*blend)(uint32_t * dst, const uint32_t * src, std::size_t count, uint8_t alpha);
+    /**
+     * Converts `count` packed RGB888 pixels to opaque 32-bit pixels.
+     */
+    void (*expandRgb)(uint32_t * dst, const uint8_t * rgb, std::size_t count);
+    /**
+     * Converts `count` 32-bit pixels to packed RGB888, dropping alpha.
+     */
+    void (*packRgb)(uint8_t * rgb, const uint32_t * src, std::size_t count);
+    /**
+     * Converts `count` straight (not premultiplied) RGBA8888 pixels to
+     * premultiplied 32-bit pixels.
+     */
+    void (*premultiply)(uint32_t * dst, const uint8_t * rgba, std::size_t count);
+    /**
+     * Composites `count` premultiplied pixels of `src` over `dst`:
+     * dst = src + dst * (255 - src alpha) / 255, rounded and saturated, for
+     * every byte including alpha.
+     */
+    void (*blendPremultiplied)(uint32_t * dst, const uint32_t * src, std::size_t count);
+    /**
+     * Adds up each byte of `count` pixels: `sums[i]` is increased by the
+     * total of byte `i` of every pixel, in memory order, so `sums[0]` gets
+     * the red total of a MemoryCanvas row.
+     */
+    void (*sumChannels)(const uint32_t * src, std::size_t count, uint64_t sums[4]);
+};
+
+/**
+ * The fastest kernels supported by the running CPU. Selected once on first
+ * use.
+ */
+const Kernels& kernels();
+
+/**
+ * Portable kernels that work everywhere.
+ */
+const Kernels& scalarKernels();
+
+/**
+ * Every kernel set the running CPU supports, scalar first. Useful for
+ * testing and benchmarking implementations against each other.
+ */
+std::vector<const Kernels *> availableKernels();
+
+/**
+ * x / 255, rounded, for `value` = x + 128 with x in [0, 255 * 255]. Every
+ * kernel implementation uses this same formula so results are identical.
+ */
+inline uint32_t div255(uint32_t value) {
+    return (value + (value >> 8)) >> 8;
+}
+
+/**
+ * (src * alpha + dst * (255 - alpha)) / 255, rounded, as the blend kernels
+ * mix each byte.
+ */
+inline uint8_t blendByte(uint8_t src, uint8_t dst, uint8_t alpha) {
+    return static_cast<uint8_t>(div255(src * alpha + dst * (255 - alpha) + 128));
+}
+
+} // namespace
+
+#endif
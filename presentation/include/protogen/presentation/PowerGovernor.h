@@ -0,0 +1,75 @@
+#ifndef PROTOGEN_POWERGOVERNOR_H
+#define PROTOGEN_POWERGOVERNOR_H
+
+#include <cstdint>
+
+namespace protogen {
+
+/**
+ * Keeps the estimated current of LED panels under a budget by dimming
+ * frames which would draw too much.
+ *
+ * The current of a frame is estimated from the totals of its red, green
+ * and blue channels, assuming each LED draws in proportion to its value.
+ * Panels use less than that at low values because of gamma correction, so
+ * the estimate errs on the high side.
+ *
+ * Brightness drops at once when a frame would go over budget, so current
+ * spikes are cut from the first frame, and recovers gradually once frames
+ * are within budget again, so it does not flicker.
+ *
+ * Not thread-safe.
+ */
+class PowerGovernor {
+public:
+    struct Config {
+        // Milliamps one pixel's LED of each color adds at full value,
+        // averaged over the panel's scan.
+        double red_ma;
+        double green_ma;
+        double blue_ma;
+        // Milliamps the panels draw with every LED off.
+        double idle_ma;
+        // Milliamps to stay under. Zero or less turns limiting off.
+        double budget_ma;
+        // Fraction of the way back to full brightness recovered per frame.
+        double recovery;
+        double supply_volts;
+    };
+
+    /**
+     * Roughly two chained 64x32 panels, which draw about 4 A each showing
+     * full white, on a 5 V supply with a budget of half that.
+     */
+    static constexpr Config DEFAULT_CONFIG{0.65, 0.65, 0.65, 150.0, 4000.0, 0.05, 5.0};
+
+    explicit PowerGovernor(const Config& config = DEFAULT_CONFIG);
+
+    /**
+     * Estimated milliamps of a frame shown at full brightness, from the
+     * totals of each of its channels.
+     */
+    double estimateMilliamps(uint64_t red_total, uint64_t green_total, uint64_t blue_total) const;
+    /**
+     * Works out the brightness to show a frame with, given its estimate
+     * from `estimateMilliamps`. Returns the brightness, where 255 is full.
+     */
+    uint8_t update(double full_brightness_ma);
+    /**
+     * Brightness of the most recent frame, where 255 is full.
+     */
+    uint8_t brightness() const;
+    /**
+     * Estimated milliwatts of the most recent frame at its brightness.
+     */
+    double milliwatts() const;
+
+private:
+    Config m_config;
+    double m_brightness; // From 0 to 1.
+    double m_milliamps;  // Of the most recent frame, at its brightness.
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PROTOGEN_PREVIEWENCODING_H
+#define PROTOGEN_PREVIEWENCODING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace protogen::preview {
+
+/**
+ * Encoding of preview frames sent to web browsers.
+ *
+ * A frame is `width * height` RGB888 pixels. It is encoded as the XOR of
+ * its pixels with those of the previous frame sent to the same client, or
+ * with black for key frames, and the result is run-length encoded, so
+ * unchanged pixels cost next to nothing. Layout, little-endian:
+ *     u8  type (FrameType)
+ *     u16 width
+ *     u16 height
+ *     u32 frame number
+ *     runs, until every pixel is covered, each starting with a byte `b`:
+ *         0b00nnnnnn: n + 1 pixels are unchanged (XOR is zero).
+ *         0b01nnnnnn: one XOR pixel follows, repeated n + 1 times.
+ *         0b1nnnnnnn: n + 1 XOR pixels follow.
+ * resources/static/preview.js decodes this format.
+ */
+enum class FrameType : uint8_t {
+    Key = 0,
+    Delta = 1,
+};
+
+static constexpr std::size_t HEADER_SIZE = 9;
+
+/**
+ * Encodes `current` against `previous`, which is ignored for key frames,
+ * and replaces the content of `out` with the result. Both frames must hold
+ * `width * height * 3` bytes.
+ */
+void encode(FrameType type, int width, int height, uint32_t frame_number, const std::vector<uint8_t>& current, const std::vector<uint8_t>& previous, std::vector<uint8_t>& out);
+
+/**
+ * Applies an encoded frame to `rgb`, which must hold the frame it was
+ * encoded against, or is resized and cleared for key frames. Returns false
+ * if `data` is malformed or does not match the size of `rgb`.
+ */
+bool decode(const uint8_t* data, std::size_t size, std::vector<uint8_t>& rgb);
+
+std::string toBase64(const std::vector<uint8_t>& data);
+
+} // namespace
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef PROTOGEN_PREVIEWSINK_H
+#define PROTOGEN_PREVIEWSINK_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/PreviewStream.h>
+#include <protogen/presentation/TeeRenderSurface.h>
+
+namespace protogen {
+
+/**
+ * Feeds the frames of a TeeRenderSurface to a PreviewStream, from which
+ * the web server streams them to browsers.
+ *
+ * Frames are only rasterized while a client is watching. Add it to the tee
+ * with `Delivery::Latest`.
+ */
+class PreviewSink : public TeeRenderSurface::Sink {
+public:
+    explicit PreviewSink(Resolution resolution);
+
+    void consumeFrame(const TeeRenderSurface::RecordedFrame& frame) override;
+    std::shared_ptr<PreviewStream> stream() const;
+
+private:
+    int m_width;
+    int m_height;
+    std::shared_ptr<PreviewStream> m_stream;
+    MemoryCanvas m_canvas;
+    std::vector<uint8_t> m_rgb;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef PROTOGEN_PREVIEWSTREAM_H
+#define PROTOGEN_PREVIEWSTREAM_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace protogen {
+
+/**
+ * Turns rendered frames into preview messages for any number of web
+ * clients, encoded with PreviewEncoding.h and then base64.
+ *
+ * Clients choose a frame rate and are grouped into a few fixed rate tiers.
+ * Each tier encodes a frame only when its rate is due and only while it
+ * has subscribers, and all clients of a tier share the encoded message,
+ * so the cost of a preview depends on the number of tiers in use, not on
+ * the number of clients. Deltas of a tier are against the previous message
+ * of that tier. A client which has not received the previous message, for
+ * example because it just connected or its connection is slow, gets a key
+ * frame instead.
+ *
+ * Thread-safe.
+ */
+class PreviewStream {
+public:
+    /**
+     * Frame rates of the tiers, highest first.
+     */
+    static constexpr std::array<int, 5> TIER_RATES = {30, 15, 10, 5, 1};
+
+    struct Message {
+        uint64_t sequence; // Increases by one for every message of a tier.
+        std::shared_ptr<const std::string> data; // Base64 encoded frame.
+    };
+
+    PreviewStream(int width, int height);
+
+    int width() const;
+    int height() const;
+
+    /**
+     * Registers a client which wants at most `fps` frames per second and
+     * returns its tier. `unsubscribe` must be called with the tier when the
+     * client leaves.
+     */
+    std::size_t subscribe(int fps);
+    void unsubscribe(std::size_t tier);
+    /**
+     * True if any client is subscribed, so producers can skip rendering
+     * frames nobody watches.
+     */
+    bool hasSubscribers() const;
+
+    /**
+     * Offers a new frame of `width() * height()` RGB888 pixels, finished
+     * at `time`. It is encoded for every tier which is due.
+     */
+    void pushFrame(const std::vector<uint8_t>& rgb, std::chrono::steady_clock::time_point time);
+
+    /**
+     * Waits up to `timeout` for a message of `tier` newer than the message
+     * `sequence` the client received last, or 0 for none. Returns nothing
+     * on timeout.
+     */
+    std::optional<Message> next(std::size_t tier, uint64_t sequence, std::chrono::milliseconds timeout);
+
+private:
+    struct Tier {
+        std::chrono::steady_clock::duration period;
+        std::chrono::steady_clock::time_point next_due;
+        unsigned int subscribers = 0;
+        uint64_t sequence = 0;
+        uint32_t frame_number = 0;
+        std::vector<uint8_t> frame; // RGB888 frame of the latest message.
+        std::shared_ptr<const std::string> delta; // Latest message as a delta.
+        std::shared_ptr<const std::string> key; // Latest message as a key frame, made when asked for.
+    };
+
+    int m_width;
+    int m_height;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_messageReady;
+    std::array<Tier, TIER_RATES.size()> m_tiers;
+    std::vector<uint8_t> m_encoded; // Scratch space for encoding.
+};
+
+} // namespace
+
+#endif
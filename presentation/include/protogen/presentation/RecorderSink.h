@@ -0,0 +1,84 @@
+#ifndef PROTOGEN_RECORDERSINK_H
+#define PROTOGEN_RECORDERSINK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <protogen/FrameRecording.hpp>
+#include <protogen/IInitializable.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/TeeRenderSurface.h>
+
+namespace protogen {
+
+/**
+ * Writes every frame of a TeeRenderSurface, with the time it was finished,
+ * to a recording file laid out as described in FrameRecording.hpp.
+ * FrameRecording and FrameReplay play it back.
+ *
+ * No frame may be skipped, so add it to the tee with
+ * `Delivery::EveryFrame`: frames are encoded and written on the drawing
+ * thread, after they were shown. The file is buffered, and unchanged
+ * pixels cost next to nothing to encode, so this is cheap next to
+ * presenting on a device. The recording is finished when the sink is
+ * destroyed. Until then, the file is flushed after the first frame and at
+ * least once a second, so if the process is stopped without destroying
+ * the sink, the file can still be replayed as an unfinished recording.
+ * Until `initialize` succeeds, frames are ignored.
+ */
+class RecorderSink : public TeeRenderSurface::Sink, public IInitializable {
+public:
+    /**
+     * Every `key_interval`th frame is a key frame, which a replay can
+     * start from.
+     */
+    RecorderSink(Resolution resolution, std::string path, uint32_t key_interval = DEFAULT_KEY_INTERVAL);
+    ~RecorderSink() override;
+
+    /**
+     * Creates the recording file, replacing any file at the path.
+     */
+    Initialization initialize() override;
+    void consumeFrame(const TeeRenderSurface::RecordedFrame& frame) override;
+
+    /**
+     * The number of frames recorded so far.
+     */
+    uint64_t frameCount() const;
+
+    static constexpr const char * ENV_VAR_PATH = "PROTOGEN_RECORD_FILE";
+    static constexpr uint32_t DEFAULT_KEY_INTERVAL = 60;
+
+private:
+    /**
+     * Writes the index and the final header, and closes the file.
+     */
+    void finish();
+    bool write(const void * data, std::size_t size);
+    bool flush();
+
+    std::string m_path;
+    uint32_t m_keyInterval;
+    int m_width;
+    int m_height;
+
+    std::FILE * m_file;
+    uint64_t m_offset;                      // Bytes written so far.
+    std::vector<uint64_t> m_index;          // Offset of every record.
+    std::chrono::steady_clock::time_point m_firstFrameAt;
+    uint64_t m_lastTimestamp;
+    std::chrono::steady_clock::time_point m_lastFlushAt;
+
+    MemoryCanvas m_canvas;
+    std::vector<uint8_t> m_rgb;
+    std::vector<uint8_t> m_previousRgb;
+    std::vector<uint8_t> m_encoded;
+};
+
+} // namespace
+
+#endif
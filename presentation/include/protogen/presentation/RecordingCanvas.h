@@ -0,0 +1,53 @@
+#ifndef PROTOGEN_RECORDINGCANVAS_H
+#define PROTOGEN_RECORDINGCANVAS_H
+
+#include <protogen/ICanvas.hpp>
+#include <protogen/presentation/DisplayList.h>
+
+namespace protogen {
+
+/**
+ * A canvas which does not draw anything itself, but records every call
+ * into a DisplayList so it can be replayed onto a real canvas later.
+ *
+ * Shapes are recorded as one command each rather than as the pixels they
+ * produce, so the canvas they are replayed onto can use its accelerated
+ * implementations. Blits are clipped to the canvas while recording and
+ * only the visible pixels are copied into the list.
+ *
+ * Does NOT take ownership of the display list.
+ */
+class RecordingCanvas : public ICanvas {
+public:
+    RecordingCanvas(DisplayList& list, int width, int height);
+
+    int width() const override;
+    int height() const override;
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void clear() override;
+    void fill(uint8_t red, uint8_t green, uint8_t blue) override;
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override;
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override;
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override;
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override;
+    void drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawPolygon(const std::vector<std::pair<int, int>>& points, uint8_t red, uint8_t green, uint8_t blue, bool fill) override;
+    void drawEllipse(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue, bool fill) override;
+
+private:
+    /**
+     * Records a blit of `bytes_per_pixel` sized pixels, followed by an
+     * optional one byte per pixel mask, copying only the visible part.
+     */
+    void recordBlock(DisplayList::Op op, const uint8_t* pixels, int stride, int bytes_per_pixel, const uint8_t* mask, int mask_stride, int x, int y, int width, int height);
+
+    DisplayList& m_list;
+    int m_width;
+    int m_height;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PROTOGEN_RECT_H
+#define PROTOGEN_RECT_H
+
+#include <algorithm>
+
+namespace protogen {
+
+/**
+ * An axis-aligned rectangle of pixels. (x, y) is the top-left pixel.
+ * A rectangle with a non-positive width or height is empty.
+ */
+struct Rect {
+    int x;
+    int y;
+    int width;
+    int height;
+
+    bool empty() const {
+        return width <= 0 || height <= 0;
+    }
+    int area() const {
+        return empty() ? 0 : width * height;
+    }
+    bool contains(const Rect& other) const {
+        return other.x >= x && other.y >= y && other.x + other.width <= x + width && other.y + other.height <= y + height;
+    }
+    /**
+     * True if the rectangles overlap or share an edge or corner.
+     */
+    bool touches(const Rect& other) const {
+        return other.x <= x + width && x <= other.x + other.width && other.y <= y + height && y <= other.y + other.height;
+    }
+    /**
+     * The smallest rectangle containing both rectangles.
+     */
+    Rect united(const Rect& other) const {
+        const int left = std::min(x, other.x);
+        const int top = std::min(y, other.y);
+        const int right = std::max(x + width, other.x + other.width);
+        const int bottom = std::max(y + height, other.y + other.height);
+        return {left, top, right - left, bottom - top};
+    }
+    /**
+     * The overlapping part of both rectangles. May be empty.
+     */
+    Rect intersected(const Rect& other) const {
+        const int left = std::max(x, other.x);
+        const int top = std::max(y, other.y);
+        const int right = std::min(x + width, other.x + other.width);
+        const int bottom = std::min(y + height, other.y + other.height);
+        return {left, top, right - left, bottom - top};
+    }
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef PROTOGEN_SCALINGRENDERSURFACE_H
+#define PROTOGEN_SCALINGRENDERSURFACE_H
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/ImageScaler.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+namespace protogen {
+
+/**
+ * Lets a drawer draw at a logical resolution of its choosing and shows the
+ * result scaled to another render surface.
+ *
+ * Frames are drawn into an offscreen canvas of the logical resolution and
+ * scaled with an ImageScaler, so one set of assets serves every surface
+ * and scaling costs the same every frame. Attributes are those of the
+ * wrapped surface.
+ */
+class ScalingRenderSurface : public IRenderSurface {
+public:
+    /**
+     * `surface` must already be initialized.
+     */
+    ScalingRenderSurface(std::shared_ptr<IRenderSurface> surface, Resolution logical_resolution, ImageScaler::Filter filter);
+
+    Initialization initialize() override;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override;
+    Resolution resolution() const override;
+    std::optional<std::string> getAttribute(const std::string& key) const override;
+    std::vector<std::string> listAttributes() const override;
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override;
+    RemoveAttributeResult removeAttribute(const std::string& key) override;
+    bool hasAttribute(const std::string& key) const override;
+
+    /**
+     * Parses a resolution such as "128x32".
+     */
+    static std::optional<Resolution> parseResolution(const std::string& resolution);
+    /**
+     * Parses "nearest" or "bilinear".
+     */
+    static std::optional<ImageScaler::Filter> parseFilter(const std::string& filter);
+
+private:
+    std::shared_ptr<IRenderSurface> m_surface;
+    Resolution m_logicalResolution;
+    MemoryCanvas m_logical;
+    MemoryCanvas m_physical;
+    ImageScaler m_scaler;
+};
+
+} // namespace
+
+#endif
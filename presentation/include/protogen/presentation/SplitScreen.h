@@ -0,0 +1,57 @@
+#ifndef PROTOGEN_SPLITSCREEN_H
+#define PROTOGEN_SPLITSCREEN_H
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/Window.h>
+
+namespace protogen {
+
+/**
+ * Splits one render surface into windows which are drawn independently,
+ * for example so that two apps can share the visor.
+ *
+ * Every window is a render surface of its own and draws into its own
+ * buffer, so windows can draw at the same time from different threads.
+ * When a window finishes a frame, its rectangle is copied into a frame
+ * shared by all windows, which is then presented to the parent surface.
+ * Windows finishing while the parent is being presented to only copy
+ * their rectangle, and the window presenting presents once more for all
+ * of them, rather than every window presenting the whole frame in turn.
+ * Only the copies are serialized, never the drawing.
+ *
+ * Windows are identified as `<parent id>_window_<n>`, numbered from 1 in
+ * the order they were added.
+ */
+class SplitScreen : public std::enable_shared_from_this<SplitScreen> {
+public:
+    static std::shared_ptr<SplitScreen> make(std::shared_ptr<IRenderSurface> parent);
+
+    /**
+     * A render surface which draws into `window` of the parent. Nothing if
+     * the window does not fit in the parent or overlaps another window.
+     */
+    std::optional<std::shared_ptr<IRenderSurface>> addWindow(const Window& window);
+
+private:
+    class WindowRenderSurface;
+
+    explicit SplitScreen(std::shared_ptr<IRenderSurface> parent);
+    void present(const Window& window, const MemoryCanvas& frame);
+
+    std::shared_ptr<IRenderSurface> m_parent;
+    std::mutex m_mutex; // Guards everything below.
+    MemoryCanvas m_frame;
+    std::vector<Window> m_windows;
+    bool m_pending;    // `m_frame` changed since it was last presented.
+    bool m_presenting; // A window is presenting `m_frame` to the parent.
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef PROTOGEN_SPRITEATLAS_H
+#define PROTOGEN_SPRITEATLAS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <protogen/ICanvas.hpp>
+#include <protogen/presentation/BasicCanvas.h>
+#include <protogen/presentation/PixelFormat.h>
+#include <protogen/presentation/Rect.h>
+
+#include <Magick++.h>
+
+namespace protogen {
+
+/**
+ * Holds decoded images, called sprites, ready to be drawn without any
+ * conversion onto a BasicCanvas of the same `Format`.
+ *
+ * Images are decoded once when they are added. Each sprite is trimmed to
+ * the bounding box of its visible pixels and its pixels are packed in
+ * `Format` in one contiguous buffer shared by all sprites. Every sprite
+ * also keeps a list of runs of opaque and translucent pixels, with
+ * transparent pixels left out. Drawing a sprite then only copies the rows
+ * of the opaque runs and blends the translucent ones, so GraphicsMagick is
+ * not needed while drawing. On any other canvas, opaque runs are unpacked
+ * and drawn with `ICanvas::blit`.
+ *
+ * Sprites are identified by the id returned when they are added. Ids are
+ * consecutive and start at 0.
+ *
+ * Adding sprites is not thread-safe. Once every sprite is added, the
+ * atlas can be drawn from any number of threads.
+ */
+template<typename Format>
+class BasicSpriteAtlas {
+public:
+    using SpriteId = std::size_t;
+    using Pixel = typename Format::Pixel;
+
+    BasicSpriteAtlas()
+        : m_sprites(), m_runs(), m_pixels(), m_rgba()
+    {
+    }
+
+    /**
+     * Adds an image as a new sprite and returns its id.
+     */
+    SpriteId add(const Magick::Image& image) {
+        const unsigned int width = image.columns();
+        const unsigned int height = image.rows();
+        const Magick::PixelPacket* pixels = image.getConstPixels(0, 0, width, height);
+
+        // Magick opacity is the inverse of alpha.
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        for(unsigned int i = 0; i < width * height; ++i) {
+            const Magick::PixelPacket& pixel = pixels[i];
+            rgba[i * 4] = pixel.red;
+            rgba[i * 4 + 1] = pixel.green;
+            rgba[i * 4 + 2] = pixel.blue;
+            rgba[i * 4 + 3] = 255 - pixel.opacity;
+        }
+        return add(rgba.data(), width * 4, width, height);
+    }
+    /**
+     * Adds a block of straight (not premultiplied) RGBA8888 pixels as a new
+     * sprite and returns its id. `stride` is the number of bytes between the
+     * start of consecutive rows.
+     */
+    SpriteId add(const uint8_t* rgba, int stride, int width, int height) {
+        auto alpha = [&](int x, int y) { return rgba[y * stride + x * 4 + 3]; };
+
+        Sprite sprite{width, height, width, height, 0, 0, m_pixels.size(), m_runs.size(), 0};
+        int right = -1;
+        int bottom = -1;
+        for(int y = 0; y < height; ++y) {
+            for(int x = 0; x < width; ++x) {
+                if(alpha(x, y) != 0) {
+                    sprite.trim_x = std::min(sprite.trim_x, x);
+                    sprite.trim_y = std::min(sprite.trim_y, y);
+                    right = std::max(right, x);
+                    bottom = std::max(bottom, y);
+                }
+            }
+        }
+        if(right < 0) {
+            // Fully transparent; nothing to draw.
+            sprite.trim_x = 0;
+            sprite.trim_y = 0;
+            m_sprites.push_back(sprite);
+            return m_sprites.size() - 1;
+        }
+        sprite.trim_width = right - sprite.trim_x + 1;
+        sprite.trim_height = bottom - sprite.trim_y + 1;
+
+        for(int j = 0; j < sprite.trim_height; ++j) {
+            const uint8_t * row = rgba + (sprite.trim_y + j) * stride + sprite.trim_x * 4;
+            for(int i = 0; i < sprite.trim_width; ++i) {
+                m_pixels.push_back(Format::pack(row[i * 4], row[i * 4 + 1], row[i * 4 + 2]));
+            }
+        }
+
+        // Split every row into runs and extend the runs of the previous row
+        // when a run has the same columns and kind.
+        std::vector<std::size_t> previous_row;
+        std::vector<std::size_t> current_row;
+        for(int j = 0; j < sprite.trim_height; ++j) {
+            current_row.clear();
+            int i = 0;
+            while(i < sprite.trim_width) {
+                const uint8_t a = alpha(sprite.trim_x + i, sprite.trim_y + j);
+                int end = i + 1;
+                if(a == 0) {
+                    while(end < sprite.trim_width && alpha(sprite.trim_x + end, sprite.trim_y + j) == 0) {
+                        ++end;
+                    }
+                    i = end;
+                    continue;
+                }
+                const bool translucent = a != 255;
+                while(end < sprite.trim_width) {
+                    const uint8_t next = alpha(sprite.trim_x + end, sprite.trim_y + j);
+                    if(next == 0 || (next != 255) != translucent) {
+                        break;
+                    }
+                    ++end;
+                }
+                const auto extendable = std::find_if(previous_row.begin(), previous_row.end(), [&](std::size_t index) {
+                    const Run& run = m_runs[index];
+                    return run.x == i && run.width == end - i && run.translucent == translucent;
+                });
+                if(extendable != previous_row.end()) {
+                    ++m_runs[*extendable].height;
+                    current_row.push_back(*extendable);
+                } else {
+                    m_runs.push_back({static_cast<uint16_t>(i), static_cast<uint16_t>(j), static_cast<uint16_t>(end - i), 1, translucent, 0});
+                    current_row.push_back(m_runs.size() - 1);
+                }
+                i = end;
+            }
+            std::swap(previous_row, current_row);
+        }
+        sprite.run_count = m_runs.size() - sprite.first_run;
+
+        // Translucent runs are blended, which needs their alpha. Store their
+        // pixels contiguously so each is one blend call.
+        for(std::size_t r = sprite.first_run; r < m_runs.size(); ++r) {
+            Run& run = m_runs[r];
+            if(!run.translucent) {
+                continue;
+            }
+            run.rgba_offset = m_rgba.size();
+            for(int j = 0; j < run.height; ++j) {
+                const uint8_t * row = rgba + (sprite.trim_y + run.y + j) * stride + (sprite.trim_x + run.x) * 4;
+                m_rgba.insert(m_rgba.end(), row, row + run.width * 4);
+            }
+        }
+
+        m_sprites.push_back(sprite);
+        return m_sprites.size() - 1;
+    }
+    /**
+     * Reads an image file and adds it as a new sprite. Throws whatever
+     * GraphicsMagick throws if the file cannot be read.
+     */
+    SpriteId addFile(const std::string& filename) {
+        Magick::Image image(filename);
+        return add(image);
+    }
+
+    /**
+     * Number of sprites.
+     */
+    std::size_t size() const {
+        return m_sprites.size();
+    }
+    /**
+     * Width of the sprite as it was added, before trimming.
+     */
+    int width(SpriteId id) const {
+        return m_sprites.at(id).width;
+    }
+    /**
+     * Height of the sprite as it was added, before trimming.
+     */
+    int height(SpriteId id) const {
+        return m_sprites.at(id).height;
+    }
+
+    /**
+     * Draws the sprite with the top-left corner of its untrimmed image at
+     * (x, y). Does nothing if `id` is not a sprite of this atlas.
+     */
+    void draw(ICanvas& canvas, SpriteId id, int x, int y) const {
+        if(id >= m_sprites.size()) {
+            return;
+        }
+        const Sprite& sprite = m_sprites[id];
+        const int origin_x = x + sprite.trim_x;
+        const int origin_y = y + sprite.trim_y;
+        auto * native = dynamic_cast<BasicCanvas<Format> *>(&canvas);
+        std::vector<uint8_t> rgb; // Staging for opaque runs on other canvases.
+        for(std::size_t r = sprite.first_run; r < sprite.first_run + sprite.run_count; ++r) {
+            const Run& run = m_runs[r];
+            if(run.translucent) {
+                canvas.blendBlit(m_rgba.data() + run.rgba_offset, run.width * 4, origin_x + run.x, origin_y + run.y, run.width, run.height);
+                continue;
+            }
+            const Pixel * first_pixel = m_pixels.data() + sprite.pixel_offset + static_cast<std::size_t>(run.y) * sprite.trim_width + run.x;
+            const Rect destination{origin_x + run.x, origin_y + run.y, run.width, run.height};
+            if(native != nullptr) {
+                const Rect visible = destination.intersected(Rect{0, 0, native->width(), native->height()});
+                for(int j = 0; j < visible.height; ++j) {
+                    const Pixel * source = first_pixel + static_cast<std::size_t>(visible.y - destination.y + j) * sprite.trim_width + (visible.x - destination.x);
+                    std::copy_n(source, visible.width, native->row(visible.y + j) + visible.x);
+                }
+                continue;
+            }
+            rgb.resize(static_cast<std::size_t>(run.width) * run.height * 3);
+            for(int j = 0; j < run.height; ++j) {
+                for(int i = 0; i < run.width; ++i) {
+                    const auto color = Format::unpack(first_pixel[static_cast<std::size_t>(j) * sprite.trim_width + i]);
+                    uint8_t * destination_pixel = rgb.data() + (static_cast<std::size_t>(j) * run.width + i) * 3;
+                    destination_pixel[0] = color.red;
+                    destination_pixel[1] = color.green;
+                    destination_pixel[2] = color.blue;
+                }
+            }
+            canvas.blit(rgb.data(), run.width * 3, destination.x, destination.y, run.width, run.height);
+        }
+    }
+
+private:
+    /**
+     * A block of pixels of the same kind, relative to the trimmed box.
+     * Runs on consecutive rows with the same columns are merged.
+     */
+    struct Run {
+        uint16_t x;
+        uint16_t y;
+        uint16_t width;
+        uint16_t height;
+        bool translucent;
+        std::size_t rgba_offset; // Into m_rgba for translucent runs.
+    };
+
+    struct Sprite {
+        int width;
+        int height;
+        int trim_x;
+        int trim_y;
+        int trim_width;
+        int trim_height;
+        std::size_t pixel_offset; // Into m_pixels, rows of trim_width pixels.
+        std::size_t first_run;
+        std::size_t run_count;
+    };
+
+    std::vector<Sprite> m_sprites;
+    std::vector<Run> m_runs;
+    std::vector<Pixel> m_pixels; // Every visible sprite pixel, in `Format`.
+    std::vector<uint8_t> m_rgba; // Pixels of translucent runs, RGBA8888.
+};
+
+/**
+ * Sprites for canvases without a pixel format of their own, such as
+ * MemoryCanvas, drawn with RGB888 blits.
+ */
+using SpriteAtlas = BasicSpriteAtlas<pixel_formats::Rgb888>;
+
+} // namespace
+
+#endif
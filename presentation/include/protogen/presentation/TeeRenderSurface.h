@@ -0,0 +1,102 @@
+#ifndef PROTOGEN_TEERENDERSURFACE_H
+#define PROTOGEN_TEERENDERSURFACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/Resolution.hpp>
+#include <protogen/presentation/DisplayList.h>
+#include <protogen/presentation/TripleBuffer.h>
+
+namespace protogen {
+
+/**
+ * Shows frames on another render surface and also hands every frame to
+ * sinks, such as an exporter, a recorder or an encoder.
+ *
+ * The drawer is recorded once, however many sinks there are, and the
+ * recording is replayed onto the wrapped surface and given to every sink.
+ * Sinks which need every frame get it on the drawing thread, after it was
+ * shown. Other sinks get it on one consumer thread, through a triple
+ * buffer, so the cost on the drawing thread is the recording alone; if the
+ * consumer falls behind, it skips frames. Frame numbers count every frame.
+ *
+ * Threads drawing frames at once take turns, since every frame is
+ * recorded into the same triple buffer. Sinks must be added before frames
+ * are drawn. Until a sink is added, frames are passed to the wrapped
+ * surface untouched. Attributes are those of the wrapped surface.
+ */
+class TeeRenderSurface : public IRenderSurface {
+public:
+    struct RecordedFrame {
+        DisplayList list;
+        std::chrono::steady_clock::time_point completed_at;
+        uint64_t frame_number;
+    };
+
+    /**
+     * Takes recorded frames. Frames have the resolution of the wrapped
+     * surface.
+     */
+    class Sink {
+    public:
+        virtual ~Sink() = default;
+        virtual void consumeFrame(const RecordedFrame& frame) = 0;
+    };
+
+    enum class Delivery {
+        /**
+         * On the consumer thread, skipping frames when it falls behind.
+         */
+        Latest,
+        /**
+         * On the drawing thread, every frame.
+         */
+        EveryFrame,
+    };
+
+    /**
+     * `surface` must already be initialized.
+     */
+    explicit TeeRenderSurface(std::shared_ptr<IRenderSurface> surface);
+    ~TeeRenderSurface() override;
+
+    void addSink(std::shared_ptr<Sink> sink, Delivery delivery);
+
+    Initialization initialize() override;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override;
+    Resolution resolution() const override;
+    std::optional<std::string> getAttribute(const std::string& key) const override;
+    std::vector<std::string> listAttributes() const override;
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override;
+    RemoveAttributeResult removeAttribute(const std::string& key) override;
+    bool hasAttribute(const std::string& key) const override;
+
+private:
+    void stopConsumer();
+    void consumerLoop();
+
+    std::shared_ptr<IRenderSurface> m_surface;
+    int m_width;
+    int m_height;
+    std::mutex m_producerMutex; // Held by drawFrame while recording, numbering and publishing.
+    uint64_t m_frameNumber;     // Guarded by m_producerMutex.
+    std::vector<std::shared_ptr<Sink>> m_everyFrameSinks;
+    std::vector<std::shared_ptr<Sink>> m_latestSinks;
+
+    // Hand-off of recorded frames from the drawing thread to the consumer.
+    TripleBuffer<RecordedFrame> m_frames;
+    std::atomic<uint32_t> m_framesPublished; // Waited on by the consumer thread.
+    std::atomic<bool> m_stopping;
+    std::thread m_consumerThread;
+};
+
+} // namespace
+
+#endif
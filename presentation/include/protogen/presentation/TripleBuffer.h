@@ -0,0 +1,84 @@
+#ifndef PROTOGEN_TRIPLEBUFFER_H
+#define PROTOGEN_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace protogen {
+
+/**
+ * Hands values from one producer thread to one consumer thread without
+ * locks and without either side waiting for the other.
+ *
+ * There are three slots. The producer owns the back slot and the consumer
+ * owns the front slot. The third slot holds the newest published value.
+ * Publishing swaps the back slot with it, and acquiring swaps the front
+ * slot with it if something new was published, so the consumer always
+ * gets the newest complete value and older unread values are overwritten.
+ *
+ * Slots are reused, never reset, so values which keep their storage
+ * between uses (such as a cleared DisplayList) do not allocate once every
+ * slot has grown.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : m_slots(),
+        m_back(0),
+        m_middle(1),
+        m_front(2)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * The slot the producer writes the next value into.
+     */
+    T& back() {
+        return m_slots[m_back];
+    }
+    /**
+     * Makes the back slot the newest value and gives the producer another
+     * slot. Returns true if the previous value was never acquired.
+     */
+    bool publish() {
+        const uint8_t previous = m_middle.exchange(m_back | NEW, std::memory_order_acq_rel);
+        m_back = previous & INDEX;
+        return (previous & NEW) != 0;
+    }
+    /**
+     * Moves the newest published value to the front slot. Returns false,
+     * and keeps the front slot as it is, if nothing was published since the
+     * last call.
+     */
+    bool acquire() {
+        if((m_middle.load(std::memory_order_relaxed) & NEW) == 0) {
+            return false;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    /**
+     * The slot holding the value the consumer acquired last.
+     */
+    T& front() {
+        return m_slots[m_front];
+    }
+
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t NEW = 0x4;
+
+    std::array<T, 3> m_slots;
+    uint8_t m_back;                 // Only used by the producer.
+    std::atomic<uint8_t> m_middle;  // Index of the shared slot, and NEW if unread.
+    uint8_t m_front;                // Only used by the consumer.
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef PROTOGEN_WORKSTEALINGPOOL_H
+#define PROTOGEN_WORKSTEALINGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace protogen {
+
+/**
+ * A fixed set of threads which run the iterations of a loop in parallel.
+ *
+ * Every thread, including the one calling `parallelFor`, has its own queue
+ * of iterations. Threads take work from the front of their own queue and,
+ * once it is empty, steal from the back of the others, so uneven
+ * iterations still keep every thread busy.
+ *
+ * `parallelFor` may be called from several threads; the calls run one
+ * after another.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @param threads Number of threads working on each loop, including the
+     * calling thread. At least 1.
+     */
+    explicit WorkStealingPool(std::size_t threads);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Number of threads working on each loop, including the calling thread.
+     */
+    std::size_t size() const;
+
+    /**
+     * Calls `task(i)` for every i in [0, count) and returns once all calls
+     * have finished. Calls may run in any order and in parallel.
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> iterations;
+    };
+
+    /**
+     * Runs one iteration, from `self`'s queue if possible or stolen from
+     * another queue. Returns false if every queue is empty.
+     */
+    bool runOne(std::size_t self);
+    void workerLoop(std::size_t self);
+
+    std::vector<std::unique_ptr<Queue>> m_queues; // Queue 0 belongs to the calling thread.
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_callMutex; // Serializes calls to `parallelFor`.
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+    const std::function<void(std::size_t)> * m_task;
+    std::atomic<std::size_t> m_remaining;
+    uint64_t m_generation;
+    bool m_stopping;
+};
+
+} // namespace
+
+#endif
@@ -4,11 +4,23 @@
 #include <stdexcept>
 #include <memory>
 #include <optional>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <mutex>
+#include <vector>
+#include <array>
 #include <tuple>
 #include <functional>
 
 #include <protogen/presentation/render_surface.h>
+#include <protogen/presentation/BasicCanvas.h>
+#include <protogen/presentation/PixelFormat.h>
+#include <protogen/presentation/DirtyRegion.h>
+#include <protogen/presentation/DisplayList.h>
+#include <protogen/presentation/TripleBuffer.h>
+#include <protogen/presentation/PowerGovernor.h>
+#include <protogen/presentation/FrameMetrics.h>
 #include <protogen/ICanvas.hpp>
 #include <protogen/Resolution.hpp>
 #include <protogen/IAttributeStore.hpp>
@@ -18,21 +30,20 @@
 namespace protogen {
 
 /**
- * Adapter for rgb_matrix::Canvas to ICanvas.
- * Does NOT take ownership of rgb_matrix::Canvas.
+ * Render surface for the HUB75 LED matrices of the protogen head.
+ *
+ * `drawFrame` only records the drawer's calls into a display list on the
+ * calling thread. Recorded frames are handed to a dedicated render thread
+ * through a lock-free triple buffer; the render thread replays the newest
+ * one onto the panel and waits for vsync. `drawFrame` never waits for the
+ * render thread: a frame the render thread had no time to show is dropped
+ * in favour of the next one. Threads calling `drawFrame` at once take
+ * turns recording, so the triple buffer only ever has one producer.
+ *
+ * Frames are dimmed as needed to keep the panels' estimated current under
+ * the budget in milliamps set by the PROTOGEN_HUB75_POWER_BUDGET_MA
+ * environment variable (0 turns this off), or the PowerGovernor default.
  */
-class RgbMatrixCanvasToICanvasAdapter : public ICanvas {
-public:
-	RgbMatrixCanvasToICanvasAdapter(rgb_matrix::Canvas * canvas);
-	int width() const override;
-	int height() const override;
-	void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
-	void clear() override;
-	void fill(uint8_t red, uint8_t green, uint8_t blue) override;
-private:
-	rgb_matrix::Canvas * mCanvas;
-};
-
 class ProtogenHeadMatrices final : public IRenderSurface {
 public:
 	ProtogenHeadMatrices();
@@ -54,12 +65,46 @@ private:
 	};
 	
 	rgb_matrix::FrameCanvas * getNextProtogenFrameBuffer();
+	void renderLoop();
+	void presentFrame(const DisplayList& list);
+	void limitPower();
+
+	static constexpr const char * ENV_VAR_POWER_BUDGET = "PROTOGEN_HUB75_POWER_BUDGET_MA";
+
+	// Channel order the panels expect. Frames are kept in this order so
+	// pixels go to the frame buffers without being swizzled.
+	using PanelFormat = pixel_formats::Rbg888;
 
 	std::unique_ptr<rgb_matrix::RGBMatrix> m_matrix;
 	rgb_matrix::FrameCanvas * m_protogenFrameBuffer0;
 	rgb_matrix::FrameCanvas * m_protogenFrameBuffer1;
 	unsigned int m_whichProtogenFrameBufferIsUsed;
-	mutable std::mutex m_mutex;
+
+	struct RecordedFrame {
+		DisplayList list;
+		std::chrono::steady_clock::time_point completed_at;
+	};
+
+	// Hand-off of recorded frames from the app thread to the render thread.
+	TripleBuffer<RecordedFrame> m_frames;
+	std::atomic<uint32_t> m_framesPublished; // Waited on by the render thread.
+	std::mutex m_producerMutex; // Held by drawFrame while recording and publishing.
+	std::atomic<bool> m_stopping;
+	uint64_t m_droppedFrames; // Guarded by m_producerMutex.
+	std::thread m_renderThread;
+	std::shared_ptr<FrameTimings> m_timings; // Dropped frames count as missed deadlines.
+
+	// Everything below is only used by the render thread.
+	// Copy of what is on the panel. Frames are replayed here so that only
+	// the pixels which changed are written to the frame buffers.
+	BasicCanvas<PanelFormat> m_frame;
+	DirtyRegion m_drawnLastFrame;   // Pixels drawn by the previous drawer.
+	DirtyRegion m_changedLastFrame; // Pixels that differ between the last two frames.
+	PowerGovernor m_powerGovernor;
+	std::array<uint8_t, 256> m_brightnessLut; // Channel values at the current brightness.
+	uint8_t m_brightness;
+	bool m_brightnessChanged;          // Since the frame before.
+	bool m_brightnessChangedLastFrame;
 
 	std::shared_ptr<attributes::IAttributeStore> m_attributes;
 };
@@ -1,48 +1,105 @@
 #ifndef RENDER_SURFACE_H
 #define RENDER_SURFACE_H
 
+#include <cstdint>
 #include <functional>
-
-#include <led-matrix.h>
+#include <memory>
+#include <mutex>
+#include <ostream>
 
 #include <protogen/ICanvas.hpp>
 #include <protogen/Resolution.hpp>
 #include <protogen/IRenderSurface.hpp>
 #include <protogen/StandardAttributeStore.hpp>
 #include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/CountingCanvas.h>
+#include <protogen/presentation/FrameMetrics.h>
+#include <protogen/presentation/Histogram.h>
+#include <protogen/presentation/MemoryCanvas.h>
 
 namespace protogen {
 
+/**
+ * A render surface without a display, for running and profiling apps on
+ * machines without one.
+ *
+ * Drawers run against an offscreen canvas of the chosen resolution. How
+ * long each drawer took goes into a histogram and what it drew is counted
+ * per canvas primitive, as a Report which can be read at any time from any
+ * thread. With a report interval, the report is also printed to standard
+ * output every that many frames.
+ *
+ * Without rasterizing, drawers run against a canvas which discards what is
+ * drawn, so only drawer time is measured. This is how the surface runs
+ * when it is only a fallback for a missing display.
+ */
 class FakeRenderSurface : public IRenderSurface {
 public:
-    FakeRenderSurface() : m_attributes(new StandardAttributeStore()) {
-        setAttribute(attributes::A_ID, "fake_render_surface");
-        setAttribute(attributes::A_NAME, "Fake Render Surface");
-        setAttribute(attributes::A_DESCRIPTION, "A fake render surface that does nothing.");
-    }
-    Initialization initialize() override { return Initialization::Success; }
-    void drawFrame(const std::function<void(ICanvas&)>&) override {}
-    Resolution resolution() const override { return Resolution(512, 512); }
-    
-    std::optional<std::string> getAttribute(const std::string& key) const override {
-        return m_attributes->getAttribute(key);
-    }
-    std::vector<std::string> listAttributes() const override {
-        return m_attributes->listAttributes();
-    }
-    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override {
-        return m_attributes->setAttribute(key, value);
-    }
-    RemoveAttributeResult removeAttribute(const std::string& key) override {
-        return m_attributes->removeAttribute(key);
-    }
-    bool hasAttribute(const std::string& key) const override {
-        return m_attributes->hasAttribute(key);
-    }
+    struct Report {
+        Resolution resolution;
+        uint64_t frames;
+        // Totals over every frame.
+        DrawCounts counts;
+        Histogram::Snapshot drawer_time_ns;
+
+        void print(std::ostream& out) const;
+    };
+
+    /**
+     * A surface of DEFAULT_WIDTH by DEFAULT_HEIGHT which does not rasterize.
+     */
+    FakeRenderSurface();
+    /**
+     * `report_interval` is the number of frames between printed reports,
+     * or 0 to never print them.
+     */
+    explicit FakeRenderSurface(Resolution resolution, uint64_t report_interval = 0, bool rasterize = true);
+
+    /**
+     * A fake render surface configured by PROTOGEN_FAKE_RENDER_SURFACE,
+     * a resolution such as "128x32", and
+     * PROTOGEN_FAKE_RENDER_SURFACE_REPORT_FRAMES. Frames are only
+     * rasterized when the resolution is set; otherwise, or if it cannot be
+     * parsed, the resolution is DEFAULT_WIDTH by DEFAULT_HEIGHT.
+     */
+    static std::shared_ptr<FakeRenderSurface> fromEnvironment();
+
+    Initialization initialize() override;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override;
+    Resolution resolution() const override;
+    std::optional<std::string> getAttribute(const std::string& key) const override;
+    std::vector<std::string> listAttributes() const override;
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override;
+    RemoveAttributeResult removeAttribute(const std::string& key) override;
+    bool hasAttribute(const std::string& key) const override;
+
+    Report report() const;
+    void resetReport();
+    /**
+     * The most recent frame, or an empty canvas if frames are not
+     * rasterized.
+     */
+    const MemoryCanvas& canvas() const;
+
+    static constexpr const char * ENV_VAR_RESOLUTION = "PROTOGEN_FAKE_RENDER_SURFACE";
+    static constexpr const char * ENV_VAR_REPORT_FRAMES = "PROTOGEN_FAKE_RENDER_SURFACE_REPORT_FRAMES";
+    static constexpr unsigned int DEFAULT_WIDTH = 512;
+    static constexpr unsigned int DEFAULT_HEIGHT = 512;
+
 private:
     std::shared_ptr<attributes::IAttributeStore> m_attributes;
+    Resolution m_resolution;
+    uint64_t m_reportInterval;
+    bool m_rasterize;
+    MemoryCanvas m_canvas;
+    DrawCounts m_frameCounts;   // Only used by the drawing thread.
+
+    std::shared_ptr<FrameTimings> m_timings; // Also read for the report.
+    mutable std::mutex m_countsMutex;
+    DrawCounts m_counts;
+    uint64_t m_frames;
 };
 
 }   // namespace
 
-#endif
\ No newline at end of file
+#endif
@@ -1,13 +1,25 @@
 #ifndef SDLRENDERSURFACE_H
 #define SDLRENDERSURFACE_H
 
+#include <atomic>
 #include <optional>
 #include <memory>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <future>
 
 #include <SDL2/SDL.h>
 
 #include <protogen/presentation/render_surface.h>
 #include <protogen/ICanvas.hpp>
+#include <protogen/presentation/DirtyRegion.h>
+#include <protogen/presentation/BandedRenderer.h>
+#include <protogen/presentation/DisplayList.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/FrameMetrics.h>
 #include <protogen/Resolution.hpp>
 #include <protogen/IAttributeStore.hpp>
 
@@ -16,6 +28,10 @@ namespace protogen {
 /**
  * Takes an SDL_Renderer and adapts it to the ICanvas interface.
  * Does NOT take ownership of SDL_Renderer.
+ *
+ * SdlRenderSurface no longer draws through this adapter. It is only kept
+ * for the SDL upload benchmark, as the baseline of drawing straight to a
+ * renderer.
  */
 class SdlRendererToICanvasAdapter : public ICanvas {
 public:
@@ -25,10 +41,27 @@ public:
     void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override;
     void clear() override;
     void fill(uint8_t red, uint8_t green, uint8_t blue) override;
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override;
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override;
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override;
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override;
 private:
+    struct TextureDestroyer {
+        void operator()(SDL_Texture * texture) { SDL_DestroyTexture(texture); }
+    };
+
+    /**
+     * Uploads a block of pixels to a temporary texture and copies it to the
+     * renderer at (x, y).
+     */
+    void copyPixels(Uint32 pixel_format, const void * pixels, int pitch, int x, int y, int width, int height, SDL_BlendMode blend_mode);
+
     SDL_Renderer * m_renderer;
     int m_width;
     int m_height;
+    std::vector<uint8_t> m_maskedPixels; // RGBA scratch space for `blitMasked`.
 };
 
 /**
@@ -38,6 +71,24 @@ private:
  * environment variables PROTOGEN_SDL_RENDER_SURFACE_WIDTH and
  * PROTOGEN_SDL_RENDER_SURFACE_HEIGHT, respectively. Otherwise, the default
  * width and height will be used.
+ *
+ * Drawers render into an offscreen MemoryCanvas on the app's thread. The
+ * finished frame is handed to a present thread which owns the window,
+ * pumps SDL events, uploads the changed pixels to a streaming texture and
+ * shows it with a single render call. `drawFrame` never waits for the
+ * display: if the app finishes a frame before the previous one was shown,
+ * the previous one is dropped. When the window is closed, the present
+ * thread destroys it and says so on standard error, and later frames are
+ * ignored.
+ *
+ * Presentation follows the display's vsync, or the frame rate set in
+ * PROTOGEN_SDL_RENDER_SURFACE_FPS. Dropped frames, late frames (shown more
+ * than one frame period after they were finished) and presented frames are
+ * counted in attributes.
+ *
+ * For large windows, setting PROTOGEN_SDL_RENDER_SURFACE_THREADS to more
+ * than 1 enables banded rendering: the drawer is recorded and rasterized
+ * into the offscreen canvas in horizontal bands on that many threads.
  */
 class SdlRenderSurface : public IRenderSurface {
 public:
@@ -64,15 +115,60 @@ private:
     struct RendererDestroyer {
         void operator()(SDL_Renderer * renderer) { SDL_DestroyRenderer(renderer); }
     };
+    struct TextureDestroyer {
+        void operator()(SDL_Texture * texture) { SDL_DestroyTexture(texture); }
+    };
+
+    // Run on the present thread.
+    void presentLoop(std::promise<void> window_created);
+    void createWindow();
+    void destroyWindow();
+    /**
+     * Handles pending window events. Returns false once the window was
+     * closed.
+     */
+    bool pumpEvents();
+    void uploadPendingFrame();
 
     Resolution m_resolution;
+    unsigned int m_targetFps; // 0 to follow vsync.
+    std::chrono::nanoseconds m_framePeriod;
+
+    // Only used by the present thread.
     std::unique_ptr<SDL_Window, WindowDestroyer> m_window;
     std::unique_ptr<SDL_Renderer, RendererDestroyer> m_renderer;
+    std::unique_ptr<SDL_Texture, TextureDestroyer> m_texture;
+    bool m_textureIsStale; // The texture has not received a whole frame yet.
+    uint64_t m_presentedFrames;
+    uint64_t m_lateFrames;
+
+    // Hand-off of finished frames from the app thread to the present thread.
+    std::mutex m_mutex;
+    std::condition_variable m_frameReady;
+    std::unique_ptr<MemoryCanvas> m_pending; // Newest finished frame.
+    DirtyRegion m_pendingRegion; // Pixels of `m_pending` not uploaded yet.
+    std::chrono::steady_clock::time_point m_pendingCompletedAt;
+    bool m_hasPendingFrame;
+    bool m_stopping;
+    uint64_t m_droppedFrames;
+    std::thread m_presentThread;
+    std::atomic<bool> m_closed; // The window was closed by the user.
+
+    // Only used by the thread calling `drawFrame`.
+    std::unique_ptr<MemoryCanvas> m_frame; // What the drawer drew last.
+    DirtyRegion m_drawnLastFrame; // Pixels drawn by the previous drawer.
+    std::unique_ptr<BandedRenderer> m_bandedRenderer;
+    DisplayList m_displayList;
 
+    std::shared_ptr<FrameTimings> m_timings; // Late frames count as missed deadlines.
     std::shared_ptr<attributes::IAttributeStore> m_attributes;
 
     static constexpr const char * ENV_VAR_WIDTH = "PROTOGEN_SDL_RENDER_SURFACE_WIDTH";
     static constexpr const char * ENV_VAR_HEIGHT = "PROTOGEN_SDL_RENDER_SURFACE_HEIGHT";
+    static constexpr const char * ENV_VAR_THREADS = "PROTOGEN_SDL_RENDER_SURFACE_THREADS";
+    static constexpr const char * ENV_VAR_FPS = "PROTOGEN_SDL_RENDER_SURFACE_FPS";
+    static constexpr int DEFAULT_REFRESH_RATE = 60;
+    static constexpr std::chrono::milliseconds EVENT_POLL_INTERVAL{10};
     static const unsigned int DEFAULT_WIDTH = 128;
     static const unsigned int DEFAULT_HEIGHT = 32;
 };
@@ -0,0 +1,102 @@
+#include <protogen/presentation/BandedRenderer.h>
+#include <protogen/PolygonRasterizer.hpp>
+
+#include <algorithm>
+
+namespace protogen {
+
+namespace {
+
+/**
+ * Presents the rows from `first_row` of a full-size canvas as a canvas of
+ * the full size, but only draws into `band`, a view of those rows. Band
+ * views clip everything else.
+ */
+class BandCanvas : public ICanvas {
+public:
+    BandCanvas(MemoryCanvas& band, int first_row, int full_height)
+        : m_band(band), m_firstRow(first_row), m_fullHeight(full_height)
+    {}
+
+    int width() const override { return m_band.width(); }
+    int height() const override { return m_fullHeight; }
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+        m_band.setPixel(x, y - m_firstRow, red, green, blue);
+    }
+    void clear() override { m_band.clear(); }
+    void fill(uint8_t red, uint8_t green, uint8_t blue) override { m_band.fill(red, green, blue); }
+    void fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue) override {
+        m_band.fillRegion(x, y - m_firstRow, width, height, red, green, blue);
+    }
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+        m_band.drawSpan(x0, x1, y - m_firstRow, red, green, blue);
+    }
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override {
+        m_band.blit(rgb, stride, x, y - m_firstRow, width, height);
+    }
+    void blitMasked(const uint8_t* rgb, int stride, const uint8_t* mask, int mask_stride, int x, int y, int width, int height) override {
+        m_band.blitMasked(rgb, stride, mask, mask_stride, x, y - m_firstRow, width, height);
+    }
+    void setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) override {
+        m_band.setPixelRGBA(x, y - m_firstRow, red, green, blue, alpha);
+    }
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override {
+        m_band.blendBlit(rgba, stride, x, y - m_firstRow, width, height);
+    }
+    void drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue) override {
+        drawLineRows(x1, y1, x2, y2, m_firstRow, m_firstRow + m_band.height() - 1, red, green, blue);
+    }
+    void drawPolygon(const std::vector<std::pair<int, int>>& points, uint8_t red, uint8_t green, uint8_t blue, bool fill) override {
+        if(points.size() < 2) {
+            return;
+        }
+        for(size_t i = 0; i < points.size(); ++i) {
+            const auto& from = points[i];
+            const auto& to = points[(i + 1) % points.size()];
+            drawLine(from.first, from.second, to.first, to.second, red, green, blue);
+        }
+        if(fill) {
+            // Only step the edges through the rows of this band.
+            thread_local PolygonRasterizer rasterizer;
+            rasterizer.fill(points, m_firstRow, m_firstRow + m_band.height() - 1, [&](int x0, int x1, int y) {
+                m_band.drawSpan(x0, x1, y - m_firstRow, red, green, blue);
+            });
+        }
+    }
+
+private:
+    MemoryCanvas& m_band;
+    int m_firstRow;
+    int m_fullHeight;
+};
+
+} // namespace
+
+BandedRenderer::BandedRenderer(std::size_t threads)
+    : m_pool(threads)
+{
+}
+
+std::size_t BandedRenderer::threads() const
+{
+    return m_pool.size();
+}
+
+void BandedRenderer::render(const DisplayList &list, MemoryCanvas &target)
+{
+    const int height = target.height();
+    if(height == 0) {
+        return;
+    }
+    const int wanted_bands = static_cast<int>(m_pool.size()) * BANDS_PER_THREAD;
+    const int band_height = std::max(MIN_BAND_HEIGHT, (height + wanted_bands - 1) / wanted_bands);
+    const int bands = (height + band_height - 1) / band_height;
+    m_pool.parallelFor(bands, [&](std::size_t band) {
+        const int first_row = static_cast<int>(band) * band_height;
+        MemoryCanvas rows = target.rows(first_row, std::min(band_height, height - first_row));
+        BandCanvas canvas(rows, first_row, height);
+        list.replay(canvas, first_row, first_row + rows.height() - 1);
+    });
+}
+
+} // namespace
@@ -0,0 +1,227 @@
+#include <protogen/presentation/CompositorRenderSurface.h>
+#include <protogen/presentation/DirtyTrackingCanvas.h>
+
+#include <algorithm>
+
+namespace protogen {
+
+namespace {
+
+/**
+ * A canvas which draws into `rect` of `canvas`, without a copy.
+ */
+MemoryCanvas viewOf(MemoryCanvas& canvas, const Rect& rect) {
+    return MemoryCanvas(canvas.row(rect.y) + rect.x, rect.width, rect.height, canvas.stride());
+}
+
+} // namespace
+
+CompositorRenderSurface::Layer::Layer(Level level, std::function<void(ICanvas&)> drawer, Resolution resolution)
+    : m_level(level),
+    m_drawerMutex(),
+    m_drawer(std::move(drawer)),
+    m_dirty(true),
+    m_changed(true),
+    m_visible(true),
+    m_canvas(resolution),
+    m_drawn()
+{
+    m_canvas.clear();
+}
+
+CompositorRenderSurface::Level CompositorRenderSurface::Layer::level() const
+{
+    return m_level;
+}
+
+void CompositorRenderSurface::Layer::setDrawer(std::function<void(ICanvas&)> drawer)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_drawerMutex);
+        m_drawer = std::move(drawer);
+    }
+    invalidate();
+}
+
+void CompositorRenderSurface::Layer::invalidate()
+{
+    m_dirty = true;
+    m_changed = true;
+}
+
+void CompositorRenderSurface::Layer::setVisible(bool visible)
+{
+    if(m_visible.exchange(visible) != visible) {
+        m_changed = true;
+    }
+}
+
+bool CompositorRenderSurface::Layer::visible() const
+{
+    return m_visible;
+}
+
+CompositorRenderSurface::CompositorRenderSurface(std::shared_ptr<IRenderSurface> surface)
+    : m_surface(surface),
+    m_resolution(surface->resolution()),
+    m_mutex(),
+    m_layers(),
+    m_layersChanged(false),
+    m_app(m_resolution),
+    m_appDrawn(),
+    m_hasAppFrame(false),
+    m_frame(m_resolution)
+{
+    m_app.fill(0, 0, 0);
+}
+
+IRenderSurface::Initialization CompositorRenderSurface::initialize()
+{
+    return Initialization::Success;
+}
+
+void CompositorRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    // Held while the wrapped surface draws too, so app frames and refreshes
+    // never reach it at once.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_layers.empty()) {
+        // Nothing to draw over the app; keep the wrapped surface's own
+        // optimizations, such as only updating what changed.
+        m_hasAppFrame = false;
+        m_surface->drawFrame(drawer);
+        return;
+    }
+
+    // Every frame starts black, and only what the previous frame drew can
+    // be anything else.
+    for(const auto& rect : m_appDrawn.rects()) {
+        m_app.fillRegion(rect.x, rect.y, rect.width, rect.height, 0, 0, 0);
+    }
+    DirtyTrackingCanvas canvas(m_app, true);
+    drawer(canvas);
+    m_appDrawn = canvas.dirtyRegion();
+    m_hasAppFrame = true;
+    compose();
+}
+
+void CompositorRenderSurface::refresh()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_hasAppFrame) {
+        return;
+    }
+    const bool changed = m_layersChanged || std::any_of(m_layers.begin(), m_layers.end(), [](const auto& layer){
+        return layer->m_changed.load();
+    });
+    if(changed) {
+        compose();
+    }
+}
+
+void CompositorRenderSurface::compose()
+{
+    DirtyRegion drawn = m_appDrawn;
+    for(const auto& layer : m_layers) {
+        layer->m_changed = false;
+        if(!layer->m_visible) {
+            continue;
+        }
+        if(layer->m_dirty.exchange(false)) {
+            // Only what the layer drew before is not transparent.
+            for(const auto& rect : layer->m_drawn.rects()) {
+                viewOf(layer->m_canvas, rect).clear();
+            }
+            std::function<void(ICanvas&)> layer_drawer;
+            {
+                std::lock_guard<std::mutex> drawer_lock(layer->m_drawerMutex);
+                layer_drawer = layer->m_drawer;
+            }
+            DirtyTrackingCanvas canvas(layer->m_canvas);
+            if(layer_drawer) {
+                layer_drawer(canvas);
+            }
+            layer->m_drawn = canvas.dirtyRegion();
+        }
+        drawn.add(layer->m_drawn);
+    }
+    m_layersChanged = false;
+
+    // Everything outside of `drawn` is black, so it is left to the wrapped
+    // surface, which starts every frame black.
+    for(const auto& rect : drawn.rects()) {
+        viewOf(m_frame, rect).copyFrom(viewOf(m_app, rect));
+        for(const auto& layer : m_layers) {
+            if(!layer->m_visible) {
+                continue;
+            }
+            for(const auto& layer_rect : layer->m_drawn.rects()) {
+                const Rect overlap = rect.intersected(layer_rect);
+                if(!overlap.empty()) {
+                    m_frame.compositeFrom(viewOf(layer->m_canvas, overlap), overlap.x, overlap.y);
+                }
+            }
+        }
+    }
+    m_surface->drawFrame([this, &drawn](ICanvas& canvas){
+        for(const auto& rect : drawn.rects()) {
+            m_frame.copyTo(canvas, rect);
+        }
+    });
+}
+
+std::shared_ptr<CompositorRenderSurface::Layer> CompositorRenderSurface::addLayer(Level level, std::function<void(ICanvas&)> drawer)
+{
+    auto layer = std::shared_ptr<Layer>(new Layer(level, std::move(drawer), m_resolution));
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // After every layer of the same or a lower level.
+    const auto position = std::find_if(m_layers.begin(), m_layers.end(), [level](const auto& other){
+        return other->level() > level;
+    });
+    m_layers.insert(position, layer);
+    m_layersChanged = true;
+    return layer;
+}
+
+void CompositorRenderSurface::removeLayer(const std::shared_ptr<Layer> &layer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = std::find(m_layers.begin(), m_layers.end(), layer);
+    if(found == m_layers.end()) {
+        return;
+    }
+    m_layers.erase(found);
+    m_layersChanged = true;
+}
+
+Resolution CompositorRenderSurface::resolution() const
+{
+    return m_resolution;
+}
+
+std::optional<std::string> CompositorRenderSurface::getAttribute(const std::string &key) const
+{
+    return m_surface->getAttribute(key);
+}
+
+std::vector<std::string> CompositorRenderSurface::listAttributes() const
+{
+    return m_surface->listAttributes();
+}
+
+attributes::IWritableAttributeStore::SetAttributeResult CompositorRenderSurface::setAttribute(const std::string &key, const std::string &value)
+{
+    return m_surface->setAttribute(key, value);
+}
+
+attributes::IWritableAttributeStore::RemoveAttributeResult CompositorRenderSurface::removeAttribute(const std::string &key)
+{
+    return m_surface->removeAttribute(key);
+}
+
+bool CompositorRenderSurface::hasAttribute(const std::string &key) const
+{
+    return m_surface->hasAttribute(key);
+}
+
+} // namespace
@@ -0,0 +1,165 @@
+#include <protogen/presentation/CountingCanvas.h>
+#include <protogen/presentation/Rect.h>
+
+namespace protogen {
+
+DrawCounts& DrawCounts::operator+=(const DrawCounts& other)
+{
+    for(std::size_t i = 0; i < calls.size(); ++i) {
+        calls[i] += other.calls[i];
+    }
+    pixels += other.pixels;
+    spans += other.spans;
+    return *this;
+}
+
+uint64_t DrawCounts::totalCalls() const
+{
+    uint64_t total = 0;
+    for(const uint64_t count : calls) {
+        total += count;
+    }
+    return total;
+}
+
+const char * DrawCounts::name(Primitive primitive)
+{
+    switch(primitive) {
+    case SetPixel: return "setPixel";
+    case Clear: return "clear";
+    case Fill: return "fill";
+    case FillRegion: return "fillRegion";
+    case DrawSpan: return "drawSpan";
+    case Blit: return "blit";
+    case BlitMasked: return "blitMasked";
+    case SetPixelRGBA: return "setPixelRGBA";
+    case BlendBlit: return "blendBlit";
+    case DrawLine: return "drawLine";
+    case DrawPolygon: return "drawPolygon";
+    case DrawEllipse: return "drawEllipse";
+    case PRIMITIVE_COUNT: break;
+    }
+    return "unknown";
+}
+
+CountingCanvas::CountingCanvas(ICanvas& target, DrawCounts& counts)
+    : m_target(target),
+    m_counts(counts),
+    m_shapeDepth(0)
+{
+}
+
+int CountingCanvas::width() const
+{
+    return m_target.width();
+}
+
+int CountingCanvas::height() const
+{
+    return m_target.height();
+}
+
+void CountingCanvas::countCall(DrawCounts::Primitive primitive)
+{
+    if(m_shapeDepth == 0) {
+        ++m_counts.calls[primitive];
+    }
+}
+
+void CountingCanvas::countArea(int x, int y, int width, int height)
+{
+    m_counts.pixels += Rect{x, y, width, height}.intersected(Rect{0, 0, this->width(), this->height()}).area();
+}
+
+void CountingCanvas::setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    countCall(DrawCounts::SetPixel);
+    countArea(x, y, 1, 1);
+    m_target.setPixel(x, y, red, green, blue);
+}
+
+void CountingCanvas::clear()
+{
+    countCall(DrawCounts::Clear);
+    countArea(0, 0, width(), height());
+    m_target.clear();
+}
+
+void CountingCanvas::fill(uint8_t red, uint8_t green, uint8_t blue)
+{
+    countCall(DrawCounts::Fill);
+    countArea(0, 0, width(), height());
+    m_target.fill(red, green, blue);
+}
+
+void CountingCanvas::fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue)
+{
+    countCall(DrawCounts::FillRegion);
+    countArea(x, y, width, height);
+    m_target.fillRegion(x, y, width, height, red, green, blue);
+}
+
+void CountingCanvas::drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    countCall(DrawCounts::DrawSpan);
+    const auto span = clipSpan(x0, x1, y);
+    if(span.has_value()) {
+        ++m_counts.spans;
+        m_counts.pixels += span->second - span->first + 1;
+    }
+    m_target.drawSpan(x0, x1, y, red, green, blue);
+}
+
+void CountingCanvas::blit(const uint8_t *rgb, int stride, int x, int y, int width, int height)
+{
+    countCall(DrawCounts::Blit);
+    countArea(x, y, width, height);
+    m_target.blit(rgb, stride, x, y, width, height);
+}
+
+void CountingCanvas::blitMasked(const uint8_t *rgb, int stride, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    countCall(DrawCounts::BlitMasked);
+    countArea(x, y, width, height);
+    m_target.blitMasked(rgb, stride, mask, mask_stride, x, y, width, height);
+}
+
+void CountingCanvas::setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    countCall(DrawCounts::SetPixelRGBA);
+    countArea(x, y, 1, 1);
+    m_target.setPixelRGBA(x, y, red, green, blue, alpha);
+}
+
+void CountingCanvas::blendBlit(const uint8_t *rgba, int stride, int x, int y, int width, int height)
+{
+    countCall(DrawCounts::BlendBlit);
+    countArea(x, y, width, height);
+    m_target.blendBlit(rgba, stride, x, y, width, height);
+}
+
+void CountingCanvas::drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue)
+{
+    countCall(DrawCounts::DrawLine);
+    ++m_shapeDepth;
+    ICanvas::drawLine(x1, y1, x2, y2, red, green, blue);
+    --m_shapeDepth;
+}
+
+void CountingCanvas::drawPolygon(const std::vector<std::pair<int, int>> &points, uint8_t red, uint8_t green, uint8_t blue, bool fill)
+{
+    countCall(DrawCounts::DrawPolygon);
+    ++m_shapeDepth;
+    ICanvas::drawPolygon(points, red, green, blue, fill);
+    --m_shapeDepth;
+}
+
+void CountingCanvas::drawEllipse(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue, bool fill)
+{
+    countCall(DrawCounts::DrawEllipse);
+    ++m_shapeDepth;
+    ICanvas::drawEllipse(x, y, width, height, red, green, blue, fill);
+    --m_shapeDepth;
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+#include <protogen/presentation/DirtyRegion.h>
+
+namespace protogen {
+
+DirtyRegion::DirtyRegion()
+    : m_rects()
+{
+    m_rects.reserve(MAX_RECTS + 1);
+}
+
+void DirtyRegion::add(Rect rect)
+{
+    if(rect.empty()) {
+        return;
+    }
+    for(const auto& existing : m_rects) {
+        if(existing.contains(rect)) {
+            return;
+        }
+    }
+    // Absorb every rectangle the new one touches. Growing the rectangle can
+    // make it touch others, so repeat until nothing changes.
+    bool merged = true;
+    while(merged) {
+        merged = false;
+        for(auto it = m_rects.begin(); it != m_rects.end(); ++it) {
+            if(it->touches(rect)) {
+                rect = rect.united(*it);
+                m_rects.erase(it);
+                merged = true;
+                break;
+            }
+        }
+    }
+    m_rects.push_back(rect);
+    if(m_rects.size() > MAX_RECTS) {
+        const Rect all = bounds();
+        m_rects.clear();
+        m_rects.push_back(all);
+    }
+}
+
+void DirtyRegion::add(const DirtyRegion &other)
+{
+    for(const auto& rect : other.m_rects) {
+        add(rect);
+    }
+}
+
+void DirtyRegion::clear()
+{
+    m_rects.clear();
+}
+
+bool DirtyRegion::empty() const
+{
+    return m_rects.empty();
+}
+
+const std::vector<Rect> &DirtyRegion::rects() const
+{
+    return m_rects;
+}
+
+int DirtyRegion::area() const
+{
+    int area = 0;
+    for(const auto& rect : m_rects) {
+        area += rect.area();
+    }
+    return area;
+}
+
+Rect DirtyRegion::bounds() const
+{
+    if(m_rects.empty()) {
+        return {0, 0, 0, 0};
+    }
+    Rect bounds = m_rects.front();
+    for(const auto& rect : m_rects) {
+        bounds = bounds.united(rect);
+    }
+    return bounds;
+}
+
+} // namespace
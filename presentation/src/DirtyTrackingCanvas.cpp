@@ -0,0 +1,134 @@
+#include <protogen/presentation/DirtyTrackingCanvas.h>
+
+#include <algorithm>
+
+using namespace protogen;
+
+DirtyTrackingCanvas::DirtyTrackingCanvas(ICanvas &target_canvas, bool target_is_clear)
+    : m_targetCanvas(target_canvas), m_dirtyRegion(), m_targetWasClear(target_is_clear)
+{
+}
+
+const DirtyRegion &DirtyTrackingCanvas::dirtyRegion() const
+{
+    return m_dirtyRegion;
+}
+
+void DirtyTrackingCanvas::resetDirtyRegion()
+{
+    m_dirtyRegion.clear();
+    m_targetWasClear = false;
+}
+
+int DirtyTrackingCanvas::width() const
+{
+    return m_targetCanvas.width();
+}
+
+int DirtyTrackingCanvas::height() const
+{
+    return m_targetCanvas.height();
+}
+
+void DirtyTrackingCanvas::setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    markDirty(x, y, 1, 1);
+    m_targetCanvas.setPixel(x, y, red, green, blue);
+}
+
+void DirtyTrackingCanvas::clear()
+{
+    if(!m_targetWasClear) {
+        markDirty(0, 0, width(), height());
+        m_targetCanvas.clear();
+        return;
+    }
+    // Only what was drawn since tracking started can be non-black.
+    for(const auto& rect : m_dirtyRegion.rects()) {
+        m_targetCanvas.fillRegion(rect.x, rect.y, rect.width, rect.height, 0, 0, 0);
+    }
+}
+
+void DirtyTrackingCanvas::fill(uint8_t red, uint8_t green, uint8_t blue)
+{
+    markDirty(0, 0, width(), height());
+    m_targetCanvas.fill(red, green, blue);
+}
+
+void DirtyTrackingCanvas::fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue)
+{
+    markDirty(x, y, width, height);
+    m_targetCanvas.fillRegion(x, y, width, height, red, green, blue);
+}
+
+void DirtyTrackingCanvas::drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    markDirty(std::min(x0, x1), y, std::max(x0, x1) - std::min(x0, x1) + 1, 1);
+    m_targetCanvas.drawSpan(x0, x1, y, red, green, blue);
+}
+
+void DirtyTrackingCanvas::blit(const uint8_t *rgb, int stride, int x, int y, int width, int height)
+{
+    markDirty(x, y, width, height);
+    m_targetCanvas.blit(rgb, stride, x, y, width, height);
+}
+
+void DirtyTrackingCanvas::blitMasked(const uint8_t *rgb, int stride, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    markDirty(x, y, width, height);
+    m_targetCanvas.blitMasked(rgb, stride, mask, mask_stride, x, y, width, height);
+}
+
+void DirtyTrackingCanvas::setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    if(alpha == 0) {
+        return;
+    }
+    markDirty(x, y, 1, 1);
+    m_targetCanvas.setPixelRGBA(x, y, red, green, blue, alpha);
+}
+
+void DirtyTrackingCanvas::blendBlit(const uint8_t *rgba, int stride, int x, int y, int width, int height)
+{
+    markDirty(x, y, width, height);
+    m_targetCanvas.blendBlit(rgba, stride, x, y, width, height);
+}
+
+void DirtyTrackingCanvas::drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const int left = std::min(x1, x2);
+    const int top = std::min(y1, y2);
+    markDirty(left, top, std::max(x1, x2) - left + 1, std::max(y1, y2) - top + 1);
+    m_targetCanvas.drawLine(x1, y1, x2, y2, red, green, blue);
+}
+
+void DirtyTrackingCanvas::drawPolygon(const std::vector<std::pair<int, int>> &points, uint8_t red, uint8_t green, uint8_t blue, bool fill)
+{
+    if(points.size() < 2) {
+        return;
+    }
+    int left = points.front().first;
+    int right = left;
+    int top = points.front().second;
+    int bottom = top;
+    for(const auto& [x, y] : points) {
+        left = std::min(left, x);
+        right = std::max(right, x);
+        top = std::min(top, y);
+        bottom = std::max(bottom, y);
+    }
+    markDirty(left, top, right - left + 1, bottom - top + 1);
+    m_targetCanvas.drawPolygon(points, red, green, blue, fill);
+}
+
+void DirtyTrackingCanvas::drawEllipse(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue, bool fill)
+{
+    // The outline reaches one pixel past width and height for even sizes.
+    markDirty(x, y, width + 1, height + 1);
+    m_targetCanvas.drawEllipse(x, y, width, height, red, green, blue, fill);
+}
+
+void DirtyTrackingCanvas::markDirty(int x, int y, int width, int height)
+{
+    m_dirtyRegion.add(Rect{x, y, width, height}.intersected(Rect{0, 0, this->width(), this->height()}));
+}
@@ -0,0 +1,222 @@
+#include <protogen/presentation/DisplayList.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace protogen {
+
+namespace {
+
+template<typename T>
+T read(const uint8_t * bytes) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/**
+ * First and last row a command can touch, both inclusive. Commands which
+ * cover the whole canvas return the widest range.
+ */
+std::pair<int, int> rowsOf(DisplayList::Op op, const uint8_t * arguments) {
+    constexpr int MIN = std::numeric_limits<int>::min();
+    constexpr int MAX = std::numeric_limits<int>::max();
+    switch(op) {
+    case DisplayList::Op::SetPixel:
+    case DisplayList::Op::SetPixelRGBA: {
+        const auto a = read<DisplayList::PixelArguments>(arguments);
+        return {a.y, a.y};
+    }
+    case DisplayList::Op::FillRegion:
+    case DisplayList::Op::Blit:
+    case DisplayList::Op::BlitMasked:
+    case DisplayList::Op::BlendBlit: {
+        const auto a = read<DisplayList::RegionArguments>(arguments);
+        return {a.y, a.y + a.height - 1};
+    }
+    case DisplayList::Op::DrawEllipse: {
+        // The outline can reach one row past the height.
+        const auto a = read<DisplayList::RegionArguments>(arguments);
+        return {a.y, a.y + a.height};
+    }
+    case DisplayList::Op::DrawSpan:
+    case DisplayList::Op::DrawLine: {
+        const auto a = read<DisplayList::LineArguments>(arguments);
+        return {std::min(a.y1, a.y2), std::max(a.y1, a.y2)};
+    }
+    case DisplayList::Op::DrawPolygon: {
+        const auto a = read<DisplayList::PolygonArguments>(arguments);
+        const uint8_t * coordinates = arguments + sizeof(DisplayList::PolygonArguments);
+        int top = MAX;
+        int bottom = MIN;
+        for(uint32_t i = 0; i < a.count; ++i) {
+            const auto y = read<int32_t>(coordinates + i * 8 + 4);
+            top = std::min(top, y);
+            bottom = std::max(bottom, y);
+        }
+        return {top, bottom};
+    }
+    case DisplayList::Op::Clear:
+    case DisplayList::Op::Fill:
+        break;
+    }
+    return {MIN, MAX};
+}
+
+} // namespace
+
+DisplayList::DisplayList()
+    : m_arena(), m_used(0), m_commands(0)
+{
+}
+
+DisplayList::DisplayList(DisplayList &&other) noexcept
+    : m_arena(std::move(other.m_arena)),
+    m_used(std::exchange(other.m_used, 0)),
+    m_commands(std::exchange(other.m_commands, 0))
+{
+}
+
+DisplayList &DisplayList::operator=(DisplayList &&other) noexcept
+{
+    m_arena = std::move(other.m_arena);
+    m_used = std::exchange(other.m_used, 0);
+    m_commands = std::exchange(other.m_commands, 0);
+    return *this;
+}
+
+void DisplayList::clear()
+{
+    m_used = 0;
+    m_commands = 0;
+}
+
+bool DisplayList::empty() const
+{
+    return m_commands == 0;
+}
+
+std::size_t DisplayList::size() const
+{
+    return m_commands;
+}
+
+std::size_t DisplayList::bytes() const
+{
+    return m_used;
+}
+
+uint8_t *DisplayList::append(Op op, const void *arguments, std::size_t arguments_size, std::size_t data_size)
+{
+    const std::size_t command_size = sizeof(Header) + arguments_size + data_size;
+    if(m_used + command_size > m_arena.size()) {
+        // Grow geometrically so the arena settles after a few frames.
+        m_arena.resize(std::max(m_arena.size() * 2, m_used + command_size));
+    }
+    uint8_t * command = m_arena.data() + m_used;
+    const Header header{op, static_cast<uint32_t>(command_size)};
+    std::memcpy(command, &header, sizeof(Header));
+    if(arguments_size > 0) {
+        std::memcpy(command + sizeof(Header), arguments, arguments_size);
+    }
+    m_used += command_size;
+    ++m_commands;
+    return command + sizeof(Header) + arguments_size;
+}
+
+void DisplayList::replay(ICanvas &target) const
+{
+    replay(target, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+}
+
+void DisplayList::replay(ICanvas &target, int first_row, int last_row) const
+{
+    const uint8_t * command = m_arena.data();
+    const uint8_t * const end = m_arena.data() + m_used;
+    while(command < end) {
+        const auto header = read<Header>(command);
+        const uint8_t * arguments = command + sizeof(Header);
+        if(first_row != std::numeric_limits<int>::min() || last_row != std::numeric_limits<int>::max()) {
+            const auto [top, bottom] = rowsOf(header.op, arguments);
+            if(bottom < first_row || top > last_row) {
+                command += header.size;
+                continue;
+            }
+        }
+        switch(header.op) {
+        case Op::SetPixel: {
+            const auto a = read<PixelArguments>(arguments);
+            target.setPixel(a.x, a.y, a.red, a.green, a.blue);
+            break;
+        }
+        case Op::Clear:
+            target.clear();
+            break;
+        case Op::Fill: {
+            const auto a = read<ColorArguments>(arguments);
+            target.fill(a.red, a.green, a.blue);
+            break;
+        }
+        case Op::FillRegion: {
+            const auto a = read<RegionArguments>(arguments);
+            target.fillRegion(a.x, a.y, a.width, a.height, a.red, a.green, a.blue);
+            break;
+        }
+        case Op::DrawSpan: {
+            const auto a = read<LineArguments>(arguments);
+            target.drawSpan(a.x1, a.x2, a.y1, a.red, a.green, a.blue);
+            break;
+        }
+        case Op::Blit: {
+            const auto a = read<RegionArguments>(arguments);
+            target.blit(arguments + sizeof(RegionArguments), a.width * 3, a.x, a.y, a.width, a.height);
+            break;
+        }
+        case Op::BlitMasked: {
+            const auto a = read<RegionArguments>(arguments);
+            const uint8_t * rgb = arguments + sizeof(RegionArguments);
+            const uint8_t * mask = rgb + static_cast<std::size_t>(a.width) * a.height * 3;
+            target.blitMasked(rgb, a.width * 3, mask, a.width, a.x, a.y, a.width, a.height);
+            break;
+        }
+        case Op::SetPixelRGBA: {
+            const auto a = read<PixelArguments>(arguments);
+            target.setPixelRGBA(a.x, a.y, a.red, a.green, a.blue, a.alpha);
+            break;
+        }
+        case Op::BlendBlit: {
+            const auto a = read<RegionArguments>(arguments);
+            target.blendBlit(arguments + sizeof(RegionArguments), a.width * 4, a.x, a.y, a.width, a.height);
+            break;
+        }
+        case Op::DrawLine: {
+            const auto a = read<LineArguments>(arguments);
+            target.drawLine(a.x1, a.y1, a.x2, a.y2, a.red, a.green, a.blue);
+            break;
+        }
+        case Op::DrawPolygon: {
+            const auto a = read<PolygonArguments>(arguments);
+            const uint8_t * coordinates = arguments + sizeof(PolygonArguments);
+            // Reused across replays on the same thread, like the rasterizer's
+            // edge table.
+            thread_local std::vector<std::pair<int, int>> points;
+            points.resize(a.count);
+            for(uint32_t i = 0; i < a.count; ++i) {
+                points[i] = {read<int32_t>(coordinates + i * 8), read<int32_t>(coordinates + i * 8 + 4)};
+            }
+            target.drawPolygon(points, a.red, a.green, a.blue, a.fill);
+            break;
+        }
+        case Op::DrawEllipse: {
+            const auto a = read<RegionArguments>(arguments);
+            target.drawEllipse(a.x, a.y, a.width, a.height, a.red, a.green, a.blue, a.fill);
+            break;
+        }
+        }
+        command += header.size;
+    }
+}
+
+} // namespace
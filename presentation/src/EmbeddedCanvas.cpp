@@ -29,25 +29,112 @@ int EmbeddedCanvas::height() const
 
 void EmbeddedCanvas::setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue)
 {
-    const Point new_point = translate(x, y);
-    if(m_clipToWindow) {
-        if(inBounds(new_point.x, new_point.y)) {
-            m_targetCanvas.setPixel(new_point.x, new_point.y, red, green, blue);
-        }
-    } else {
-        m_targetCanvas.setPixel(new_point.x, new_point.y, red, green, blue);
+    if(m_clipToWindow && !inBounds(x, y)) {
+        return;
     }
-    
+    const Point new_point = translate(x, y);
+    m_targetCanvas.setPixel(new_point.x, new_point.y, red, green, blue);
 }
 
 void EmbeddedCanvas::clear()
 {
-    m_targetCanvas.clear();
+    // Only the window belongs to this canvas, whether or not drawing is
+    // clipped to it.
+    m_targetCanvas.fillRegion(m_window.top_left_x, m_window.top_left_y, width(), height(), 0, 0, 0);
 }
 
 void EmbeddedCanvas::fill(uint8_t red, uint8_t green, uint8_t blue)
 {
-    m_targetCanvas.fill(red, green, blue);
+    m_targetCanvas.fillRegion(m_window.top_left_x, m_window.top_left_y, width(), height(), red, green, blue);
+}
+
+void EmbeddedCanvas::fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if(!m_clipToWindow) {
+        const Point new_point = translate(x, y);
+        m_targetCanvas.fillRegion(new_point.x, new_point.y, width, height, red, green, blue);
+        return;
+    }
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const Point new_point = translate(clip->dst_x, clip->dst_y);
+    m_targetCanvas.fillRegion(new_point.x, new_point.y, clip->width, clip->height, red, green, blue);
+}
+
+void EmbeddedCanvas::drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if(!m_clipToWindow) {
+        const Point new_point = translate(x0, y);
+        m_targetCanvas.drawSpan(new_point.x, x1 + m_window.top_left_x, new_point.y, red, green, blue);
+        return;
+    }
+    const auto span = clipSpan(x0, x1, y);
+    if(!span.has_value()) {
+        return;
+    }
+    const Point new_point = translate(span->first, y);
+    m_targetCanvas.drawSpan(new_point.x, new_point.x + span->second - span->first, new_point.y, red, green, blue);
+}
+
+void EmbeddedCanvas::blit(const uint8_t *rgb, int stride, int x, int y, int width, int height)
+{
+    if(!m_clipToWindow) {
+        const Point new_point = translate(x, y);
+        m_targetCanvas.blit(rgb, stride, new_point.x, new_point.y, width, height);
+        return;
+    }
+    // Clip the whole block to the window once, then hand it to the target.
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const Point new_point = translate(clip->dst_x, clip->dst_y);
+    const uint8_t * first_pixel = rgb + clip->src_y * stride + clip->src_x * 3;
+    m_targetCanvas.blit(first_pixel, stride, new_point.x, new_point.y, clip->width, clip->height);
+}
+
+void EmbeddedCanvas::blitMasked(const uint8_t *rgb, int stride, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    if(!m_clipToWindow) {
+        const Point new_point = translate(x, y);
+        m_targetCanvas.blitMasked(rgb, stride, mask, mask_stride, new_point.x, new_point.y, width, height);
+        return;
+    }
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const Point new_point = translate(clip->dst_x, clip->dst_y);
+    const uint8_t * first_pixel = rgb + clip->src_y * stride + clip->src_x * 3;
+    const uint8_t * first_mask = mask + clip->src_y * mask_stride + clip->src_x;
+    m_targetCanvas.blitMasked(first_pixel, stride, first_mask, mask_stride, new_point.x, new_point.y, clip->width, clip->height);
+}
+
+void EmbeddedCanvas::setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    if(m_clipToWindow && !inBounds(x, y)) {
+        return;
+    }
+    const Point new_point = translate(x, y);
+    m_targetCanvas.setPixelRGBA(new_point.x, new_point.y, red, green, blue, alpha);
+}
+
+void EmbeddedCanvas::blendBlit(const uint8_t *rgba, int stride, int x, int y, int width, int height)
+{
+    if(!m_clipToWindow) {
+        const Point new_point = translate(x, y);
+        m_targetCanvas.blendBlit(rgba, stride, new_point.x, new_point.y, width, height);
+        return;
+    }
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const Point new_point = translate(clip->dst_x, clip->dst_y);
+    const uint8_t * first_pixel = rgba + clip->src_y * stride + clip->src_x * 4;
+    m_targetCanvas.blendBlit(first_pixel, stride, new_point.x, new_point.y, clip->width, clip->height);
 }
 
 EmbeddedCanvas::Point EmbeddedCanvas::translate(int x, int y) const
@@ -58,5 +145,6 @@ EmbeddedCanvas::Point EmbeddedCanvas::translate(int x, int y) const
 
 bool EmbeddedCanvas::inBounds(int x, int y) const
 {
+    // (x, y) is in embedded canvas coordinates.
     return (x >= 0 && x < width() && y >= 0 && y < height());
 }
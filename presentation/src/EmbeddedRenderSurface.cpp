@@ -39,7 +39,7 @@ void EmbeddedRenderSurface::drawFrame(const std::function<void(ICanvas &)> &draw
         // canvas is of the source display
         // drawer expects the embedded resolution sized canvas though.
         EmbeddedCanvas embedded_canvas(canvas, m_window);
-        drawer(canvas);
+        drawer(embedded_canvas);
     });
 }
 
@@ -0,0 +1,118 @@
+#include <protogen/presentation/FanOutRenderSurface.h>
+#include <protogen/presentation/DirtyTrackingCanvas.h>
+
+#include <protogen/StandardAttributeStore.hpp>
+#include <protogen/StandardAttributes.hpp>
+
+#include <algorithm>
+
+namespace protogen {
+
+FanOutRenderSurface::FanOutRenderSurface(std::vector<Output> outputs, Resolution resolution)
+    : m_resolution(resolution),
+    m_frame(resolution),
+    m_drawnLastFrame(),
+    m_targets(),
+    m_pool(std::max<std::size_t>(outputs.size(), 1)),
+    m_attributes(new StandardAttributeStore())
+{
+    for(auto& output : outputs) {
+        Target target;
+        target.width = static_cast<int>(output.surface->resolution().width());
+        target.height = static_cast<int>(output.surface->resolution().height());
+        target.frame = std::make_unique<MemoryCanvas>(m_frame.data(), m_frame.width(), m_frame.height(), m_frame.stride());
+        const bool same_size = target.width == m_frame.width() && target.height == m_frame.height();
+        if(output.fit == Fit::Scale && !same_size) {
+            target.scaled = std::make_unique<MemoryCanvas>(target.width, target.height);
+            target.scaler = std::make_unique<ImageScaler>(m_frame.width(), m_frame.height(), target.width, target.height, ImageScaler::Filter::Nearest);
+        }
+        target.output = std::move(output);
+        m_targets.push_back(std::move(target));
+    }
+
+    m_attributes->setAttribute(attributes::A_ID, "fan_out");
+    m_attributes->setAttribute(attributes::A_NAME, "Fan-out");
+    m_attributes->setAttribute(attributes::A_DESCRIPTION, "Shows the same imagery on several render surfaces at once.");
+}
+
+IRenderSurface::Initialization FanOutRenderSurface::initialize()
+{
+    return m_targets.empty() ? Initialization::Failure : Initialization::Success;
+}
+
+void FanOutRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    // Every frame starts black, and only what the previous frame touched
+    // can be anything else.
+    for(const auto& rect : m_drawnLastFrame.rects()) {
+        m_frame.fillRegion(rect.x, rect.y, rect.width, rect.height, 0, 0, 0);
+    }
+    DirtyTrackingCanvas canvas(m_frame, true);
+    drawer(canvas);
+
+    DirtyRegion changed = m_drawnLastFrame;
+    changed.add(canvas.dirtyRegion());
+    m_drawnLastFrame = canvas.dirtyRegion();
+
+    m_pool.parallelFor(m_targets.size(), [this, &changed](std::size_t i){
+        present(m_targets[i], changed);
+    });
+    m_attributes->setAttribute(attributes::A_DIRTY_AREA, std::to_string(changed.area()));
+}
+
+void FanOutRenderSurface::present(Target &target, const DirtyRegion &changed)
+{
+    if(target.scaled) {
+        target.scaler->scale(m_frame, *target.scaled);
+        target.output.surface->drawFrame([&target](ICanvas& canvas){
+            target.scaled->copyTo(canvas);
+        });
+        return;
+    }
+    if(target.width == m_frame.width() && target.height == m_frame.height()) {
+        // Outputs erase what they were given in the previous frame, which
+        // was the previous changed region, so passing on what changed is
+        // enough.
+        target.output.surface->drawFrame([&target, &changed](ICanvas& canvas){
+            for(const auto& rect : changed.rects()) {
+                target.frame->copyTo(canvas, rect);
+            }
+        });
+        return;
+    }
+    target.output.surface->drawFrame([this, &target](ICanvas& canvas){
+        target.frame->copyTo(canvas, (target.width - m_frame.width()) / 2, (target.height - m_frame.height()) / 2);
+    });
+}
+
+Resolution FanOutRenderSurface::resolution() const
+{
+    return m_resolution;
+}
+
+std::optional<std::string> FanOutRenderSurface::getAttribute(const std::string &key) const
+{
+    return m_attributes->getAttribute(key);
+}
+
+std::vector<std::string> FanOutRenderSurface::listAttributes() const
+{
+    return m_attributes->listAttributes();
+}
+
+attributes::IWritableAttributeStore::SetAttributeResult FanOutRenderSurface::setAttribute(const std::string &key, const std::string &value)
+{
+    return m_attributes->setAttribute(key, value);
+}
+
+attributes::IWritableAttributeStore::RemoveAttributeResult FanOutRenderSurface::removeAttribute(const std::string &key)
+{
+    return m_attributes->removeAttribute(key);
+}
+
+bool FanOutRenderSurface::hasAttribute(const std::string &key) const
+{
+    return m_attributes->hasAttribute(key);
+}
+
+} // namespace
@@ -0,0 +1,179 @@
+#include <protogen/presentation/FrameMetrics.h>
+
+#include <iomanip>
+#include <sstream>
+
+namespace protogen {
+
+namespace {
+
+void appendJsonString(std::ostringstream& out, const std::string& value) {
+    out << '"';
+    for(const char c : value) {
+        switch(c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+void appendHistogram(std::ostringstream& out, const Histogram::Snapshot& histogram) {
+    const auto micros = [](double nanoseconds) {
+        return nanoseconds / 1000.0;
+    };
+    out << "{\"count\": " << histogram.count
+        << ", \"mean\": " << micros(histogram.mean())
+        << ", \"min\": " << micros(histogram.min)
+        << ", \"p50\": " << micros(histogram.percentile(50))
+        << ", \"p90\": " << micros(histogram.percentile(90))
+        << ", \"p99\": " << micros(histogram.percentile(99))
+        << ", \"max\": " << micros(histogram.max) << "}";
+}
+
+void appendTimings(std::ostringstream& out, const FrameTimings::Snapshot& timings) {
+    out << "{\"frames\": " << timings.frames
+        << ", \"missed_deadlines\": " << timings.missed_deadlines
+        << ", \"drawer_time_us\": ";
+    appendHistogram(out, timings.drawer_time);
+    out << ", \"present_time_us\": ";
+    appendHistogram(out, timings.present_time);
+    out << ", \"frame_interval_us\": ";
+    appendHistogram(out, timings.frame_interval);
+    out << "}";
+}
+
+} // namespace
+
+FrameTimings::FrameTimings()
+    : m_frames(0),
+    m_missedDeadlines(0),
+    m_previousStart(0),
+    m_drawerTime(),
+    m_presentTime(),
+    m_frameInterval()
+{
+}
+
+void FrameTimings::recordFrame(std::chrono::steady_clock::time_point started, std::chrono::nanoseconds drawer_time)
+{
+    const int64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(started.time_since_epoch()).count();
+    const int64_t previous = m_previousStart.exchange(start, std::memory_order_relaxed);
+    if(previous != 0 && start > previous) {
+        m_frameInterval.record(static_cast<uint64_t>(start - previous));
+    }
+    m_drawerTime.record(static_cast<uint64_t>(std::max<int64_t>(drawer_time.count(), 0)));
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameTimings::recordPresent(std::chrono::nanoseconds present_time)
+{
+    m_presentTime.record(static_cast<uint64_t>(std::max<int64_t>(present_time.count(), 0)));
+}
+
+void FrameTimings::recordMissedDeadline()
+{
+    m_missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameTimings::Snapshot FrameTimings::snapshot() const
+{
+    return Snapshot{
+        m_frames.load(std::memory_order_relaxed),
+        m_missedDeadlines.load(std::memory_order_relaxed),
+        m_drawerTime.snapshot(),
+        m_presentTime.snapshot(),
+        m_frameInterval.snapshot()
+    };
+}
+
+void FrameTimings::reset()
+{
+    m_frames.store(0, std::memory_order_relaxed);
+    m_missedDeadlines.store(0, std::memory_order_relaxed);
+    m_previousStart.store(0, std::memory_order_relaxed);
+    m_drawerTime.reset();
+    m_presentTime.reset();
+    m_frameInterval.reset();
+}
+
+FrameMetrics& FrameMetrics::global()
+{
+    static FrameMetrics metrics;
+    return metrics;
+}
+
+std::shared_ptr<FrameTimings> FrameMetrics::timings(Source source, const std::string &id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& timings = m_timings[{source, id}];
+    if(timings == nullptr) {
+        timings = std::make_shared<FrameTimings>();
+    }
+    return timings;
+}
+
+std::shared_ptr<FrameTimings> FrameMetrics::addInstance(Source source, const std::string &id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const unsigned int instance = ++m_instances[{source, id}];
+    const std::string key = instance == 1 ? id : id + "#" + std::to_string(instance);
+    auto timings = std::make_shared<FrameTimings>();
+    m_timings[{source, key}] = timings;
+    return timings;
+}
+
+std::vector<FrameMetrics::Entry> FrameMetrics::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Entry> entries;
+    entries.reserve(m_timings.size());
+    for(const auto& [key, timings] : m_timings) {
+        entries.push_back(Entry{key.first, key.second, timings->snapshot()});
+    }
+    return entries;
+}
+
+void FrameMetrics::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(auto& [key, timings] : m_timings) {
+        timings->reset();
+    }
+}
+
+std::string FrameMetrics::toJson() const
+{
+    const auto entries = snapshot();
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "{";
+    for(const auto source : {Source::Surface, Source::App}) {
+        out << (source == Source::Surface ? "\"surfaces\": {" : ", \"apps\": {");
+        bool first = true;
+        for(const auto& entry : entries) {
+            if(entry.source != source) {
+                continue;
+            }
+            if(!first) {
+                out << ", ";
+            }
+            first = false;
+            appendJsonString(out, entry.id);
+            out << ": ";
+            appendTimings(out, entry.timings);
+        }
+        out << "}";
+    }
+    out << "}";
+    return out.str();
+}
+
+} // namespace
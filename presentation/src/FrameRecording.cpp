@@ -0,0 +1,170 @@
+#include <protogen/presentation/FrameRecording.h>
+#include <protogen/presentation/PreviewEncoding.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace protogen {
+
+FrameRecording::FrameRecording(const std::string& path)
+    : m_data(nullptr),
+    m_size(0),
+    m_header(nullptr),
+    m_offsets()
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat status;
+    if(fstat(fd, &status) != 0) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    if(m_size < sizeof(frame_recording::Header)) {
+        close(fd);
+        throw std::runtime_error(path + " is too small to be a frame recording.");
+    }
+    void * memory = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    close(fd);
+    if(memory == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "mmap " + path);
+    }
+    m_data = static_cast<const unsigned char *>(memory);
+    m_header = reinterpret_cast<const frame_recording::Header *>(m_data);
+
+    try
+    {
+        if(std::memcmp(m_header->magic, frame_recording::MAGIC, sizeof(frame_recording::MAGIC)) != 0) {
+            throw std::runtime_error(path + " is not a frame recording.");
+        }
+        if(m_header->version != frame_recording::VERSION || m_header->format != frame_recording::Format::RGB888) {
+            throw std::runtime_error(path + " is a frame recording of an unsupported version or format.");
+        }
+        if(m_header->header_size < sizeof(frame_recording::Header) || m_header->header_size % frame_recording::RECORD_ALIGNMENT != 0
+            || m_header->width == 0 || m_header->width > 0xffff || m_header->height == 0 || m_header->height > 0xffff) {
+            throw std::runtime_error(path + " has a malformed frame recording header.");
+        }
+
+        // A record fits if its header and data end before `end`.
+        const auto fits = [this](uint64_t offset, uint64_t end) {
+            if(offset % frame_recording::RECORD_ALIGNMENT != 0 || offset + sizeof(frame_recording::FrameHeader) > end) {
+                return false;
+            }
+            const auto * frame_header = reinterpret_cast<const frame_recording::FrameHeader *>(m_data + offset);
+            return offset + sizeof(frame_recording::FrameHeader) + frame_header->size <= end;
+        };
+        const uint64_t index_offset = m_header->index_offset;
+        const uint64_t frame_count = m_header->frame_count;
+        const bool finished = index_offset != 0
+            && index_offset <= m_size
+            && frame_count <= (m_size - index_offset) / sizeof(uint64_t);
+        if(finished) {
+            m_offsets.resize(frame_count);
+            std::memcpy(m_offsets.data(), m_data + index_offset, frame_count * sizeof(uint64_t));
+            for(const uint64_t offset : m_offsets) {
+                if(offset < m_header->header_size || !fits(offset, index_offset)) {
+                    throw std::runtime_error(path + " has a malformed frame recording index.");
+                }
+            }
+        } else {
+            uint64_t offset = m_header->header_size;
+            while(fits(offset, m_size)) {
+                m_offsets.push_back(offset);
+                offset += frame_recording::recordSize(frame(m_offsets.size() - 1)->size);
+            }
+        }
+    }
+    catch(...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+FrameRecording::~FrameRecording()
+{
+    unmap();
+}
+
+void FrameRecording::unmap()
+{
+    if(m_data != nullptr) {
+        munmap(const_cast<unsigned char *>(m_data), m_size);
+        m_data = nullptr;
+        m_header = nullptr;
+    }
+}
+
+int FrameRecording::width() const
+{
+    return static_cast<int>(m_header->width);
+}
+
+int FrameRecording::height() const
+{
+    return static_cast<int>(m_header->height);
+}
+
+std::size_t FrameRecording::frameCount() const
+{
+    return m_offsets.size();
+}
+
+std::chrono::nanoseconds FrameRecording::duration() const
+{
+    if(m_offsets.empty()) {
+        return std::chrono::nanoseconds(0);
+    }
+    return timestamp(m_offsets.size() - 1);
+}
+
+std::chrono::nanoseconds FrameRecording::timestamp(std::size_t index) const
+{
+    return std::chrono::nanoseconds(frame(index)->timestamp_ns);
+}
+
+bool FrameRecording::isKeyFrame(std::size_t index) const
+{
+    const auto * frame_header = frame(index);
+    return frame_header->size > 0
+        && reinterpret_cast<const uint8_t *>(frame_header + 1)[0] == static_cast<uint8_t>(preview::FrameType::Key);
+}
+
+bool FrameRecording::decode(std::size_t index, std::vector<uint8_t>& rgb) const
+{
+    const auto * frame_header = frame(index);
+    return preview::decode(reinterpret_cast<const uint8_t *>(frame_header + 1), frame_header->size, rgb)
+        && rgb.size() == static_cast<std::size_t>(width()) * height() * 3;
+}
+
+bool FrameRecording::seek(std::size_t index, std::vector<uint8_t>& rgb) const
+{
+    std::size_t key = index;
+    while(key > 0 && !isKeyFrame(key)) {
+        --key;
+    }
+    for(std::size_t i = key; i <= index; ++i) {
+        if(!decode(i, rgb)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const frame_recording::FrameHeader * FrameRecording::frame(std::size_t index) const
+{
+    return reinterpret_cast<const frame_recording::FrameHeader *>(m_data + m_offsets[index]);
+}
+
+} // namespace
@@ -0,0 +1,70 @@
+#include <protogen/presentation/FrameReplay.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace protogen {
+
+double FrameReplay::Result::framesPerSecond() const
+{
+    if(elapsed.count() <= 0) {
+        return 0;
+    }
+    return frames / std::chrono::duration<double>(elapsed).count();
+}
+
+FrameReplay::FrameReplay(const FrameRecording& recording, std::shared_ptr<IRenderSurface> surface)
+    : m_recording(recording),
+    m_surface(surface),
+    m_rgb()
+{
+}
+
+FrameReplay::Result FrameReplay::run(Timing timing, int loops)
+{
+    using Clock = std::chrono::steady_clock;
+    Result result{0, {}, {}, {}, {}, 0};
+    const std::size_t count = m_recording.frameCount();
+    const int width = m_recording.width();
+    const int height = m_recording.height();
+    const auto drawer = [this, width, height](ICanvas& canvas){
+        canvas.blit(m_rgb.data(), width * 3, 0, 0, width, height);
+    };
+
+    const auto start = Clock::now();
+    for(int loop = 0; loop < loops; ++loop) {
+        // Each loop starts when the previous one ended, so frames of later
+        // loops keep the recorded pace instead of all being overdue.
+        const auto loop_start = loop == 0 ? start : Clock::now();
+        // After a frame which could not be decoded, delta frames would
+        // apply to a broken frame, so frames are skipped until a key frame.
+        bool needs_key_frame = false;
+        for(std::size_t i = 0; i < count; ++i) {
+            if(needs_key_frame && !m_recording.isKeyFrame(i)) {
+                ++result.malformed_frames;
+                continue;
+            }
+            needs_key_frame = false;
+            if(!m_recording.decode(i, m_rgb)) {
+                ++result.malformed_frames;
+                needs_key_frame = true;
+                continue;
+            }
+            if(timing == Timing::Original) {
+                const auto due = loop_start + m_recording.timestamp(i);
+                std::this_thread::sleep_until(due);
+                result.most_late = std::max(result.most_late, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - due));
+            }
+            const auto draw_start = Clock::now();
+            m_surface->drawFrame(drawer);
+            const auto draw_time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - draw_start);
+            result.draw_time += draw_time;
+            result.longest_draw = std::max(result.longest_draw, draw_time);
+            ++result.frames;
+        }
+    }
+    result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    return result;
+}
+
+} // namespace
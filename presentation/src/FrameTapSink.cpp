@@ -0,0 +1,129 @@
+#include <protogen/presentation/FrameTapSink.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace protogen {
+
+namespace {
+
+std::size_t roundUp(std::size_t size, std::size_t multiple) {
+    return (size + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+FrameTapSink::FrameTapSink(Resolution resolution, std::string name)
+    : m_width(static_cast<int>(resolution.width())),
+    m_height(static_cast<int>(resolution.height())),
+    m_name(std::move(name)),
+    m_header(nullptr),
+    m_mappedSize(0)
+{
+}
+
+FrameTapSink::~FrameTapSink()
+{
+    unmap();
+}
+
+std::string FrameTapSink::nameFromEnvironment()
+{
+    const char * name = std::getenv(ENV_VAR_NAME);
+    if(name == NULL || name[0] == '\0') {
+        return DEFAULT_NAME;
+    }
+    return name;
+}
+
+IInitializable::Initialization FrameTapSink::initialize()
+{
+    try
+    {
+        const std::size_t header_size = roundUp(sizeof(frame_tap::Header), 64);
+        const std::size_t slot_size = roundUp(sizeof(frame_tap::SlotHeader) + static_cast<std::size_t>(m_width) * m_height * 4, 64);
+        const std::size_t size = header_size + slot_size * SLOT_COUNT;
+
+        const int fd = shm_open(m_name.c_str(), O_CREAT | O_RDWR, 0644);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + m_name);
+        }
+        if(ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "ftruncate " + m_name);
+        }
+        void * memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        close(fd);
+        if(memory == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap " + m_name);
+        }
+        m_mappedSize = size;
+
+        // The magic is written last, so a reader that maps the memory while
+        // it is set up does not take it for a valid ring.
+        std::memset(memory, 0, size);
+        m_header = static_cast<frame_tap::Header *>(memory);
+        m_header->version = frame_tap::VERSION;
+        m_header->slot_count = SLOT_COUNT;
+        m_header->slot_size = slot_size;
+        m_header->slots_offset = header_size;
+        for(uint32_t i = 0; i < SLOT_COUNT; ++i) {
+            frame_tap::SlotHeader * slot = frame_tap::slot(m_header, i);
+            slot->width = m_width;
+            slot->height = m_height;
+            slot->stride = m_width * 4;
+            slot->format = frame_tap::Format::RGBX8888;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(m_header->magic, frame_tap::MAGIC, sizeof(frame_tap::MAGIC));
+
+        return Initialization::Success;
+    }
+    catch(const std::exception& e)
+    {
+        unmap();
+        std::cerr << "Error initializing frame export to shared memory \"" << m_name << "\". Error: " << e.what() << std::endl;
+        return Initialization::Failure;
+    }
+}
+
+void FrameTapSink::consumeFrame(const TeeRenderSurface::RecordedFrame &frame)
+{
+    frame_tap::SlotHeader * slot = frame_tap::slot(m_header, frame.frame_number);
+    const uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->frame_number = frame.frame_number;
+    slot->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(frame.completed_at.time_since_epoch()).count();
+    MemoryCanvas canvas(reinterpret_cast<uint32_t *>(frame_tap::pixels(slot)), m_width, m_height, m_width);
+    canvas.clear();
+    frame.list.replay(canvas);
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    m_header->latest_frame.store(frame.frame_number, std::memory_order_release);
+}
+
+void FrameTapSink::unmap()
+{
+    if(m_header == nullptr) {
+        return;
+    }
+    munmap(m_header, m_mappedSize);
+    // Readers which still have the memory mapped keep it until they unmap.
+    shm_unlink(m_name.c_str());
+    m_header = nullptr;
+}
+
+} // namespace
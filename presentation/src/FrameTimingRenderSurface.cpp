@@ -0,0 +1,68 @@
+#include <protogen/presentation/FrameTimingRenderSurface.h>
+
+#include <chrono>
+
+namespace protogen {
+
+FrameTimingRenderSurface::FrameTimingRenderSurface(std::shared_ptr<IRenderSurface> surface, std::shared_ptr<FrameTimings> timings)
+    : m_surface(surface),
+    m_timings(timings)
+{
+}
+
+IRenderSurface::Initialization FrameTimingRenderSurface::initialize()
+{
+    return Initialization::Success;
+}
+
+void FrameTimingRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    Clock::duration drawer_time{0};
+    m_surface->drawFrame([&drawer, &drawer_time](ICanvas& canvas){
+        const auto drawer_start = Clock::now();
+        drawer(canvas);
+        drawer_time += Clock::now() - drawer_start;
+    });
+    const auto total = Clock::now() - start;
+    m_timings->recordFrame(start, drawer_time);
+    m_timings->recordPresent(total - drawer_time);
+}
+
+Resolution FrameTimingRenderSurface::resolution() const
+{
+    return m_surface->resolution();
+}
+
+std::optional<std::string> FrameTimingRenderSurface::getAttribute(const std::string &key) const
+{
+    return m_surface->getAttribute(key);
+}
+
+std::vector<std::string> FrameTimingRenderSurface::listAttributes() const
+{
+    return m_surface->listAttributes();
+}
+
+attributes::IWritableAttributeStore::SetAttributeResult FrameTimingRenderSurface::setAttribute(const std::string &key, const std::string &value)
+{
+    return m_surface->setAttribute(key, value);
+}
+
+attributes::IWritableAttributeStore::RemoveAttributeResult FrameTimingRenderSurface::removeAttribute(const std::string &key)
+{
+    return m_surface->removeAttribute(key);
+}
+
+bool FrameTimingRenderSurface::hasAttribute(const std::string &key) const
+{
+    return m_surface->hasAttribute(key);
+}
+
+const std::shared_ptr<FrameTimings>& FrameTimingRenderSurface::timings() const
+{
+    return m_timings;
+}
+
+} // namespace
@@ -0,0 +1,112 @@
+#include <protogen/presentation/Histogram.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace protogen {
+
+Histogram::Histogram()
+    : m_buckets(),
+    m_count(0),
+    m_sum(0),
+    m_min(std::numeric_limits<uint64_t>::max()),
+    m_max(0)
+{
+    for(auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t Histogram::bucketOf(uint64_t value)
+{
+    if(value < SUB_BUCKETS) {
+        return static_cast<std::size_t>(value);
+    }
+    const int exponent = std::bit_width(value) - 1;
+    const int shift = exponent - SUB_BUCKET_BITS;
+    const std::size_t sub_bucket = static_cast<std::size_t>(value >> shift) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + static_cast<std::size_t>(shift) * SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t Histogram::bucketUpperBound(std::size_t bucket)
+{
+    if(bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const int shift = static_cast<int>((bucket - SUB_BUCKETS) / SUB_BUCKETS);
+    const uint64_t sub_bucket = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+    const uint64_t lower = (SUB_BUCKETS + sub_bucket) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void Histogram::record(uint64_t value)
+{
+    m_buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t min = m_min.load(std::memory_order_relaxed);
+    while(value < min && !m_min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {
+    }
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while(value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+    // Counted last, so a snapshot never counts more values than its
+    // buckets hold.
+    m_count.fetch_add(1, std::memory_order_release);
+}
+
+Histogram::Snapshot Histogram::snapshot() const
+{
+    Snapshot snapshot{0, 0, 0, 0, std::vector<uint64_t>(BUCKETS, 0)};
+    snapshot.count = m_count.load(std::memory_order_acquire);
+    for(std::size_t i = 0; i < BUCKETS; ++i) {
+        snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.sum = m_sum.load(std::memory_order_relaxed);
+    snapshot.max = m_max.load(std::memory_order_relaxed);
+    snapshot.min = snapshot.count == 0 ? 0 : std::min(m_min.load(std::memory_order_relaxed), snapshot.max);
+    return snapshot;
+}
+
+void Histogram::reset()
+{
+    m_count.store(0, std::memory_order_relaxed);
+    for(auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::Snapshot::percentile(double percentile) const
+{
+    uint64_t total = 0;
+    for(const uint64_t bucket : buckets) {
+        total += bucket;
+    }
+    if(total == 0) {
+        return 0;
+    }
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * total)));
+    uint64_t seen = 0;
+    for(std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if(seen >= rank) {
+            return std::min(bucketUpperBound(i), max);
+        }
+    }
+    return max;
+}
+
+double Histogram::Snapshot::mean() const
+{
+    if(count == 0) {
+        return 0;
+    }
+    return static_cast<double>(sum) / count;
+}
+
+} // namespace
@@ -0,0 +1,120 @@
+#include <protogen/presentation/ImageScaler.h>
+#include <protogen/presentation/PixelKernels.h>
+
+#include <algorithm>
+
+namespace protogen {
+
+ImageScaler::ImageScaler(int source_width, int source_height, int target_width, int target_height, Filter filter)
+    : m_filter(filter),
+    m_columns(makeTaps(source_width, target_width, filter)),
+    m_rows(makeTaps(source_height, target_height, filter)),
+    m_scaledRows(filter == Filter::Bilinear ? target_width : 0, filter == Filter::Bilinear ? source_height : 0),
+    m_rowUsed(std::max(source_height, 0), false)
+{
+    for(const auto& row : m_rows) {
+        m_rowUsed[row.first] = true;
+        if(row.weight != 0) {
+            m_rowUsed[row.second] = true;
+        }
+    }
+}
+
+void ImageScaler::scale(const MemoryCanvas &source, MemoryCanvas &target)
+{
+    if(m_filter == Filter::Nearest) {
+        scaleNearest(source, target);
+    } else {
+        scaleBilinear(source, target);
+    }
+}
+
+ImageScaler::Filter ImageScaler::filter() const
+{
+    return m_filter;
+}
+
+std::vector<ImageScaler::Tap> ImageScaler::makeTaps(int source_size, int target_size, Filter filter)
+{
+    std::vector<Tap> taps;
+    if(source_size <= 0 || target_size <= 0) {
+        return taps;
+    }
+    taps.reserve(target_size);
+    for(int i = 0; i < target_size; ++i) {
+        // The center of target pixel i, in source pixels, is
+        // (2i + 1) * source_size / (2 * target_size). Kept as a fraction of
+        // `denominator` so that the tables are exact.
+        const int64_t denominator = 2 * static_cast<int64_t>(target_size);
+        const int64_t center = (2 * static_cast<int64_t>(i) + 1) * source_size;
+        if(filter == Filter::Nearest) {
+            const int nearest = static_cast<int>(std::min<int64_t>(center / denominator, source_size - 1));
+            taps.push_back({nearest, nearest, 0});
+            continue;
+        }
+        // Bilinear mixes the pixels whose centers are either side of the
+        // target center.
+        const int64_t position = center - target_size;
+        if(position <= 0) {
+            taps.push_back({0, 0, 0});
+            continue;
+        }
+        const int first = static_cast<int>(std::min<int64_t>(position / denominator, source_size - 1));
+        const int second = std::min(first + 1, source_size - 1);
+        const int64_t fraction = position % denominator;
+        const auto weight = static_cast<uint8_t>((fraction * 255 + denominator / 2) / denominator);
+        taps.push_back({first, second, first == second ? uint8_t{0} : weight});
+    }
+    return taps;
+}
+
+void ImageScaler::scaleNearest(const MemoryCanvas &source, MemoryCanvas &target)
+{
+    const auto& kernels = pixel_kernels::kernels();
+    const int width = static_cast<int>(m_columns.size());
+    for(std::size_t y = 0; y < m_rows.size(); ++y) {
+        uint32_t * row = target.row(static_cast<int>(y));
+        if(y > 0 && m_rows[y].first == m_rows[y - 1].first) {
+            kernels.copy(row, target.row(static_cast<int>(y) - 1), width);
+            continue;
+        }
+        const uint32_t * source_row = source.row(m_rows[y].first);
+        for(int x = 0; x < width; ++x) {
+            row[x] = source_row[m_columns[x].first];
+        }
+    }
+}
+
+void ImageScaler::scaleBilinear(const MemoryCanvas &source, MemoryCanvas &target)
+{
+    // Scale every needed source row horizontally once, then mix pairs of
+    // those rows for every target row with the SIMD blend kernel.
+    const int width = static_cast<int>(m_columns.size());
+    for(std::size_t y = 0; y < m_rowUsed.size(); ++y) {
+        if(!m_rowUsed[y]) {
+            continue;
+        }
+        const auto * source_row = reinterpret_cast<const uint8_t *>(source.row(static_cast<int>(y)));
+        auto * scaled_row = reinterpret_cast<uint8_t *>(m_scaledRows.row(static_cast<int>(y)));
+        for(int x = 0; x < width; ++x) {
+            const Tap& tap = m_columns[x];
+            const uint8_t * first = source_row + tap.first * 4;
+            const uint8_t * second = source_row + tap.second * 4;
+            for(int channel = 0; channel < 4; ++channel) {
+                scaled_row[x * 4 + channel] = static_cast<uint8_t>((second[channel] * tap.weight + first[channel] * (255 - tap.weight) + 127) / 255);
+            }
+        }
+    }
+
+    const auto& kernels = pixel_kernels::kernels();
+    for(std::size_t y = 0; y < m_rows.size(); ++y) {
+        const Tap& tap = m_rows[y];
+        uint32_t * row = target.row(static_cast<int>(y));
+        kernels.copy(row, m_scaledRows.row(tap.first), width);
+        if(tap.weight != 0) {
+            kernels.blend(row, m_scaledRows.row(tap.second), width, tap.weight);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,290 @@
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/PixelKernels.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace protogen {
+
+namespace {
+
+// Pad rows to a multiple of 8 pixels (32 bytes) so that every row is
+// aligned for AVX2 loads and stores.
+int paddedStride(int width) {
+    return (std::max(width, 0) + 7) & ~7;
+}
+
+} // namespace
+
+MemoryCanvas::MemoryCanvas(int width, int height)
+    : m_width(std::max(width, 0)),
+    m_height(std::max(height, 0)),
+    m_stride(paddedStride(width)),
+    m_pixels(static_cast<uint32_t *>(::operator new[](std::max<std::size_t>(static_cast<std::size_t>(m_stride) * m_height, 1) * sizeof(uint32_t), std::align_val_t(ALIGNMENT))), AlignedDeleter{true}),
+    m_rgbScratch(),
+    m_premultipliedScratch()
+{
+    clear();
+}
+
+MemoryCanvas::MemoryCanvas(const Resolution &resolution)
+    : MemoryCanvas(resolution.width(), resolution.height())
+{
+}
+
+MemoryCanvas::MemoryCanvas(uint32_t *pixels, int width, int height, int stride)
+    : m_width(std::max(width, 0)),
+    m_height(std::max(height, 0)),
+    m_stride(std::max(stride, m_width)),
+    m_pixels(pixels, AlignedDeleter{false}),
+    m_rgbScratch(),
+    m_premultipliedScratch()
+{
+}
+
+MemoryCanvas::MemoryCanvas(const MemoryCanvas &other)
+    : MemoryCanvas(other.m_width, other.m_height)
+{
+    for(int y = 0; y < m_height; ++y) {
+        std::memcpy(row(y), other.row(y), static_cast<std::size_t>(m_width) * sizeof(uint32_t));
+    }
+}
+
+MemoryCanvas &MemoryCanvas::operator=(const MemoryCanvas &other)
+{
+    if(this != &other) {
+        MemoryCanvas copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+int MemoryCanvas::width() const
+{
+    return m_width;
+}
+
+int MemoryCanvas::height() const
+{
+    return m_height;
+}
+
+void MemoryCanvas::setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if(x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return;
+    }
+    row(y)[x] = pack(red, green, blue);
+}
+
+void MemoryCanvas::clear()
+{
+    if(!m_pixels.get_deleter().owning) {
+        // The padding of a view belongs to whoever owns the pixels.
+        for(int y = 0; y < m_height; ++y) {
+            std::memset(row(y), 0, static_cast<std::size_t>(m_width) * sizeof(uint32_t));
+        }
+        return;
+    }
+    std::memset(m_pixels.get(), 0, static_cast<std::size_t>(m_stride) * m_height * sizeof(uint32_t));
+}
+
+void MemoryCanvas::fill(uint8_t red, uint8_t green, uint8_t blue)
+{
+    if(!m_pixels.get_deleter().owning) {
+        fillRegion(0, 0, m_width, m_height, red, green, blue);
+        return;
+    }
+    // Padding is filled as well so the whole buffer is one contiguous run.
+    pixel_kernels::kernels().fill(m_pixels.get(), pack(red, green, blue), static_cast<std::size_t>(m_stride) * m_height);
+}
+
+void MemoryCanvas::fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    const uint32_t value = pack(red, green, blue);
+    for(int j = 0; j < clip->height; ++j) {
+        kernels.fill(row(clip->dst_y + j) + clip->dst_x, value, clip->width);
+    }
+}
+
+void MemoryCanvas::drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const auto span = clipSpan(x0, x1, y);
+    if(!span.has_value()) {
+        return;
+    }
+    pixel_kernels::kernels().fill(row(y) + span->first, pack(red, green, blue), span->second - span->first + 1);
+}
+
+void MemoryCanvas::blit(const uint8_t *rgb, int stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    for(int j = 0; j < clip->height; ++j) {
+        const uint8_t * source_row = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+        kernels.expandRgb(row(clip->dst_y + j) + clip->dst_x, source_row, clip->width);
+    }
+}
+
+void MemoryCanvas::blitMasked(const uint8_t *rgb, int stride, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    for(int j = 0; j < clip->height; ++j) {
+        const uint8_t * source_row = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+        const uint8_t * mask_row = mask + (clip->src_y + j) * mask_stride + clip->src_x;
+        uint32_t * destination = row(clip->dst_y + j) + clip->dst_x;
+        for(int i = 0; i < clip->width; ++i) {
+            if(mask_row[i] != 0) {
+                destination[i] = pack(source_row[i * 3], source_row[i * 3 + 1], source_row[i * 3 + 2]);
+            }
+        }
+    }
+}
+
+void MemoryCanvas::setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    if(x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return;
+    }
+    const uint8_t rgba[4] = {red, green, blue, alpha};
+    uint32_t premultiplied;
+    const auto& kernels = pixel_kernels::scalarKernels();
+    kernels.premultiply(&premultiplied, rgba, 1);
+    kernels.blendPremultiplied(row(y) + x, &premultiplied, 1);
+}
+
+void MemoryCanvas::blendBlit(const uint8_t *rgba, int stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    m_premultipliedScratch.resize(clip->width);
+    for(int j = 0; j < clip->height; ++j) {
+        const uint8_t * source_row = rgba + (clip->src_y + j) * stride + clip->src_x * 4;
+        kernels.premultiply(m_premultipliedScratch.data(), source_row, clip->width);
+        kernels.blendPremultiplied(row(clip->dst_y + j) + clip->dst_x, m_premultipliedScratch.data(), clip->width);
+    }
+}
+
+int MemoryCanvas::stride() const
+{
+    return m_stride;
+}
+
+uint32_t *MemoryCanvas::row(int y)
+{
+    return m_pixels.get() + static_cast<std::size_t>(y) * m_stride;
+}
+
+const uint32_t *MemoryCanvas::row(int y) const
+{
+    return m_pixels.get() + static_cast<std::size_t>(y) * m_stride;
+}
+
+uint32_t *MemoryCanvas::data()
+{
+    return m_pixels.get();
+}
+
+const uint32_t *MemoryCanvas::data() const
+{
+    return m_pixels.get();
+}
+
+uint32_t MemoryCanvas::pixel(int x, int y) const
+{
+    return row(y)[x];
+}
+
+MemoryCanvas MemoryCanvas::rows(int first_row, int count)
+{
+    return MemoryCanvas(row(first_row), m_width, count, m_stride);
+}
+
+void MemoryCanvas::copyFrom(const MemoryCanvas &source, int x, int y)
+{
+    const auto clip = clipBlit(x, y, source.width(), source.height());
+    if(!clip.has_value()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    for(int j = 0; j < clip->height; ++j) {
+        kernels.copy(row(clip->dst_y + j) + clip->dst_x, source.row(clip->src_y + j) + clip->src_x, clip->width);
+    }
+}
+
+void MemoryCanvas::blendFrom(const MemoryCanvas &source, uint8_t alpha, int x, int y)
+{
+    const auto clip = clipBlit(x, y, source.width(), source.height());
+    if(!clip.has_value()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    for(int j = 0; j < clip->height; ++j) {
+        kernels.blend(row(clip->dst_y + j) + clip->dst_x, source.row(clip->src_y + j) + clip->src_x, clip->width, alpha);
+    }
+}
+
+void MemoryCanvas::compositeFrom(const MemoryCanvas &source, int x, int y)
+{
+    const auto clip = clipBlit(x, y, source.width(), source.height());
+    if(!clip.has_value()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    for(int j = 0; j < clip->height; ++j) {
+        kernels.blendPremultiplied(row(clip->dst_y + j) + clip->dst_x, source.row(clip->src_y + j) + clip->src_x, clip->width);
+    }
+}
+
+void MemoryCanvas::copyTo(ICanvas &target, int x, int y) const
+{
+    if(auto * memory_target = dynamic_cast<MemoryCanvas *>(&target)) {
+        memory_target->copyFrom(*this, x, y);
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    const std::size_t row_bytes = static_cast<std::size_t>(m_width) * 3;
+    m_rgbScratch.resize(row_bytes * m_height);
+    for(int j = 0; j < m_height; ++j) {
+        kernels.packRgb(m_rgbScratch.data() + j * row_bytes, row(j), m_width);
+    }
+    target.blit(m_rgbScratch.data(), static_cast<int>(row_bytes), x, y, m_width, m_height);
+}
+
+void MemoryCanvas::copyTo(ICanvas &target, const Rect &region) const
+{
+    const Rect clipped = region.intersected(Rect{0, 0, m_width, m_height});
+    if(clipped.empty()) {
+        return;
+    }
+    const auto& kernels = pixel_kernels::kernels();
+    if(auto * memory_target = dynamic_cast<MemoryCanvas *>(&target)) {
+        const Rect visible = clipped.intersected(Rect{0, 0, memory_target->width(), memory_target->height()});
+        for(int j = 0; j < visible.height; ++j) {
+            kernels.copy(memory_target->row(visible.y + j) + visible.x, row(visible.y + j) + visible.x, visible.width);
+        }
+        return;
+    }
+    const std::size_t row_bytes = static_cast<std::size_t>(clipped.width) * 3;
+    m_rgbScratch.resize(row_bytes * clipped.height);
+    for(int j = 0; j < clipped.height; ++j) {
+        kernels.packRgb(m_rgbScratch.data() + j * row_bytes, row(clipped.y + j) + clipped.x, clipped.width);
+    }
+    target.blit(m_rgbScratch.data(), static_cast<int>(row_bytes), clipped.x, clipped.y, clipped.width, clipped.height);
+}
+
+} // namespace
@@ -0,0 +1,559 @@
+#include <protogen/presentation/PixelKernels.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PROTOGEN_PIXEL_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#define PROTOGEN_PIXEL_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace protogen::pixel_kernels {
+
+namespace {
+
+// Scalar
+
+void fillScalar(uint32_t * dst, uint32_t value, std::size_t count) {
+    std::fill_n(dst, count, value);
+}
+
+void copyScalar(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    if(count > 0) {
+        std::memcpy(dst, src, count * sizeof(uint32_t));
+    }
+}
+
+void blendScalar(uint32_t * dst, const uint32_t * src, std::size_t count, uint8_t alpha) {
+    auto * d = reinterpret_cast<uint8_t *>(dst);
+    const auto * s = reinterpret_cast<const uint8_t *>(src);
+    for(std::size_t i = 0; i < count * 4; ++i) {
+        d[i] = blendByte(s[i], d[i], alpha);
+    }
+}
+
+void expandRgbScalar(uint32_t * dst, const uint8_t * rgb, std::size_t count) {
+    auto * d = reinterpret_cast<uint8_t *>(dst);
+    for(std::size_t i = 0; i < count; ++i) {
+        d[i * 4] = rgb[i * 3];
+        d[i * 4 + 1] = rgb[i * 3 + 1];
+        d[i * 4 + 2] = rgb[i * 3 + 2];
+        d[i * 4 + 3] = 255;
+    }
+}
+
+void packRgbScalar(uint8_t * rgb, const uint32_t * src, std::size_t count) {
+    const auto * s = reinterpret_cast<const uint8_t *>(src);
+    for(std::size_t i = 0; i < count; ++i) {
+        rgb[i * 3] = s[i * 4];
+        rgb[i * 3 + 1] = s[i * 4 + 1];
+        rgb[i * 3 + 2] = s[i * 4 + 2];
+    }
+}
+
+void premultiplyScalar(uint32_t * dst, const uint8_t * rgba, std::size_t count) {
+    auto * d = reinterpret_cast<uint8_t *>(dst);
+    for(std::size_t i = 0; i < count; ++i) {
+        const uint8_t alpha = rgba[i * 4 + 3];
+        d[i * 4] = static_cast<uint8_t>(div255(rgba[i * 4] * alpha + 128));
+        d[i * 4 + 1] = static_cast<uint8_t>(div255(rgba[i * 4 + 1] * alpha + 128));
+        d[i * 4 + 2] = static_cast<uint8_t>(div255(rgba[i * 4 + 2] * alpha + 128));
+        d[i * 4 + 3] = alpha;
+    }
+}
+
+void blendPremultipliedScalar(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    auto * d = reinterpret_cast<uint8_t *>(dst);
+    const auto * s = reinterpret_cast<const uint8_t *>(src);
+    for(std::size_t i = 0; i < count; ++i) {
+        const uint32_t inverse_alpha = 255 - s[i * 4 + 3];
+        for(std::size_t c = i * 4; c < i * 4 + 4; ++c) {
+            d[c] = static_cast<uint8_t>(std::min<uint32_t>(255, s[c] + div255(d[c] * inverse_alpha + 128)));
+        }
+    }
+}
+
+void sumChannelsScalar(const uint32_t * src, std::size_t count, uint64_t sums[4]) {
+    const auto * s = reinterpret_cast<const uint8_t *>(src);
+    uint64_t totals[4] = {0, 0, 0, 0};
+    for(std::size_t i = 0; i < count; ++i) {
+        for(int c = 0; c < 4; ++c) {
+            totals[c] += s[i * 4 + c];
+        }
+    }
+    for(int c = 0; c < 4; ++c) {
+        sums[c] += totals[c];
+    }
+}
+
+const Kernels SCALAR_KERNELS{
+    "scalar",
+    fillScalar,
+    copyScalar,
+    blendScalar,
+    expandRgbScalar,
+    packRgbScalar,
+    premultiplyScalar,
+    blendPremultipliedScalar,
+    sumChannelsScalar,
+};
+
+#ifdef PROTOGEN_PIXEL_KERNELS_X86
+
+// SSE. SSE2 is used for everything except the RGB conversions which need
+// the SSSE3 byte shuffle.
+
+__attribute__((target("sse2")))
+void fillSse(uint32_t * dst, uint32_t value, std::size_t count) {
+    const __m128i v = _mm_set1_epi32(static_cast<int>(value));
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+    }
+    fillScalar(dst + i, value, count - i);
+}
+
+__attribute__((target("sse2")))
+void copySse(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+    }
+    copyScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("sse2")))
+inline __m128i blendLanesSse(__m128i src, __m128i dst, __m128i alpha, __m128i inverse_alpha) {
+    const __m128i bias = _mm_set1_epi16(128);
+    __m128i t = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse_alpha)), bias);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("sse2")))
+void blendSse(uint32_t * dst, const uint32_t * src, std::size_t count, uint8_t alpha) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_set1_epi16(alpha);
+    const __m128i ia = _mm_set1_epi16(255 - alpha);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i lo = blendLanesSse(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), a, ia);
+        const __m128i hi = blendLanesSse(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), a, ia);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    blendScalar(dst + i, src + i, count - i, alpha);
+}
+
+__attribute__((target("ssse3")))
+void expandRgbSse(uint32_t * dst, const uint8_t * rgb, std::size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    std::size_t i = 0;
+    // Each iteration reads 16 bytes but consumes 12, so stop early enough
+    // that the read never goes past the end of `rgb`.
+    for(; i + 6 <= count; i += 4) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(_mm_shuffle_epi8(in, shuffle), opaque));
+    }
+    expandRgbScalar(dst + i, rgb + i * 3, count - i);
+}
+
+__attribute__((target("ssse3")))
+void packRgbSse(uint8_t * rgb, const uint32_t * src, std::size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    std::size_t i = 0;
+    // Each iteration writes 16 bytes of which the last 4 are overwritten by
+    // the next iteration, so stop early enough to stay inside `rgb`.
+    for(; i + 6 <= count; i += 4) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgb + i * 3), _mm_shuffle_epi8(in, shuffle));
+    }
+    packRgbScalar(rgb + i * 3, src + i, count - i);
+}
+
+// Broadcasts the alpha of each pixel to all four of its 16-bit lanes.
+__attribute__((target("sse2")))
+inline __m128i broadcastAlphaSse(__m128i pixels) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+__attribute__((target("sse2")))
+inline __m128i div255Sse(__m128i t) {
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("sse2")))
+void premultiplySse(uint32_t * dst, const uint8_t * rgba, std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba + i * 4));
+        const __m128i lo = _mm_unpacklo_epi8(s, zero);
+        const __m128i hi = _mm_unpackhi_epi8(s, zero);
+        const __m128i lo_result = div255Sse(_mm_add_epi16(_mm_mullo_epi16(lo, broadcastAlphaSse(lo)), bias));
+        const __m128i hi_result = div255Sse(_mm_add_epi16(_mm_mullo_epi16(hi, broadcastAlphaSse(hi)), bias));
+        // Alpha itself must not be scaled, so put the original back.
+        const __m128i result = _mm_or_si128(_mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo_result, hi_result)), _mm_and_si128(alpha_mask, s));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+    }
+    premultiplyScalar(dst + i, rgba + i * 4, count - i);
+}
+
+__attribute__((target("sse2")))
+void blendPremultipliedSse(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i max = _mm_set1_epi16(255);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i lo_inverse_alpha = _mm_sub_epi16(max, broadcastAlphaSse(_mm_unpacklo_epi8(s, zero)));
+        const __m128i hi_inverse_alpha = _mm_sub_epi16(max, broadcastAlphaSse(_mm_unpackhi_epi8(s, zero)));
+        const __m128i lo = div255Sse(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), lo_inverse_alpha), bias));
+        const __m128i hi = div255Sse(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), hi_inverse_alpha), bias));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+    }
+    blendPremultipliedScalar(dst + i, src + i, count - i);
+}
+
+// Sums one byte of every pixel by masking out the others and summing
+// absolute differences against zero, which adds up 8 bytes at a time into
+// 64-bit lanes.
+__attribute__((target("sse2")))
+void sumChannelsSse(const uint32_t * src, std::size_t count, uint64_t sums[4]) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i totals[4] = {zero, zero, zero, zero};
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        for(int c = 0; c < 4; ++c) {
+            const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFu << (c * 8)));
+            totals[c] = _mm_add_epi64(totals[c], _mm_sad_epu8(_mm_and_si128(pixels, mask), zero));
+        }
+    }
+    for(int c = 0; c < 4; ++c) {
+        alignas(16) uint64_t lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), totals[c]);
+        sums[c] += lanes[0] + lanes[1];
+    }
+    sumChannelsScalar(src + i, count - i, sums);
+}
+
+const Kernels SSE_KERNELS{
+    "sse",
+    fillSse,
+    copySse,
+    blendSse,
+    expandRgbSse,
+    packRgbSse,
+    premultiplySse,
+    blendPremultipliedSse,
+    sumChannelsSse,
+};
+
+// AVX2. The RGB conversions cross 128-bit lanes awkwardly, so they reuse
+// the SSSE3 versions which every AVX2 CPU supports.
+
+__attribute__((target("avx2")))
+void fillAvx2(uint32_t * dst, uint32_t value, std::size_t count) {
+    const __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+    }
+    fillScalar(dst + i, value, count - i);
+}
+
+__attribute__((target("avx2")))
+void copyAvx2(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)));
+    }
+    copyScalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i blendLanesAvx2(__m256i src, __m256i dst, __m256i alpha, __m256i inverse_alpha) {
+    const __m256i bias = _mm256_set1_epi16(128);
+    __m256i t = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(dst, inverse_alpha)), bias);
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+void blendAvx2(uint32_t * dst, const uint32_t * src, std::size_t count, uint8_t alpha) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i a = _mm256_set1_epi16(alpha);
+    const __m256i ia = _mm256_set1_epi16(255 - alpha);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        // Unpack and pack both work within 128-bit lanes, so pixel order is kept.
+        const __m256i lo = blendLanesAvx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), a, ia);
+        const __m256i hi = blendLanesAvx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), a, ia);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    blendSse(dst + i, src + i, count - i, alpha);
+}
+
+__attribute__((target("avx2")))
+inline __m256i broadcastAlphaAvx2(__m256i pixels) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+__attribute__((target("avx2")))
+inline __m256i div255Avx2(__m256i t) {
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+void premultiplyAvx2(uint32_t * dst, const uint8_t * rgba, std::size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bias = _mm256_set1_epi16(128);
+    const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rgba + i * 4));
+        const __m256i lo = _mm256_unpacklo_epi8(s, zero);
+        const __m256i hi = _mm256_unpackhi_epi8(s, zero);
+        const __m256i lo_result = div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(lo, broadcastAlphaAvx2(lo)), bias));
+        const __m256i hi_result = div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(hi, broadcastAlphaAvx2(hi)), bias));
+        const __m256i result = _mm256_or_si256(_mm256_andnot_si256(alpha_mask, _mm256_packus_epi16(lo_result, hi_result)), _mm256_and_si256(alpha_mask, s));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), result);
+    }
+    premultiplySse(dst + i, rgba + i * 4, count - i);
+}
+
+__attribute__((target("avx2")))
+void blendPremultipliedAvx2(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bias = _mm256_set1_epi16(128);
+    const __m256i max = _mm256_set1_epi16(255);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        const __m256i lo_inverse_alpha = _mm256_sub_epi16(max, broadcastAlphaAvx2(_mm256_unpacklo_epi8(s, zero)));
+        const __m256i hi_inverse_alpha = _mm256_sub_epi16(max, broadcastAlphaAvx2(_mm256_unpackhi_epi8(s, zero)));
+        const __m256i lo = div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), lo_inverse_alpha), bias));
+        const __m256i hi = div255Avx2(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), hi_inverse_alpha), bias));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_adds_epu8(s, _mm256_packus_epi16(lo, hi)));
+    }
+    blendPremultipliedSse(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void sumChannelsAvx2(const uint32_t * src, std::size_t count, uint64_t sums[4]) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i totals[4] = {zero, zero, zero, zero};
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        for(int c = 0; c < 4; ++c) {
+            const __m256i mask = _mm256_set1_epi32(static_cast<int>(0xFFu << (c * 8)));
+            totals[c] = _mm256_add_epi64(totals[c], _mm256_sad_epu8(_mm256_and_si256(pixels, mask), zero));
+        }
+    }
+    for(int c = 0; c < 4; ++c) {
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), totals[c]);
+        sums[c] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    sumChannelsSse(src + i, count - i, sums);
+}
+
+const Kernels AVX2_KERNELS{
+    "avx2",
+    fillAvx2,
+    copyAvx2,
+    blendAvx2,
+    expandRgbSse,
+    packRgbSse,
+    premultiplyAvx2,
+    blendPremultipliedAvx2,
+    sumChannelsAvx2,
+};
+
+#endif // PROTOGEN_PIXEL_KERNELS_X86
+
+#ifdef PROTOGEN_PIXEL_KERNELS_NEON
+
+void fillNeon(uint32_t * dst, uint32_t value, std::size_t count) {
+    const uint32x4_t v = vdupq_n_u32(value);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, v);
+    }
+    fillScalar(dst + i, value, count - i);
+}
+
+void copyNeon(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, vld1q_u32(src + i));
+    }
+    copyScalar(dst + i, src + i, count - i);
+}
+
+inline uint8x8_t blendLanesNeon(uint8x8_t src, uint8x8_t dst, uint8x8_t alpha, uint8x8_t inverse_alpha) {
+    uint16x8_t t = vmull_u8(src, alpha);
+    t = vmlal_u8(t, dst, inverse_alpha);
+    t = vaddq_u16(t, vdupq_n_u16(128));
+    // (t + (t >> 8)) >> 8
+    return vshrn_n_u16(vsraq_n_u16(t, t, 8), 8);
+}
+
+void blendNeon(uint32_t * dst, const uint32_t * src, std::size_t count, uint8_t alpha) {
+    const uint8x8_t a = vdup_n_u8(alpha);
+    const uint8x8_t ia = vdup_n_u8(255 - alpha);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const uint8x16_t s = vreinterpretq_u8_u32(vld1q_u32(src + i));
+        const uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        const uint8x8_t lo = blendLanesNeon(vget_low_u8(s), vget_low_u8(d), a, ia);
+        const uint8x8_t hi = blendLanesNeon(vget_high_u8(s), vget_high_u8(d), a, ia);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(vcombine_u8(lo, hi)));
+    }
+    blendScalar(dst + i, src + i, count - i, alpha);
+}
+
+void expandRgbNeon(uint32_t * dst, const uint8_t * rgb, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const uint8x16x3_t in = vld3q_u8(rgb + i * 3);
+        uint8x16x4_t out;
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = in.val[2];
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(reinterpret_cast<uint8_t *>(dst + i), out);
+    }
+    expandRgbScalar(dst + i, rgb + i * 3, count - i);
+}
+
+void packRgbNeon(uint8_t * rgb, const uint32_t * src, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t *>(src + i));
+        uint8x16x3_t out;
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = in.val[2];
+        vst3q_u8(rgb + i * 3, out);
+    }
+    packRgbScalar(rgb + i * 3, src + i, count - i);
+}
+
+// Rounded division by 255 of the products in `t`, narrowed to bytes.
+inline uint8x8_t div255Neon(uint16x8_t t) {
+    t = vaddq_u16(t, vdupq_n_u16(128));
+    return vshrn_n_u16(vsraq_n_u16(t, t, 8), 8);
+}
+
+inline uint8x16_t scaleNeon(uint8x16_t channel, uint8x16_t factor) {
+    const uint8x8_t lo = div255Neon(vmull_u8(vget_low_u8(channel), vget_low_u8(factor)));
+    const uint8x8_t hi = div255Neon(vmull_u8(vget_high_u8(channel), vget_high_u8(factor)));
+    return vcombine_u8(lo, hi);
+}
+
+void premultiplyNeon(uint32_t * dst, const uint8_t * rgba, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        uint8x16x4_t pixels = vld4q_u8(rgba + i * 4);
+        pixels.val[0] = scaleNeon(pixels.val[0], pixels.val[3]);
+        pixels.val[1] = scaleNeon(pixels.val[1], pixels.val[3]);
+        pixels.val[2] = scaleNeon(pixels.val[2], pixels.val[3]);
+        vst4q_u8(reinterpret_cast<uint8_t *>(dst + i), pixels);
+    }
+    premultiplyScalar(dst + i, rgba + i * 4, count - i);
+}
+
+void blendPremultipliedNeon(uint32_t * dst, const uint32_t * src, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16) {
+        const uint8x16x4_t s = vld4q_u8(reinterpret_cast<const uint8_t *>(src + i));
+        uint8x16x4_t d = vld4q_u8(reinterpret_cast<const uint8_t *>(dst + i));
+        const uint8x16_t inverse_alpha = vmvnq_u8(s.val[3]);
+        for(int c = 0; c < 4; ++c) {
+            d.val[c] = vqaddq_u8(s.val[c], scaleNeon(d.val[c], inverse_alpha));
+        }
+        vst4q_u8(reinterpret_cast<uint8_t *>(dst + i), d);
+    }
+    blendPremultipliedScalar(dst + i, src + i, count - i);
+}
+
+void sumChannelsNeon(const uint32_t * src, std::size_t count, uint64_t sums[4]) {
+    std::size_t i = 0;
+    while(i + 16 <= count) {
+        // Each 32-bit lane grows by at most 4 * 255 per iteration, so flush
+        // to 64 bits often enough that it cannot overflow.
+        const std::size_t end = std::min(count - count % 16, i + 16 * 65536);
+        uint32x4_t totals[4] = {vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0)};
+        for(; i < end; i += 16) {
+            const uint8x16x4_t pixels = vld4q_u8(reinterpret_cast<const uint8_t *>(src + i));
+            for(int c = 0; c < 4; ++c) {
+                totals[c] = vpadalq_u16(totals[c], vpaddlq_u8(pixels.val[c]));
+            }
+        }
+        for(int c = 0; c < 4; ++c) {
+            const uint64x2_t wide = vpaddlq_u32(totals[c]);
+            sums[c] += vgetq_lane_u64(wide, 0) + vgetq_lane_u64(wide, 1);
+        }
+    }
+    sumChannelsScalar(src + i, count - i, sums);
+}
+
+const Kernels NEON_KERNELS{
+    "neon",
+    fillNeon,
+    copyNeon,
+    blendNeon,
+    expandRgbNeon,
+    packRgbNeon,
+    premultiplyNeon,
+    blendPremultipliedNeon,
+    sumChannelsNeon,
+};
+
+#endif // PROTOGEN_PIXEL_KERNELS_NEON
+
+} // namespace
+
+const Kernels& scalarKernels() {
+    return SCALAR_KERNELS;
+}
+
+std::vector<const Kernels *> availableKernels() {
+    std::vector<const Kernels *> available{&SCALAR_KERNELS};
+#ifdef PROTOGEN_PIXEL_KERNELS_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("ssse3")) {
+        available.push_back(&SSE_KERNELS);
+    }
+    if(__builtin_cpu_supports("avx2")) {
+        available.push_back(&AVX2_KERNELS);
+    }
+#endif
+#ifdef PROTOGEN_PIXEL_KERNELS_NEON
+    available.push_back(&NEON_KERNELS);
+#endif
+    return available;
+}
+
+const Kernels& kernels() {
+    // The last available set is the fastest one.
+    static const Kernels& selected = *availableKernels().back();
+    return selected;
+}
+
+} // namespace
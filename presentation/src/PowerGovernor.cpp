@@ -0,0 +1,53 @@
+#include <protogen/presentation/PowerGovernor.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace protogen {
+
+PowerGovernor::PowerGovernor(const Config &config)
+    : m_config(config),
+    m_brightness(1.0),
+    m_milliamps(config.idle_ma)
+{
+}
+
+double PowerGovernor::estimateMilliamps(uint64_t red_total, uint64_t green_total, uint64_t blue_total) const
+{
+    const double leds = (red_total * m_config.red_ma + green_total * m_config.green_ma + blue_total * m_config.blue_ma) / 255.0;
+    return m_config.idle_ma + leds;
+}
+
+uint8_t PowerGovernor::update(double full_brightness_ma)
+{
+    const double leds_ma = std::max(full_brightness_ma - m_config.idle_ma, 0.0);
+    double target = 1.0;
+    if(m_config.budget_ma > 0 && leds_ma > 0) {
+        const double allowed_ma = std::max(m_config.budget_ma - m_config.idle_ma, 0.0);
+        target = std::min(allowed_ma / leds_ma, 1.0);
+    }
+    if(target < m_brightness) {
+        m_brightness = target;
+    } else {
+        m_brightness += (target - m_brightness) * m_config.recovery;
+        // Settle on the target instead of creeping towards it forever.
+        if(target - m_brightness < 1.0 / 255) {
+            m_brightness = target;
+        }
+    }
+    m_milliamps = m_config.idle_ma + leds_ma * brightness() / 255.0;
+    return brightness();
+}
+
+uint8_t PowerGovernor::brightness() const
+{
+    // Rounded down, so a limited frame never goes over budget.
+    return static_cast<uint8_t>(std::floor(m_brightness * 255));
+}
+
+double PowerGovernor::milliwatts() const
+{
+    return m_milliamps * m_config.supply_volts;
+}
+
+} // namespace
@@ -0,0 +1,159 @@
+#include <protogen/presentation/PreviewEncoding.h>
+
+#include <algorithm>
+
+namespace protogen::preview {
+
+namespace {
+
+static constexpr std::size_t MAX_SKIP = 64;
+static constexpr std::size_t MAX_REPEAT = 64;
+static constexpr std::size_t MAX_LITERAL = 128;
+
+uint32_t xorPixel(const std::vector<uint8_t>& current, const std::vector<uint8_t>* previous, std::size_t index) {
+    const uint8_t * c = current.data() + index * 3;
+    uint32_t value = c[0] | (c[1] << 8) | (c[2] << 16);
+    if(previous != nullptr) {
+        const uint8_t * p = previous->data() + index * 3;
+        value ^= p[0] | (p[1] << 8) | (p[2] << 16);
+    }
+    return value;
+}
+
+void appendPixel(std::vector<uint8_t>& out, uint32_t pixel) {
+    out.push_back(static_cast<uint8_t>(pixel));
+    out.push_back(static_cast<uint8_t>(pixel >> 8));
+    out.push_back(static_cast<uint8_t>(pixel >> 16));
+}
+
+} // namespace
+
+void encode(FrameType type, int width, int height, uint32_t frame_number, const std::vector<uint8_t>& current, const std::vector<uint8_t>& previous, std::vector<uint8_t>& out)
+{
+    out.clear();
+    out.push_back(static_cast<uint8_t>(type));
+    out.push_back(static_cast<uint8_t>(width));
+    out.push_back(static_cast<uint8_t>(width >> 8));
+    out.push_back(static_cast<uint8_t>(height));
+    out.push_back(static_cast<uint8_t>(height >> 8));
+    for(int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(frame_number >> (i * 8)));
+    }
+
+    const std::vector<uint8_t> * against = type == FrameType::Key ? nullptr : &previous;
+    const std::size_t count = static_cast<std::size_t>(width) * height;
+    std::size_t i = 0;
+    while(i < count) {
+        const uint32_t pixel = xorPixel(current, against, i);
+        std::size_t run = 1;
+        while(i + run < count && run < MAX_LITERAL && xorPixel(current, against, i + run) == pixel) {
+            ++run;
+        }
+        if(pixel == 0) {
+            run = std::min(run, MAX_SKIP);
+            out.push_back(static_cast<uint8_t>(run - 1));
+            i += run;
+        } else if(run >= 2) {
+            run = std::min(run, MAX_REPEAT);
+            out.push_back(static_cast<uint8_t>(0x40 | (run - 1)));
+            appendPixel(out, pixel);
+            i += run;
+        } else {
+            // Collect literals until a run of two equal pixels starts, as
+            // that is cheaper as a run of its own.
+            const std::size_t header = out.size();
+            out.push_back(0);
+            std::size_t literals = 0;
+            uint32_t next = pixel;
+            do {
+                appendPixel(out, next);
+                ++literals;
+                if(i + literals >= count) {
+                    break;
+                }
+                next = xorPixel(current, against, i + literals);
+            } while(literals < MAX_LITERAL
+                && !(i + literals + 1 < count && xorPixel(current, against, i + literals + 1) == next)
+                && next != 0);
+            out[header] = static_cast<uint8_t>(0x80 | (literals - 1));
+            i += literals;
+        }
+    }
+}
+
+bool decode(const uint8_t *data, std::size_t size, std::vector<uint8_t> &rgb)
+{
+    if(size < HEADER_SIZE) {
+        return false;
+    }
+    const auto type = static_cast<FrameType>(data[0]);
+    const std::size_t width = data[1] | (data[2] << 8);
+    const std::size_t height = data[3] | (data[4] << 8);
+    const std::size_t count = width * height;
+    if(type == FrameType::Key) {
+        rgb.assign(count * 3, 0);
+    } else if(type != FrameType::Delta || rgb.size() != count * 3) {
+        return false;
+    }
+
+    std::size_t position = HEADER_SIZE;
+    std::size_t i = 0;
+    while(i < count) {
+        if(position >= size) {
+            return false;
+        }
+        const uint8_t run = data[position++];
+        if((run & 0x80) != 0) {
+            const std::size_t literals = (run & 0x7f) + 1;
+            if(i + literals > count || position + literals * 3 > size) {
+                return false;
+            }
+            for(std::size_t j = 0; j < literals * 3; ++j) {
+                rgb[i * 3 + j] ^= data[position + j];
+            }
+            position += literals * 3;
+            i += literals;
+        } else if((run & 0x40) != 0) {
+            const std::size_t repeat = (run & 0x3f) + 1;
+            if(i + repeat > count || position + 3 > size) {
+                return false;
+            }
+            for(std::size_t j = 0; j < repeat; ++j) {
+                rgb[(i + j) * 3] ^= data[position];
+                rgb[(i + j) * 3 + 1] ^= data[position + 1];
+                rgb[(i + j) * 3 + 2] ^= data[position + 2];
+            }
+            position += 3;
+            i += repeat;
+        } else {
+            i += (run & 0x3f) + 1;
+        }
+    }
+    return i == count && position == size;
+}
+
+std::string toBase64(const std::vector<uint8_t> &data)
+{
+    static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    std::size_t i = 0;
+    for(; i + 2 < data.size(); i += 3) {
+        const uint32_t bits = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        out.push_back(ALPHABET[(bits >> 18) & 0x3f]);
+        out.push_back(ALPHABET[(bits >> 12) & 0x3f]);
+        out.push_back(ALPHABET[(bits >> 6) & 0x3f]);
+        out.push_back(ALPHABET[bits & 0x3f]);
+    }
+    if(i < data.size()) {
+        const bool two = i + 1 < data.size();
+        const uint32_t bits = (data[i] << 16) | (two ? data[i + 1] << 8 : 0);
+        out.push_back(ALPHABET[(bits >> 18) & 0x3f]);
+        out.push_back(ALPHABET[(bits >> 12) & 0x3f]);
+        out.push_back(two ? ALPHABET[(bits >> 6) & 0x3f] : '=');
+        out.push_back('=');
+    }
+    return out;
+}
+
+} // namespace
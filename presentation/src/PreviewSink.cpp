@@ -0,0 +1,35 @@
+#include <protogen/presentation/PreviewSink.h>
+#include <protogen/presentation/PixelKernels.h>
+
+namespace protogen {
+
+PreviewSink::PreviewSink(Resolution resolution)
+    : m_width(static_cast<int>(resolution.width())),
+    m_height(static_cast<int>(resolution.height())),
+    m_stream(std::make_shared<PreviewStream>(m_width, m_height)),
+    m_canvas(m_width, m_height),
+    m_rgb(static_cast<std::size_t>(m_width) * m_height * 3)
+{
+}
+
+std::shared_ptr<PreviewStream> PreviewSink::stream() const
+{
+    return m_stream;
+}
+
+void PreviewSink::consumeFrame(const TeeRenderSurface::RecordedFrame &frame)
+{
+    if(!m_stream->hasSubscribers()) {
+        return;
+    }
+    m_canvas.clear();
+    frame.list.replay(m_canvas);
+    const auto& kernels = pixel_kernels::kernels();
+    const std::size_t row_bytes = static_cast<std::size_t>(m_width) * 3;
+    for(int y = 0; y < m_height; ++y) {
+        kernels.packRgb(m_rgb.data() + y * row_bytes, m_canvas.row(y), m_width);
+    }
+    m_stream->pushFrame(m_rgb, frame.completed_at);
+}
+
+} // namespace
@@ -0,0 +1,107 @@
+#include <protogen/presentation/PreviewStream.h>
+#include <protogen/presentation/PreviewEncoding.h>
+
+#include <algorithm>
+
+namespace protogen {
+
+PreviewStream::PreviewStream(int width, int height)
+    : m_width(width),
+    m_height(height),
+    m_tiers(),
+    m_encoded()
+{
+    for(std::size_t i = 0; i < m_tiers.size(); ++i) {
+        m_tiers[i].period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) / TIER_RATES[i];
+        m_tiers[i].frame.assign(static_cast<std::size_t>(width) * height * 3, 0);
+    }
+}
+
+int PreviewStream::width() const
+{
+    return m_width;
+}
+
+int PreviewStream::height() const
+{
+    return m_height;
+}
+
+std::size_t PreviewStream::subscribe(int fps)
+{
+    std::size_t tier = 0;
+    while(tier + 1 < TIER_RATES.size() && TIER_RATES[tier] > fps) {
+        ++tier;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_tiers[tier].subscribers;
+    return tier;
+}
+
+void PreviewStream::unsubscribe(std::size_t tier)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_tiers[tier].subscribers;
+}
+
+bool PreviewStream::hasSubscribers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(const auto& tier : m_tiers) {
+        if(tier.subscribers > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PreviewStream::pushFrame(const std::vector<uint8_t> &rgb, std::chrono::steady_clock::time_point time)
+{
+    bool sent = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(auto& tier : m_tiers) {
+            // Frames a little early are taken, so frames arriving at about
+            // the tier's rate are not skipped because of jitter.
+            if(tier.subscribers == 0 || time + tier.period / 4 < tier.next_due) {
+                continue;
+            }
+            // Keep to the tier's schedule, unless frames arrive slower than
+            // its rate.
+            tier.next_due = std::max(tier.next_due + tier.period, time + tier.period / 2);
+            ++tier.frame_number;
+            preview::encode(preview::FrameType::Delta, m_width, m_height, tier.frame_number, rgb, tier.frame, m_encoded);
+            tier.frame = rgb;
+            tier.delta = std::make_shared<const std::string>(preview::toBase64(m_encoded));
+            tier.key.reset();
+            ++tier.sequence;
+            sent = true;
+        }
+    }
+    if(sent) {
+        m_messageReady.notify_all();
+    }
+}
+
+std::optional<PreviewStream::Message> PreviewStream::next(std::size_t tier_index, uint64_t sequence, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Tier& tier = m_tiers[tier_index];
+    const bool has_message = m_messageReady.wait_for(lock, timeout, [&tier, sequence]{
+        return tier.sequence > sequence;
+    });
+    if(!has_message) {
+        return {};
+    }
+    // Clients which just connected or missed a message need a key frame.
+    if(sequence != 0 && tier.sequence == sequence + 1) {
+        return Message{tier.sequence, tier.delta};
+    }
+    if(!tier.key) {
+        preview::encode(preview::FrameType::Key, m_width, m_height, tier.frame_number, tier.frame, tier.frame, m_encoded);
+        tier.key = std::make_shared<const std::string>(preview::toBase64(m_encoded));
+    }
+    return Message{tier.sequence, tier.key};
+}
+
+} // namespace
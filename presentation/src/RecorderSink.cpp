@@ -0,0 +1,166 @@
+#include <protogen/presentation/RecorderSink.h>
+#include <protogen/presentation/PixelKernels.h>
+#include <protogen/presentation/PreviewEncoding.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace protogen {
+
+namespace {
+
+static constexpr std::size_t FILE_BUFFER_SIZE = 1 << 20;
+// The process is usually stopped by a signal, which never finishes the
+// recording, so what is buffered must reach the file regularly.
+static constexpr auto FLUSH_INTERVAL = std::chrono::seconds(1);
+
+frame_recording::Header makeHeader(int width, int height, uint32_t key_interval) {
+    frame_recording::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, frame_recording::MAGIC, sizeof(frame_recording::MAGIC));
+    header.version = frame_recording::VERSION;
+    header.header_size = sizeof(frame_recording::Header);
+    header.width = width;
+    header.height = height;
+    header.format = frame_recording::Format::RGB888;
+    header.key_interval = key_interval;
+    return header;
+}
+
+} // namespace
+
+RecorderSink::RecorderSink(Resolution resolution, std::string path, uint32_t key_interval)
+    : m_path(std::move(path)),
+    m_keyInterval(std::max<uint32_t>(key_interval, 1)),
+    m_width(static_cast<int>(resolution.width())),
+    m_height(static_cast<int>(resolution.height())),
+    m_file(nullptr),
+    m_offset(0),
+    m_index(),
+    m_firstFrameAt(),
+    m_lastTimestamp(0),
+    m_lastFlushAt(),
+    m_canvas(m_width, m_height),
+    m_rgb(static_cast<std::size_t>(m_width) * m_height * 3),
+    m_previousRgb(m_rgb.size()),
+    m_encoded()
+{
+}
+
+RecorderSink::~RecorderSink()
+{
+    finish();
+}
+
+IInitializable::Initialization RecorderSink::initialize()
+{
+    finish();
+    m_file = std::fopen(m_path.c_str(), "wb");
+    if(m_file == nullptr) {
+        std::cerr << "Error creating frame recording \"" << m_path << "\". Error: " << std::strerror(errno) << std::endl;
+        return Initialization::Failure;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, FILE_BUFFER_SIZE);
+    m_offset = 0;
+    m_index.clear();
+    m_lastTimestamp = 0;
+    const auto header = makeHeader(m_width, m_height, m_keyInterval);
+    if(!write(&header, sizeof(header)) || !flush()) {
+        return Initialization::Failure;
+    }
+    m_lastFlushAt = std::chrono::steady_clock::now();
+    return Initialization::Success;
+}
+
+void RecorderSink::consumeFrame(const TeeRenderSurface::RecordedFrame &frame)
+{
+    if(m_file == nullptr) {
+        return;
+    }
+    const auto completed_at = frame.completed_at;
+    m_canvas.clear();
+    frame.list.replay(m_canvas);
+    const auto& kernels = pixel_kernels::kernels();
+    const std::size_t row_bytes = static_cast<std::size_t>(m_width) * 3;
+    for(int y = 0; y < m_height; ++y) {
+        kernels.packRgb(m_rgb.data() + y * row_bytes, m_canvas.row(y), m_width);
+    }
+
+    const uint64_t frame_number = m_index.size();
+    if(frame_number == 0) {
+        m_firstFrameAt = completed_at;
+    }
+    const auto type = frame_number % m_keyInterval == 0 ? preview::FrameType::Key : preview::FrameType::Delta;
+    preview::encode(type, m_width, m_height, static_cast<uint32_t>(frame_number), m_rgb, m_previousRgb, m_encoded);
+    m_rgb.swap(m_previousRgb);
+
+    frame_recording::FrameHeader frame_header;
+    std::memset(&frame_header, 0, sizeof(frame_header));
+    frame_header.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(completed_at - m_firstFrameAt).count();
+    frame_header.size = static_cast<uint32_t>(m_encoded.size());
+    const std::size_t padding = frame_recording::recordSize(frame_header.size) - sizeof(frame_header) - m_encoded.size();
+    static constexpr uint8_t zeros[frame_recording::RECORD_ALIGNMENT] = {};
+
+    const uint64_t offset = m_offset;
+    if(write(&frame_header, sizeof(frame_header)) && write(m_encoded.data(), m_encoded.size()) && write(zeros, padding)) {
+        m_index.push_back(offset);
+        m_lastTimestamp = frame_header.timestamp_ns;
+        if(frame_number == 0 || completed_at - m_lastFlushAt >= FLUSH_INTERVAL) {
+            m_lastFlushAt = completed_at;
+            flush();
+        }
+    }
+}
+
+void RecorderSink::finish()
+{
+    if(m_file == nullptr) {
+        return;
+    }
+    auto header = makeHeader(m_width, m_height, m_keyInterval);
+    header.frame_count = m_index.size();
+    header.index_offset = m_offset;
+    header.duration_ns = m_lastTimestamp;
+    if(write(m_index.data(), m_index.size() * sizeof(uint64_t))) {
+        if(std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+            std::cerr << "Error finishing frame recording \"" << m_path << "\". Error: " << std::strerror(errno) << std::endl;
+        }
+    }
+    if(m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool RecorderSink::write(const void * data, std::size_t size)
+{
+    if(size != 0 && std::fwrite(data, 1, size, m_file) != size) {
+        // Stop recording. What was written so far can still be replayed.
+        std::cerr << "Error writing frame recording \"" << m_path << "\". Error: " << std::strerror(errno) << std::endl;
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_offset += size;
+    return true;
+}
+
+bool RecorderSink::flush()
+{
+    if(std::fflush(m_file) != 0) {
+        std::cerr << "Error writing frame recording \"" << m_path << "\". Error: " << std::strerror(errno) << std::endl;
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    return true;
+}
+
+uint64_t RecorderSink::frameCount() const
+{
+    return m_index.size();
+}
+
+} // namespace
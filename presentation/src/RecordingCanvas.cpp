@@ -0,0 +1,125 @@
+#include <protogen/presentation/RecordingCanvas.h>
+
+#include <cstring>
+
+using namespace protogen;
+
+RecordingCanvas::RecordingCanvas(DisplayList &list, int width, int height)
+    : m_list(list), m_width(width), m_height(height)
+{
+}
+
+int RecordingCanvas::width() const
+{
+    return m_width;
+}
+
+int RecordingCanvas::height() const
+{
+    return m_height;
+}
+
+void RecordingCanvas::setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    if(x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return;
+    }
+    const DisplayList::PixelArguments arguments{x, y, red, green, blue, 255};
+    m_list.append(DisplayList::Op::SetPixel, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::clear()
+{
+    m_list.append(DisplayList::Op::Clear, nullptr, 0);
+}
+
+void RecordingCanvas::fill(uint8_t red, uint8_t green, uint8_t blue)
+{
+    const DisplayList::ColorArguments arguments{red, green, blue};
+    m_list.append(DisplayList::Op::Fill, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const DisplayList::RegionArguments arguments{x, y, width, height, red, green, blue, true};
+    m_list.append(DisplayList::Op::FillRegion, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const DisplayList::LineArguments arguments{x0, y, x1, y, red, green, blue};
+    m_list.append(DisplayList::Op::DrawSpan, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::blit(const uint8_t *rgb, int stride, int x, int y, int width, int height)
+{
+    recordBlock(DisplayList::Op::Blit, rgb, stride, 3, nullptr, 0, x, y, width, height);
+}
+
+void RecordingCanvas::blitMasked(const uint8_t *rgb, int stride, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    recordBlock(DisplayList::Op::BlitMasked, rgb, stride, 3, mask, mask_stride, x, y, width, height);
+}
+
+void RecordingCanvas::setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    if(x < 0 || x >= m_width || y < 0 || y >= m_height || alpha == 0) {
+        return;
+    }
+    const DisplayList::PixelArguments arguments{x, y, red, green, blue, alpha};
+    m_list.append(DisplayList::Op::SetPixelRGBA, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::blendBlit(const uint8_t *rgba, int stride, int x, int y, int width, int height)
+{
+    recordBlock(DisplayList::Op::BlendBlit, rgba, stride, 4, nullptr, 0, x, y, width, height);
+}
+
+void RecordingCanvas::drawLine(int x1, int y1, int x2, int y2, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const DisplayList::LineArguments arguments{x1, y1, x2, y2, red, green, blue};
+    m_list.append(DisplayList::Op::DrawLine, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::drawPolygon(const std::vector<std::pair<int, int>> &points, uint8_t red, uint8_t green, uint8_t blue, bool fill)
+{
+    if(points.size() < 2) {
+        return;
+    }
+    const DisplayList::PolygonArguments arguments{static_cast<uint32_t>(points.size()), red, green, blue, fill};
+    uint8_t * coordinates = m_list.append(DisplayList::Op::DrawPolygon, &arguments, sizeof(arguments), points.size() * 2 * sizeof(int32_t));
+    for(const auto& [x, y] : points) {
+        const int32_t point[2] = {x, y};
+        std::memcpy(coordinates, point, sizeof(point));
+        coordinates += sizeof(point);
+    }
+}
+
+void RecordingCanvas::drawEllipse(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue, bool fill)
+{
+    const DisplayList::RegionArguments arguments{x, y, width, height, red, green, blue, fill};
+    m_list.append(DisplayList::Op::DrawEllipse, &arguments, sizeof(arguments));
+}
+
+void RecordingCanvas::recordBlock(DisplayList::Op op, const uint8_t *pixels, int stride, int bytes_per_pixel, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const std::size_t row_bytes = static_cast<std::size_t>(clip->width) * bytes_per_pixel;
+    const std::size_t pixel_bytes = row_bytes * clip->height;
+    const std::size_t mask_bytes = mask != nullptr ? static_cast<std::size_t>(clip->width) * clip->height : 0;
+    const DisplayList::RegionArguments arguments{clip->dst_x, clip->dst_y, clip->width, clip->height, 0, 0, 0, false};
+    uint8_t * data = m_list.append(op, &arguments, sizeof(arguments), pixel_bytes + mask_bytes);
+    for(int j = 0; j < clip->height; ++j) {
+        const uint8_t * row = pixels + (clip->src_y + j) * stride + clip->src_x * bytes_per_pixel;
+        std::memcpy(data + j * row_bytes, row, row_bytes);
+    }
+    if(mask != nullptr) {
+        uint8_t * mask_data = data + pixel_bytes;
+        for(int j = 0; j < clip->height; ++j) {
+            std::memcpy(mask_data + j * clip->width, mask + (clip->src_y + j) * mask_stride + clip->src_x, clip->width);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include <protogen/presentation/ScalingRenderSurface.h>
+
+#include <charconv>
+
+namespace protogen {
+
+ScalingRenderSurface::ScalingRenderSurface(std::shared_ptr<IRenderSurface> surface, Resolution logical_resolution, ImageScaler::Filter filter)
+    : m_surface(surface),
+    m_logicalResolution(logical_resolution),
+    m_logical(logical_resolution),
+    m_physical(surface->resolution()),
+    m_scaler(m_logical.width(), m_logical.height(), m_physical.width(), m_physical.height(), filter)
+{
+}
+
+IRenderSurface::Initialization ScalingRenderSurface::initialize()
+{
+    return Initialization::Success;
+}
+
+void ScalingRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    m_logical.fill(0, 0, 0);
+    drawer(m_logical);
+    m_scaler.scale(m_logical, m_physical);
+    m_surface->drawFrame([this](ICanvas& canvas){
+        m_physical.copyTo(canvas);
+    });
+}
+
+Resolution ScalingRenderSurface::resolution() const
+{
+    return m_logicalResolution;
+}
+
+std::optional<std::string> ScalingRenderSurface::getAttribute(const std::string &key) const
+{
+    return m_surface->getAttribute(key);
+}
+
+std::vector<std::string> ScalingRenderSurface::listAttributes() const
+{
+    return m_surface->listAttributes();
+}
+
+attributes::IWritableAttributeStore::SetAttributeResult ScalingRenderSurface::setAttribute(const std::string &key, const std::string &value)
+{
+    return m_surface->setAttribute(key, value);
+}
+
+attributes::IWritableAttributeStore::RemoveAttributeResult ScalingRenderSurface::removeAttribute(const std::string &key)
+{
+    return m_surface->removeAttribute(key);
+}
+
+bool ScalingRenderSurface::hasAttribute(const std::string &key) const
+{
+    return m_surface->hasAttribute(key);
+}
+
+std::optional<Resolution> ScalingRenderSurface::parseResolution(const std::string &resolution)
+{
+    const auto separator = resolution.find('x');
+    if(separator == std::string::npos) {
+        return {};
+    }
+    unsigned int width = 0;
+    unsigned int height = 0;
+    const char * begin = resolution.data();
+    const char * end = begin + resolution.size();
+    const auto width_result = std::from_chars(begin, begin + separator, width);
+    const auto height_result = std::from_chars(begin + separator + 1, end, height);
+    if(width_result.ec != std::errc() || width_result.ptr != begin + separator
+        || height_result.ec != std::errc() || height_result.ptr != end
+        || width == 0 || height == 0) {
+        return {};
+    }
+    return Resolution(width, height);
+}
+
+std::optional<ImageScaler::Filter> ScalingRenderSurface::parseFilter(const std::string &filter)
+{
+    if(filter == "nearest") {
+        return ImageScaler::Filter::Nearest;
+    }
+    if(filter == "bilinear") {
+        return ImageScaler::Filter::Bilinear;
+    }
+    return {};
+}
+
+} // namespace
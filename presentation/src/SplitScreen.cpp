@@ -0,0 +1,137 @@
+#include <protogen/presentation/SplitScreen.h>
+#include <protogen/presentation/Rect.h>
+
+#include <protogen/StandardAttributeStore.hpp>
+#include <protogen/StandardAttributes.hpp>
+
+#include <string>
+
+namespace protogen {
+
+namespace {
+
+Rect toRect(const Window& window)
+{
+    return Rect{window.top_left_x, window.top_left_y, static_cast<int>(window.size.width()), static_cast<int>(window.size.height())};
+}
+
+} // namespace
+
+class SplitScreen::WindowRenderSurface : public IRenderSurface {
+public:
+    WindowRenderSurface(std::shared_ptr<SplitScreen> split_screen, const Window& window, std::size_t index)
+        : m_splitScreen(split_screen),
+        m_window(window),
+        m_frame(window.size),
+        m_attributes(new StandardAttributeStore())
+    {
+        const auto& parent = m_splitScreen->m_parent;
+        const std::string number = std::to_string(index + 1);
+        m_attributes->setAttribute(attributes::A_ID, parent->getAttribute(attributes::A_ID).value_or("split_screen") + "_window_" + number);
+        m_attributes->setAttribute(attributes::A_NAME, "Window " + number + " of " + parent->getAttribute(attributes::A_NAME).value_or("Split Screen"));
+        m_attributes->setAttribute(attributes::A_DESCRIPTION, "Part of a render surface which is split into windows drawn independently.");
+    }
+
+    Initialization initialize() override {
+        return Initialization::Success;
+    }
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override {
+        m_frame.fill(0, 0, 0);
+        drawer(m_frame);
+        m_splitScreen->present(m_window, m_frame);
+    }
+    Resolution resolution() const override {
+        return m_window.size;
+    }
+
+    std::optional<std::string> getAttribute(const std::string& key) const override {
+        return m_attributes->getAttribute(key);
+    }
+    std::vector<std::string> listAttributes() const override {
+        return m_attributes->listAttributes();
+    }
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override {
+        return m_attributes->setAttribute(key, value);
+    }
+    RemoveAttributeResult removeAttribute(const std::string& key) override {
+        return m_attributes->removeAttribute(key);
+    }
+    bool hasAttribute(const std::string& key) const override {
+        return m_attributes->hasAttribute(key);
+    }
+
+private:
+    std::shared_ptr<SplitScreen> m_splitScreen;
+    Window m_window;
+    MemoryCanvas m_frame; // Only used by the thread drawing this window.
+    std::shared_ptr<attributes::IAttributeStore> m_attributes;
+};
+
+std::shared_ptr<SplitScreen> SplitScreen::make(std::shared_ptr<IRenderSurface> parent)
+{
+    return std::shared_ptr<SplitScreen>(new SplitScreen(parent));
+}
+
+SplitScreen::SplitScreen(std::shared_ptr<IRenderSurface> parent)
+    : m_parent(parent),
+    m_mutex(),
+    m_frame(parent->resolution()),
+    m_windows(),
+    m_pending(false),
+    m_presenting(false)
+{
+    m_frame.fill(0, 0, 0);
+}
+
+std::optional<std::shared_ptr<IRenderSurface>> SplitScreen::addWindow(const Window &window)
+{
+    const Rect rect = toRect(window);
+    if(rect.empty() || !Rect{0, 0, m_frame.width(), m_frame.height()}.contains(rect)) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(const auto& other : m_windows) {
+        if(!rect.intersected(toRect(other)).empty()) {
+            return {};
+        }
+    }
+    m_windows.push_back(window);
+    return std::shared_ptr<IRenderSurface>(new WindowRenderSurface(shared_from_this(), window, m_windows.size() - 1));
+}
+
+void SplitScreen::present(const Window &window, const MemoryCanvas &frame)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frame.copyFrom(frame, window.top_left_x, window.top_left_y);
+    m_pending = true;
+    if(m_presenting) {
+        // The window presenting right now shows this frame as well.
+        return;
+    }
+    m_presenting = true;
+    while(m_pending) {
+        m_pending = false;
+        lock.unlock();
+        try
+        {
+            // The parent starts every frame black, and only windows are drawn.
+            m_parent->drawFrame([this](ICanvas& canvas){
+                std::lock_guard<std::mutex> frame_lock(m_mutex);
+                for(const auto& window : m_windows) {
+                    m_frame.copyTo(canvas, toRect(window));
+                }
+            });
+        }
+        catch(...)
+        {
+            // Let the next window present again.
+            lock.lock();
+            m_presenting = false;
+            throw;
+        }
+        lock.lock();
+    }
+    m_presenting = false;
+}
+
+} // namespace
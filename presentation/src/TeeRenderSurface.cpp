@@ -0,0 +1,132 @@
+#include <protogen/presentation/TeeRenderSurface.h>
+#include <protogen/presentation/RecordingCanvas.h>
+
+namespace protogen {
+
+TeeRenderSurface::TeeRenderSurface(std::shared_ptr<IRenderSurface> surface)
+    : m_surface(surface),
+    m_width(static_cast<int>(surface->resolution().width())),
+    m_height(static_cast<int>(surface->resolution().height())),
+    m_producerMutex(),
+    m_frameNumber(0),
+    m_everyFrameSinks(),
+    m_latestSinks(),
+    m_frames(),
+    m_framesPublished(0),
+    m_stopping(false)
+{
+}
+
+TeeRenderSurface::~TeeRenderSurface()
+{
+    stopConsumer();
+}
+
+void TeeRenderSurface::addSink(std::shared_ptr<Sink> sink, Delivery delivery)
+{
+    if(delivery == Delivery::EveryFrame) {
+        m_everyFrameSinks.push_back(sink);
+        return;
+    }
+    // The consumer thread only reads the sinks once it was started.
+    stopConsumer();
+    m_latestSinks.push_back(sink);
+    m_stopping = false;
+    m_consumerThread = std::thread(&TeeRenderSurface::consumerLoop, this);
+}
+
+void TeeRenderSurface::stopConsumer()
+{
+    m_stopping = true;
+    m_framesPublished.fetch_add(1);
+    m_framesPublished.notify_all();
+    if(m_consumerThread.joinable()) {
+        m_consumerThread.join();
+    }
+}
+
+IRenderSurface::Initialization TeeRenderSurface::initialize()
+{
+    return Initialization::Success;
+}
+
+void TeeRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    if(m_everyFrameSinks.empty() && m_latestSinks.empty()) {
+        m_surface->drawFrame(drawer);
+        return;
+    }
+
+    // The consumer thread never takes this lock; it only keeps drawing
+    // threads from recording into the same back slot.
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    RecordedFrame& frame = m_frames.back();
+    frame.list.clear();
+    RecordingCanvas recorder(frame.list, m_width, m_height);
+    drawer(recorder);
+    frame.completed_at = std::chrono::steady_clock::now();
+    frame.frame_number = ++m_frameNumber;
+    m_surface->drawFrame([&frame](ICanvas& canvas){
+        frame.list.replay(canvas);
+    });
+    for(const auto& sink : m_everyFrameSinks) {
+        sink->consumeFrame(frame);
+    }
+
+    if(!m_latestSinks.empty()) {
+        m_frames.publish();
+        m_framesPublished.fetch_add(1);
+        m_framesPublished.notify_one();
+    }
+}
+
+void TeeRenderSurface::consumerLoop()
+{
+    while(true) {
+        // Read the counter before looking for a frame, so a frame published
+        // in between wakes the wait up.
+        const uint32_t published = m_framesPublished.load();
+        if(m_stopping) {
+            return;
+        }
+        if(!m_frames.acquire()) {
+            m_framesPublished.wait(published);
+            continue;
+        }
+        for(const auto& sink : m_latestSinks) {
+            sink->consumeFrame(m_frames.front());
+        }
+    }
+}
+
+Resolution TeeRenderSurface::resolution() const
+{
+    return m_surface->resolution();
+}
+
+std::optional<std::string> TeeRenderSurface::getAttribute(const std::string &key) const
+{
+    return m_surface->getAttribute(key);
+}
+
+std::vector<std::string> TeeRenderSurface::listAttributes() const
+{
+    return m_surface->listAttributes();
+}
+
+attributes::IWritableAttributeStore::SetAttributeResult TeeRenderSurface::setAttribute(const std::string &key, const std::string &value)
+{
+    return m_surface->setAttribute(key, value);
+}
+
+attributes::IWritableAttributeStore::RemoveAttributeResult TeeRenderSurface::removeAttribute(const std::string &key)
+{
+    return m_surface->removeAttribute(key);
+}
+
+bool TeeRenderSurface::hasAttribute(const std::string &key) const
+{
+    return m_surface->hasAttribute(key);
+}
+
+} // namespace
@@ -0,0 +1,116 @@
+#include <protogen/presentation/WorkStealingPool.h>
+
+#include <algorithm>
+
+namespace protogen {
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+    : m_queues(),
+    m_workers(),
+    m_task(nullptr),
+    m_remaining(0),
+    m_generation(0),
+    m_stopping(false)
+{
+    threads = std::max<std::size_t>(threads, 1);
+    for(std::size_t i = 0; i < threads; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for(std::size_t i = 1; i < threads; ++i) {
+        m_workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for(auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::size_t WorkStealingPool::size() const
+{
+    return m_queues.size();
+}
+
+void WorkStealingPool::parallelFor(std::size_t count, const std::function<void(std::size_t)> &task)
+{
+    if(count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> call_lock(m_callMutex);
+    m_task = &task;
+    m_remaining = count;
+    // Deal the iterations out in contiguous blocks so neighbouring
+    // iterations, which tend to touch neighbouring memory, stay together.
+    const std::size_t per_queue = (count + m_queues.size() - 1) / m_queues.size();
+    for(std::size_t q = 0; q < m_queues.size(); ++q) {
+        std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+        for(std::size_t i = q * per_queue; i < std::min(count, (q + 1) * per_queue); ++i) {
+            m_queues[q]->iterations.push_back(i);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+    }
+    m_workAvailable.notify_all();
+
+    while(runOne(0)) {
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workDone.wait(lock, [this]{ return m_remaining == 0; });
+    m_task = nullptr;
+}
+
+bool WorkStealingPool::runOne(std::size_t self)
+{
+    for(std::size_t k = 0; k < m_queues.size(); ++k) {
+        Queue& queue = *m_queues[(self + k) % m_queues.size()];
+        std::size_t iteration;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.iterations.empty()) {
+                continue;
+            }
+            if(k == 0) {
+                iteration = queue.iterations.front();
+                queue.iterations.pop_front();
+            } else {
+                iteration = queue.iterations.back();
+                queue.iterations.pop_back();
+            }
+        }
+        (*m_task)(iteration);
+        if(--m_remaining == 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_workDone.notify_all();
+        }
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t self)
+{
+    uint64_t seen_generation = 0;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [&]{ return m_stopping || m_generation != seen_generation; });
+            if(m_stopping) {
+                return;
+            }
+            seen_generation = m_generation;
+        }
+        while(runOne(self)) {
+        }
+    }
+}
+
+} // namespace
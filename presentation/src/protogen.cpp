@@ -2,22 +2,59 @@
 
 #include <protogen/StandardAttributeStore.hpp>
 #include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/DirtyTrackingCanvas.h>
+#include <protogen/presentation/RecordingCanvas.h>
+#include <protogen/presentation/PixelKernels.h>
 
 #include <iostream>
+#include <chrono>
+#include <bit>
+#include <cstdlib>
 
 namespace protogen {
 
 ProtogenHeadMatrices::ProtogenHeadMatrices()
     : m_whichProtogenFrameBufferIsUsed(0),
+    m_frames(),
+    m_framesPublished(0),
+    m_producerMutex(),
+    m_stopping(false),
+    m_droppedFrames(0),
+    m_timings(),
+    m_frame(resolution()),
+    m_drawnLastFrame(),
+    m_changedLastFrame(),
+    m_powerGovernor(),
+    m_brightnessLut(),
+    m_brightness(255),
+    m_brightnessChanged(false),
+    m_brightnessChangedLastFrame(false),
     m_attributes(new StandardAttributeStore())
 {
+    for(int value = 0; value < 256; ++value) {
+        m_brightnessLut[value] = static_cast<uint8_t>(value);
+    }
+    if(const char * budget_string = std::getenv(ENV_VAR_POWER_BUDGET)) {
+        auto config = PowerGovernor::DEFAULT_CONFIG;
+        config.budget_ma = std::atof(budget_string);
+        m_powerGovernor = PowerGovernor(config);
+    }
+
     m_attributes->setAttribute(attributes::A_ID, "hub75_display");
     m_attributes->setAttribute(attributes::A_NAME, "HUB75 Display");
     m_attributes->setAttribute(attributes::A_DESCRIPTION, "Implements support for HUB75 LED matrices. Many RGB LED matrices use the HUB75 interface.");
+    m_attributes->setAttribute(attributes::A_AUTHOR, "mrf7777");
+    m_timings = FrameMetrics::global().addInstance(FrameMetrics::Source::Surface, *m_attributes->getAttribute(attributes::A_ID));
 };
 
 ProtogenHeadMatrices::~ProtogenHeadMatrices()
 {
+    m_stopping = true;
+    m_framesPublished.fetch_add(1);
+    m_framesPublished.notify_all();
+    if(m_renderThread.joinable()) {
+        m_renderThread.join();
+    }
     if(m_matrix) {
         m_matrix->Clear();
     }
@@ -36,7 +73,8 @@ IRenderSurface::Initialization ProtogenHeadMatrices::initialize()
         options.chain_length = 2;
         options.brightness = 100;
         options.hardware_mapping = "adafruit-hat";
-        options.led_rgb_sequence = "RBG";
+        // m_frame is already stored in the panels' RBG order.
+        options.led_rgb_sequence = "RGB";
 
         rgb_matrix::RuntimeOptions runtime_opts;
         runtime_opts.drop_privileges = -1;
@@ -54,6 +92,7 @@ IRenderSurface::Initialization ProtogenHeadMatrices::initialize()
 
         m_protogenFrameBuffer0 = m_matrix->CreateFrameCanvas();
         m_protogenFrameBuffer1 = m_matrix->CreateFrameCanvas();
+        m_renderThread = std::thread(&ProtogenHeadMatrices::renderLoop, this);
         return Initialization::Success;
     }
     catch(const std::exception& e)
@@ -84,12 +123,124 @@ rgb_matrix::FrameCanvas *ProtogenHeadMatrices::getNextProtogenFrameBuffer()
 }
 
 void ProtogenHeadMatrices::drawFrame(const std::function<void(ICanvas&)>& drawer) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto frame = getNextProtogenFrameBuffer();
-    frame->Clear();
-    RgbMatrixCanvasToICanvasAdapter canvas(frame);
+    if(!m_renderThread.joinable() || m_stopping) {
+        return;
+    }
+
+    // The render thread never takes this lock; it only keeps callers on
+    // different threads from recording into the same back slot.
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    const auto drawer_start = std::chrono::steady_clock::now();
+    RecordedFrame& frame = m_frames.back();
+    frame.list.clear();
+    RecordingCanvas canvas(frame.list, resolution().width(), resolution().height());
     drawer(canvas);
+    frame.completed_at = std::chrono::steady_clock::now();
+    const auto drawer_time = std::chrono::duration_cast<std::chrono::microseconds>(frame.completed_at - drawer_start);
+    m_attributes->setAttribute(attributes::A_DRAWER_TIME, std::to_string(drawer_time.count()));
+    m_timings->recordFrame(drawer_start, frame.completed_at - drawer_start);
+
+    if(m_frames.publish()) {
+        ++m_droppedFrames;
+        m_timings->recordMissedDeadline();
+        m_attributes->setAttribute(attributes::A_DROPPED_FRAMES, std::to_string(m_droppedFrames));
+    }
+    m_framesPublished.fetch_add(1);
+    m_framesPublished.notify_one();
+}
+
+void ProtogenHeadMatrices::renderLoop()
+{
+    while(true) {
+        // Read the counter before looking for a frame, so a frame published
+        // in between wakes the wait up.
+        const uint32_t published = m_framesPublished.load();
+        if(m_stopping) {
+            return;
+        }
+        if(!m_frames.acquire()) {
+            m_framesPublished.wait(published);
+            continue;
+        }
+
+        const RecordedFrame& frame = m_frames.front();
+        const auto present_start = std::chrono::steady_clock::now();
+        presentFrame(frame.list);
+        const auto presented_at = std::chrono::steady_clock::now();
+        const auto present_time = std::chrono::duration_cast<std::chrono::microseconds>(presented_at - present_start);
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(presented_at - frame.completed_at);
+        m_attributes->setAttribute(attributes::A_PRESENT_TIME, std::to_string(present_time.count()));
+        m_timings->recordPresent(presented_at - present_start);
+        m_attributes->setAttribute(attributes::A_FRAME_LATENCY, std::to_string(latency.count()));
+    }
+}
+
+void ProtogenHeadMatrices::presentFrame(const DisplayList& list)
+{
+    auto frame = getNextProtogenFrameBuffer();
+
+    // Every frame starts black, and only what the previous frame touched
+    // can be anything else.
+    for(const auto& rect : m_drawnLastFrame.rects()) {
+        m_frame.fillRegion(rect.x, rect.y, rect.width, rect.height, 0, 0, 0);
+    }
+    DirtyTrackingCanvas canvas(m_frame, true);
+    list.replay(canvas);
+
+    DirtyRegion changed = m_drawnLastFrame;
+    changed.add(canvas.dirtyRegion());
+    limitPower();
+    // `frame` was last shown two frames ago, so it misses the changes of
+    // the previous frame as well. Pixels already in `frame` have the
+    // brightness they were copied with, so all of them are copied again
+    // until both frame buffers have the new brightness.
+    DirtyRegion to_copy = changed;
+    to_copy.add(m_changedLastFrame);
+    if(m_brightnessChanged || m_brightnessChangedLastFrame) {
+        to_copy.add(Rect{0, 0, m_frame.width(), m_frame.height()});
+    }
+    const auto& lut = m_brightnessLut;
+    for(const auto& rect : to_copy.rects()) {
+        for(int y = rect.y; y < rect.y + rect.height; ++y) {
+            const auto * row = m_frame.row(y);
+            for(int x = rect.x; x < rect.x + rect.width; ++x) {
+                frame->SetPixel(x, y, lut[PanelFormat::byte(row[x], 0)], lut[PanelFormat::byte(row[x], 1)], lut[PanelFormat::byte(row[x], 2)]);
+            }
+        }
+    }
     m_matrix->SwapOnVSync(frame);
+
+    m_drawnLastFrame = canvas.dirtyRegion();
+    m_changedLastFrame = changed;
+    m_brightnessChangedLastFrame = m_brightnessChanged;
+    m_attributes->setAttribute(attributes::A_DIRTY_AREA, std::to_string(changed.area()));
+}
+
+void ProtogenHeadMatrices::limitPower()
+{
+    // Pixels are 32 bits with the panel channels in the low three bytes.
+    // The kernel sums bytes in memory order.
+    const auto memory_byte = [](int byte){
+        return std::endian::native == std::endian::little ? byte : 3 - byte;
+    };
+    uint64_t totals[4] = {0, 0, 0, 0};
+    pixel_kernels::kernels().sumChannels(m_frame.row(0), static_cast<std::size_t>(m_frame.width()) * m_frame.height(), totals);
+    const double full_brightness_ma = m_powerGovernor.estimateMilliamps(
+        totals[memory_byte(PanelFormat::RED_BYTE)],
+        totals[memory_byte(PanelFormat::GREEN_BYTE)],
+        totals[memory_byte(PanelFormat::BLUE_BYTE)]
+    );
+    const uint8_t brightness = m_powerGovernor.update(full_brightness_ma);
+
+    m_brightnessChanged = brightness != m_brightness;
+    if(m_brightnessChanged) {
+        m_brightness = brightness;
+        for(int value = 0; value < 256; ++value) {
+            m_brightnessLut[value] = static_cast<uint8_t>((value * brightness + 127) / 255);
+        }
+    }
+    m_attributes->setAttribute(attributes::A_ESTIMATED_POWER, std::to_string(static_cast<long>(m_powerGovernor.milliwatts())));
+    m_attributes->setAttribute(attributes::A_BRIGHTNESS_LIMIT, std::to_string(brightness * 100 / 255));
 }
 
 Resolution ProtogenHeadMatrices::resolution() const
@@ -122,34 +273,4 @@ bool ProtogenHeadMatrices::hasAttribute(const std::string &key) const
     return m_attributes->hasAttribute(key);
 }
 
-RgbMatrixCanvasToICanvasAdapter::RgbMatrixCanvasToICanvasAdapter(rgb_matrix::Canvas *canvas)
-    : mCanvas(canvas)
-{
-}
-
-int RgbMatrixCanvasToICanvasAdapter::width() const
-{
-    return mCanvas->width();
-}
-
-int RgbMatrixCanvasToICanvasAdapter::height() const
-{
-    return mCanvas->height();
-}
-
-void RgbMatrixCanvasToICanvasAdapter::setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue)
-{
-    mCanvas->SetPixel(x, y, red, green, blue);
-}
-
-void RgbMatrixCanvasToICanvasAdapter::clear()
-{
-    mCanvas->Clear();
-}
-
-void RgbMatrixCanvasToICanvasAdapter::fill(uint8_t red, uint8_t green, uint8_t blue)
-{
-    mCanvas->Fill(red, green, blue);
-}
-
 }   // namespace
\ No newline at end of file
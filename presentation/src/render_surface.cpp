@@ -0,0 +1,200 @@
+#include <protogen/presentation/render_surface.h>
+#include <protogen/presentation/ScalingRenderSurface.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace protogen {
+
+namespace {
+
+/**
+ * Has a size and discards everything drawn on it.
+ */
+class DiscardingCanvas : public ICanvas {
+public:
+    explicit DiscardingCanvas(Resolution resolution)
+        : m_width(resolution.width()), m_height(resolution.height())
+    {
+    }
+
+    int width() const override { return m_width; }
+    int height() const override { return m_height; }
+    void setPixel(int, int, uint8_t, uint8_t, uint8_t) override {}
+    void clear() override {}
+    void fill(uint8_t, uint8_t, uint8_t) override {}
+    void fillRegion(int, int, int, int, uint8_t, uint8_t, uint8_t) override {}
+    void drawSpan(int, int, int, uint8_t, uint8_t, uint8_t) override {}
+    void blit(const uint8_t*, int, int, int, int, int) override {}
+    void blitMasked(const uint8_t*, int, const uint8_t*, int, int, int, int, int) override {}
+    void setPixelRGBA(int, int, uint8_t, uint8_t, uint8_t, uint8_t) override {}
+    void blendBlit(const uint8_t*, int, int, int, int, int) override {}
+    void drawLine(int, int, int, int, uint8_t, uint8_t, uint8_t) override {}
+    void drawPolygon(const std::vector<std::pair<int, int>>&, uint8_t, uint8_t, uint8_t, bool) override {}
+    void drawEllipse(int, int, int, int, uint8_t, uint8_t, uint8_t, bool) override {}
+
+private:
+    int m_width;
+    int m_height;
+};
+
+} // namespace
+
+void FakeRenderSurface::Report::print(std::ostream &out) const
+{
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    const double frame_count = frames == 0 ? 1.0 : static_cast<double>(frames);
+    const auto micros = [](uint64_t nanoseconds) {
+        return nanoseconds / 1000.0;
+    };
+    out << std::fixed << std::setprecision(1);
+    out << "Fake render surface " << resolution.width() << "x" << resolution.height() << ", " << frames << " frames" << std::endl;
+    out << "  drawer time (us):"
+        << " mean " << drawer_time_ns.mean() / 1000.0
+        << " p50 " << micros(drawer_time_ns.percentile(50))
+        << " p90 " << micros(drawer_time_ns.percentile(90))
+        << " p99 " << micros(drawer_time_ns.percentile(99))
+        << " max " << micros(drawer_time_ns.max) << std::endl;
+    out << "  per frame: " << counts.totalCalls() / frame_count << " calls, "
+        << counts.spans / frame_count << " spans, "
+        << counts.pixels / frame_count << " pixels" << std::endl;
+    for(int i = 0; i < DrawCounts::PRIMITIVE_COUNT; ++i) {
+        const auto primitive = static_cast<DrawCounts::Primitive>(i);
+        if(counts.calls[primitive] != 0) {
+            out << "    " << std::setw(14) << std::left << DrawCounts::name(primitive) << std::right
+                << counts.calls[primitive] / frame_count << " calls" << std::endl;
+        }
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+FakeRenderSurface::FakeRenderSurface()
+    : FakeRenderSurface(Resolution(DEFAULT_WIDTH, DEFAULT_HEIGHT), 0, false)
+{
+}
+
+FakeRenderSurface::FakeRenderSurface(Resolution resolution, uint64_t report_interval, bool rasterize)
+    : m_attributes(new StandardAttributeStore()),
+    m_resolution(resolution),
+    m_reportInterval(report_interval),
+    m_rasterize(rasterize),
+    m_canvas(rasterize ? resolution : Resolution(0, 0)),
+    m_frameCounts(),
+    m_timings(),
+    m_countsMutex(),
+    m_counts(),
+    m_frames(0)
+{
+    setAttribute(attributes::A_ID, "fake_render_surface");
+    setAttribute(attributes::A_NAME, "Fake Render Surface");
+    setAttribute(attributes::A_DESCRIPTION, "A render surface without a display which measures what apps draw.");
+    setAttribute(attributes::A_AUTHOR, "mrf7777");
+    m_timings = FrameMetrics::global().addInstance(FrameMetrics::Source::Surface, *getAttribute(attributes::A_ID));
+}
+
+std::shared_ptr<FakeRenderSurface> FakeRenderSurface::fromEnvironment()
+{
+    Resolution resolution(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+    const char * resolution_env = std::getenv(ENV_VAR_RESOLUTION);
+    if(resolution_env != nullptr) {
+        const auto parsed = ScalingRenderSurface::parseResolution(resolution_env);
+        if(parsed.has_value()) {
+            resolution = parsed.value();
+        } else {
+            std::cerr << ENV_VAR_RESOLUTION << " has an invalid resolution `" << resolution_env << "`. The fake render surface is " << DEFAULT_WIDTH << "x" << DEFAULT_HEIGHT << " instead." << std::endl;
+        }
+    }
+    uint64_t report_interval = 0;
+    if(const char * report_env = std::getenv(ENV_VAR_REPORT_FRAMES)) {
+        report_interval = std::strtoull(report_env, nullptr, 10);
+    }
+    return std::make_shared<FakeRenderSurface>(resolution, report_interval, resolution_env != nullptr);
+}
+
+IRenderSurface::Initialization FakeRenderSurface::initialize()
+{
+    return Initialization::Success;
+}
+
+void FakeRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    m_frameCounts = DrawCounts();
+    const auto start = std::chrono::steady_clock::now();
+    if(m_rasterize) {
+        m_canvas.clear();
+        CountingCanvas canvas(m_canvas, m_frameCounts);
+        drawer(canvas);
+    } else {
+        DiscardingCanvas canvas(m_resolution);
+        drawer(canvas);
+    }
+    const auto drawer_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    m_timings->recordFrame(start, drawer_time);
+    uint64_t frames = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_countsMutex);
+        m_counts += m_frameCounts;
+        frames = ++m_frames;
+    }
+    m_attributes->setAttribute(attributes::A_DRAWER_TIME, std::to_string(drawer_time.count() / 1000));
+    m_attributes->setAttribute(attributes::A_PRESENTED_FRAMES, std::to_string(frames));
+    if(m_reportInterval != 0 && frames % m_reportInterval == 0) {
+        report().print(std::cout);
+    }
+}
+
+Resolution FakeRenderSurface::resolution() const
+{
+    return m_resolution;
+}
+
+std::optional<std::string> FakeRenderSurface::getAttribute(const std::string &key) const
+{
+    return m_attributes->getAttribute(key);
+}
+
+std::vector<std::string> FakeRenderSurface::listAttributes() const
+{
+    return m_attributes->listAttributes();
+}
+
+attributes::IWritableAttributeStore::SetAttributeResult FakeRenderSurface::setAttribute(const std::string &key, const std::string &value)
+{
+    return m_attributes->setAttribute(key, value);
+}
+
+attributes::IWritableAttributeStore::RemoveAttributeResult FakeRenderSurface::removeAttribute(const std::string &key)
+{
+    return m_attributes->removeAttribute(key);
+}
+
+bool FakeRenderSurface::hasAttribute(const std::string &key) const
+{
+    return m_attributes->hasAttribute(key);
+}
+
+FakeRenderSurface::Report FakeRenderSurface::report() const
+{
+    std::lock_guard<std::mutex> lock(m_countsMutex);
+    return Report{m_resolution, m_frames, m_counts, m_timings->snapshot().drawer_time};
+}
+
+void FakeRenderSurface::resetReport()
+{
+    std::lock_guard<std::mutex> lock(m_countsMutex);
+    m_counts = DrawCounts();
+    m_frames = 0;
+    m_timings->reset();
+}
+
+const MemoryCanvas& FakeRenderSurface::canvas() const
+{
+    return m_canvas;
+}
+
+} // namespace
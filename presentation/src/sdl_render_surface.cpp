@@ -1,9 +1,12 @@
 #include <protogen/presentation/sdl_render_surface.h>
 
 #include <protogen/StandardAttributeStore.hpp>
+#include <protogen/presentation/DirtyTrackingCanvas.h>
+#include <protogen/presentation/RecordingCanvas.h>
 
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 
 #include <SDL2/SDL.h>
 
@@ -11,51 +14,29 @@ namespace protogen {
 
 SdlRenderSurface::~SdlRenderSurface()
 {
-    SDL_Quit();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_frameReady.notify_all();
+    if(m_presentThread.joinable()) {
+        m_presentThread.join();
+    }
 }
 
 SdlRenderSurface::Initialization SdlRenderSurface::initialize()
 {
     try
     {
-        {
-            const int sdl_init_result = SDL_Init(SDL_INIT_VIDEO);
-            if(sdl_init_result) {
-                throw ConstructorException(SDL_GetError());
-            }
-        }
-
-        {
-            auto window = SDL_CreateWindow(
-                "Protogen Head",
-                SDL_WINDOWPOS_CENTERED,
-                SDL_WINDOWPOS_CENTERED,
-                m_resolution.width() * 8,
-                m_resolution.height() * 8,
-                SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
-            );
-            if(window == NULL) {
-                throw ConstructorException(SDL_GetError());
-            }
-            m_window = std::unique_ptr<SDL_Window, WindowDestroyer>(window);
-        }
-
-        {
-            auto renderer = SDL_CreateRenderer(
-                m_window.get(),
-                -1,
-                SDL_RENDERER_ACCELERATED
-            );
-            if(renderer == NULL) {
-                throw ConstructorException(SDL_GetError());
-            }
-            const auto set_logical_size_result = SDL_RenderSetLogicalSize(renderer, m_resolution.width(), m_resolution.height());
-            if(set_logical_size_result) {
-                throw ConstructorException(SDL_GetError());
-            }
-            m_renderer = std::unique_ptr<SDL_Renderer, RendererDestroyer>(renderer);
+        std::promise<void> created;
+        auto window_created = created.get_future();
+        m_presentThread = std::thread(&SdlRenderSurface::presentLoop, this, std::move(created));
+        try {
+            window_created.get();
+        } catch(...) {
+            m_presentThread.join();
+            throw;
         }
-
         return Initialization::Success;
     }
     catch(const std::exception& e)
@@ -72,12 +53,238 @@ SdlRenderSurface::Initialization SdlRenderSurface::initialize()
     }
 }
 
-void SdlRenderSurface::drawFrame([[maybe_unused]] const std::function<void(ICanvas &)> &drawer)
+void SdlRenderSurface::createWindow()
+{
+    {
+        const int sdl_init_result = SDL_Init(SDL_INIT_VIDEO);
+        if(sdl_init_result) {
+            throw ConstructorException(SDL_GetError());
+        }
+    }
+
+    {
+        auto window = SDL_CreateWindow(
+            "Protogen Head",
+            SDL_WINDOWPOS_CENTERED,
+            SDL_WINDOWPOS_CENTERED,
+            m_resolution.width() * 8,
+            m_resolution.height() * 8,
+            SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
+        );
+        if(window == NULL) {
+            throw ConstructorException(SDL_GetError());
+        }
+        m_window = std::unique_ptr<SDL_Window, WindowDestroyer>(window);
+    }
+
+    {
+        // Without a target frame rate, presentation is paced by vsync.
+        auto renderer = SDL_CreateRenderer(
+            m_window.get(),
+            -1,
+            SDL_RENDERER_ACCELERATED | (m_targetFps == 0 ? SDL_RENDERER_PRESENTVSYNC : 0)
+        );
+        if(renderer == NULL) {
+            throw ConstructorException(SDL_GetError());
+        }
+        const auto set_logical_size_result = SDL_RenderSetLogicalSize(renderer, m_resolution.width(), m_resolution.height());
+        if(set_logical_size_result) {
+            throw ConstructorException(SDL_GetError());
+        }
+        m_renderer = std::unique_ptr<SDL_Renderer, RendererDestroyer>(renderer);
+    }
+
+    {
+        // RGBA32 is the byte order of MemoryCanvas on every platform, so
+        // rows are uploaded without conversion.
+        auto texture = SDL_CreateTexture(
+            m_renderer.get(),
+            SDL_PIXELFORMAT_RGBA32,
+            SDL_TEXTUREACCESS_STREAMING,
+            m_resolution.width(),
+            m_resolution.height()
+        );
+        if(texture == NULL) {
+            throw ConstructorException(SDL_GetError());
+        }
+        m_texture = std::unique_ptr<SDL_Texture, TextureDestroyer>(texture);
+        // Frames are already composited and premultiplied; blending them
+        // again would darken translucent and cleared pixels.
+        if(SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE)) {
+            throw ConstructorException(SDL_GetError());
+        }
+    }
+
+    if(m_targetFps > 0) {
+        m_framePeriod = std::chrono::nanoseconds(1000000000 / m_targetFps);
+    } else {
+        SDL_DisplayMode mode;
+        const int display = SDL_GetWindowDisplayIndex(m_window.get());
+        const int refresh_rate = display >= 0 && SDL_GetCurrentDisplayMode(display, &mode) == 0 && mode.refresh_rate > 0 ? mode.refresh_rate : DEFAULT_REFRESH_RATE;
+        m_framePeriod = std::chrono::nanoseconds(1000000000 / refresh_rate);
+    }
+}
+
+void SdlRenderSurface::destroyWindow()
 {
-    SdlRendererToICanvasAdapter canvas(m_renderer.get(), m_resolution.width(), m_resolution.height());
-    canvas.clear();
-    drawer(canvas);
-    SDL_RenderPresent(m_renderer.get());
+    // SDL objects must be destroyed before SDL shuts down.
+    m_texture.reset();
+    m_renderer.reset();
+    m_window.reset();
+    SDL_Quit();
+}
+
+void SdlRenderSurface::drawFrame(const std::function<void(ICanvas &)> &drawer)
+{
+    if(!m_presentThread.joinable() || m_closed) {
+        return;
+    }
+
+    const auto drawer_start = std::chrono::steady_clock::now();
+    DirtyRegion changed;
+    if(m_bandedRenderer) {
+        m_displayList.clear();
+        RecordingCanvas recorder(m_displayList, m_resolution.width(), m_resolution.height());
+        drawer(recorder);
+        m_frame->clear();
+        m_bandedRenderer->render(m_displayList, *m_frame);
+        // Bands may touch any row, so the whole frame is handed off.
+        changed.add(Rect{0, 0, m_frame->width(), m_frame->height()});
+    } else {
+        // Every frame starts black, and only what the previous frame touched
+        // can be anything else.
+        for(const auto& rect : m_drawnLastFrame.rects()) {
+            m_frame->fillRegion(rect.x, rect.y, rect.width, rect.height, 0, 0, 0);
+        }
+        DirtyTrackingCanvas canvas(*m_frame, true);
+        drawer(canvas);
+        changed = m_drawnLastFrame;
+        changed.add(canvas.dirtyRegion());
+        m_drawnLastFrame = canvas.dirtyRegion();
+    }
+    m_timings->recordFrame(drawer_start, std::chrono::steady_clock::now() - drawer_start);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_hasPendingFrame) {
+            // The present thread has not shown the previous frame yet; it is
+            // replaced, but its changes are still uploaded with this one.
+            ++m_droppedFrames;
+            m_attributes->setAttribute(attributes::A_DROPPED_FRAMES, std::to_string(m_droppedFrames));
+        }
+        for(const auto& rect : changed.rects()) {
+            m_frame->copyTo(*m_pending, rect);
+        }
+        m_pendingRegion.add(changed);
+        m_hasPendingFrame = true;
+        m_pendingCompletedAt = std::chrono::steady_clock::now();
+    }
+    m_frameReady.notify_one();
+    m_attributes->setAttribute(attributes::A_DIRTY_AREA, std::to_string(changed.area()));
+}
+
+void SdlRenderSurface::presentLoop(std::promise<void> window_created)
+{
+    try {
+        createWindow();
+    } catch(...) {
+        destroyWindow();
+        window_created.set_exception(std::current_exception());
+        return;
+    }
+    window_created.set_value();
+
+    auto next_present = std::chrono::steady_clock::now();
+    while(true) {
+        if(!pumpEvents()) {
+            m_closed = true;
+            const std::string name = m_attributes->getAttribute(attributes::A_NAME).value_or("<no name>");
+            std::cerr << "The window of render surface \"" << name << "\" was closed. Frames are no longer shown." << std::endl;
+            break;
+        }
+
+        std::chrono::steady_clock::time_point completed_at;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // Wake up regularly without new frames to keep the window
+            // responsive.
+            m_frameReady.wait_for(lock, EVENT_POLL_INTERVAL, [this]{ return m_hasPendingFrame || m_stopping; });
+            if(m_stopping) {
+                break;
+            }
+            if(!m_hasPendingFrame) {
+                continue;
+            }
+        }
+
+        if(m_targetFps > 0) {
+            std::this_thread::sleep_until(next_present);
+        }
+
+        const auto present_start = std::chrono::steady_clock::now();
+        {
+            // Frames completed while waiting for the deadline are picked up
+            // here, so the newest one is shown.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            uploadPendingFrame();
+            m_hasPendingFrame = false;
+            completed_at = m_pendingCompletedAt;
+        }
+        // The texture covers the logical size; clearing keeps the letterbox
+        // bars black when the window's aspect ratio differs.
+        SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(m_renderer.get());
+        SDL_RenderCopy(m_renderer.get(), m_texture.get(), NULL, NULL);
+        SDL_RenderPresent(m_renderer.get());
+
+        const auto presented_at = std::chrono::steady_clock::now();
+        // Includes waiting for vsync, but not for the frame rate deadline.
+        m_timings->recordPresent(presented_at - present_start);
+        ++m_presentedFrames;
+        m_attributes->setAttribute(attributes::A_PRESENTED_FRAMES, std::to_string(m_presentedFrames));
+        if(presented_at - completed_at > m_framePeriod) {
+            ++m_lateFrames;
+            m_timings->recordMissedDeadline();
+            m_attributes->setAttribute(attributes::A_LATE_FRAMES, std::to_string(m_lateFrames));
+        }
+        if(m_targetFps > 0) {
+            // Stay on the original schedule, unless presentation fell more
+            // than a whole period behind it.
+            next_present = std::max(next_present + m_framePeriod, presented_at);
+        }
+    }
+
+    destroyWindow();
+}
+
+bool SdlRenderSurface::pumpEvents()
+{
+    // Resizing and exposing are handled by SDL itself while the queue is
+    // drained; only closing the window is of interest.
+    bool open = true;
+    SDL_Event event;
+    while(SDL_PollEvent(&event)) {
+        if(event.type == SDL_QUIT
+            || (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE)) {
+            open = false;
+        }
+    }
+    return open;
+}
+
+void SdlRenderSurface::uploadPendingFrame()
+{
+    const int pitch = m_pending->stride() * static_cast<int>(sizeof(uint32_t));
+    if(m_textureIsStale) {
+        SDL_UpdateTexture(m_texture.get(), NULL, m_pending->data(), pitch);
+        m_textureIsStale = false;
+    } else {
+        for(const auto& rect : m_pendingRegion.rects()) {
+            const SDL_Rect sdl_rect{rect.x, rect.y, rect.width, rect.height};
+            SDL_UpdateTexture(m_texture.get(), &sdl_rect, m_pending->row(rect.y) + rect.x, pitch);
+        }
+    }
+    m_pendingRegion.clear();
 }
 
 Resolution SdlRenderSurface::resolution() const
@@ -112,6 +319,17 @@ bool SdlRenderSurface::hasAttribute(const std::string &key) const
 
 SdlRenderSurface::SdlRenderSurface()
     : m_resolution(0, 0),
+      m_targetFps(0),
+      m_framePeriod(0),
+      m_textureIsStale(true),
+      m_presentedFrames(0),
+      m_lateFrames(0),
+      m_hasPendingFrame(false),
+      m_stopping(false),
+      m_droppedFrames(0),
+      m_presentThread(),
+      m_closed(false),
+      m_timings(),
       m_attributes(new StandardAttributeStore())
 {
     unsigned int width;
@@ -138,10 +356,30 @@ SdlRenderSurface::SdlRenderSurface()
     }
 
     m_resolution = Resolution(width, height);
+    m_frame = std::make_unique<MemoryCanvas>(m_resolution);
+    m_pending = std::make_unique<MemoryCanvas>(m_resolution);
+
+    const char * fps_string = std::getenv(ENV_VAR_FPS);
+    if(fps_string != NULL) {
+        const int fps = std::atoi(fps_string);
+        if(fps > 0) {
+            m_targetFps = fps;
+        }
+    }
+
+    const char * threads_string = std::getenv(ENV_VAR_THREADS);
+    if(threads_string != NULL) {
+        const int threads = std::atoi(threads_string);
+        if(threads > 1) {
+            m_bandedRenderer = std::make_unique<BandedRenderer>(threads);
+        }
+    }
 
     m_attributes->setAttribute(attributes::A_ID, "sdl_window");
     m_attributes->setAttribute(attributes::A_NAME, "SDL Window");
     m_attributes->setAttribute(attributes::A_DESCRIPTION, "Implements support for showing imagery with a window using SDL. This allows for development and testing the imagery without the need for dedicated protogen hardware and uses your monitor instead.");
+    m_attributes->setAttribute(attributes::A_AUTHOR, "mrf7777");
+    m_timings = FrameMetrics::global().addInstance(FrameMetrics::Source::Surface, *m_attributes->getAttribute(attributes::A_ID));
 }
 
 SdlRendererToICanvasAdapter::SdlRendererToICanvasAdapter(SDL_Renderer *renderer, int width, int height)
@@ -175,4 +413,92 @@ void SdlRendererToICanvasAdapter::fill(uint8_t red, uint8_t green, uint8_t blue)
     SDL_RenderClear(m_renderer);
 }
 
+void SdlRendererToICanvasAdapter::fillRegion(int x, int y, int width, int height, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const SDL_Rect rect{clip->dst_x, clip->dst_y, clip->width, clip->height};
+    SDL_SetRenderDrawColor(m_renderer, red, green, blue, SDL_ALPHA_OPAQUE);
+    SDL_RenderFillRect(m_renderer, &rect);
+}
+
+void SdlRendererToICanvasAdapter::drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue)
+{
+    const auto span = clipSpan(x0, x1, y);
+    if(!span.has_value()) {
+        return;
+    }
+    const SDL_Rect rect{span->first, y, span->second - span->first + 1, 1};
+    SDL_SetRenderDrawColor(m_renderer, red, green, blue, SDL_ALPHA_OPAQUE);
+    SDL_RenderFillRect(m_renderer, &rect);
+}
+
+void SdlRendererToICanvasAdapter::blit(const uint8_t *rgb, int stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const uint8_t * first_pixel = rgb + clip->src_y * stride + clip->src_x * 3;
+    copyPixels(SDL_PIXELFORMAT_RGB24, first_pixel, stride, clip->dst_x, clip->dst_y, clip->width, clip->height, SDL_BLENDMODE_NONE);
+}
+
+void SdlRendererToICanvasAdapter::blitMasked(const uint8_t *rgb, int stride, const uint8_t *mask, int mask_stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    // Turn the mask into an alpha channel so the renderer can drop the
+    // masked out pixels while copying.
+    m_maskedPixels.resize(static_cast<size_t>(clip->width) * clip->height * 4);
+    for(int j = 0; j < clip->height; ++j) {
+        const uint8_t * row = rgb + (clip->src_y + j) * stride + clip->src_x * 3;
+        const uint8_t * mask_row = mask + (clip->src_y + j) * mask_stride + clip->src_x;
+        uint8_t * out = m_maskedPixels.data() + static_cast<size_t>(j) * clip->width * 4;
+        for(int i = 0; i < clip->width; ++i) {
+            out[i * 4] = row[i * 3];
+            out[i * 4 + 1] = row[i * 3 + 1];
+            out[i * 4 + 2] = row[i * 3 + 2];
+            out[i * 4 + 3] = mask_row[i] != 0 ? SDL_ALPHA_OPAQUE : 0;
+        }
+    }
+    copyPixels(SDL_PIXELFORMAT_RGBA32, m_maskedPixels.data(), clip->width * 4, clip->dst_x, clip->dst_y, clip->width, clip->height, SDL_BLENDMODE_BLEND);
+}
+
+void SdlRendererToICanvasAdapter::setPixelRGBA(int x, int y, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(m_renderer, red, green, blue, alpha);
+    SDL_RenderDrawPoint(m_renderer, x, y);
+    SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+}
+
+void SdlRendererToICanvasAdapter::blendBlit(const uint8_t *rgba, int stride, int x, int y, int width, int height)
+{
+    const auto clip = clipBlit(x, y, width, height);
+    if(!clip.has_value()) {
+        return;
+    }
+    const uint8_t * first_pixel = rgba + clip->src_y * stride + clip->src_x * 4;
+    copyPixels(SDL_PIXELFORMAT_RGBA32, first_pixel, stride, clip->dst_x, clip->dst_y, clip->width, clip->height, SDL_BLENDMODE_BLEND);
+}
+
+void SdlRendererToICanvasAdapter::copyPixels(Uint32 pixel_format, const void *pixels, int pitch, int x, int y, int width, int height, SDL_BlendMode blend_mode)
+{
+    auto texture = std::unique_ptr<SDL_Texture, TextureDestroyer>(
+        SDL_CreateTexture(m_renderer, pixel_format, SDL_TEXTUREACCESS_STATIC, width, height)
+    );
+    if(!texture) {
+        std::cerr << "Could not create texture for blit. Error: " << SDL_GetError() << std::endl;
+        return;
+    }
+    SDL_SetTextureBlendMode(texture.get(), blend_mode);
+    SDL_UpdateTexture(texture.get(), NULL, pixels, pitch);
+    const SDL_Rect destination{x, y, width, height};
+    SDL_RenderCopy(m_renderer, texture.get(), NULL, &destination);
+}
+
 } // namespace
\ No newline at end of file
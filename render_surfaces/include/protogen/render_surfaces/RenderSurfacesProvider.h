@@ -4,6 +4,12 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <future>
+#include <thread>
 
 #include <protogen/extensions/IExtensionCheck.h>
 #include <protogen/extensions/IExtensionInitializer.h>
@@ -15,15 +21,69 @@ namespace protogen {
 
 class RenderSurfacesProvider {
 public:
-    RenderSurfacesProvider(std::shared_ptr<IExtensionFinder> render_surfaces_finder, std::shared_ptr<IExtensionInitializer> render_surface_initializer, std::shared_ptr<IExtensionCheck> render_surface_check);
+    static constexpr std::chrono::milliseconds DEFAULT_PROBE_TIMEOUT{5000};
+
+    RenderSurfacesProvider(
+        std::shared_ptr<IExtensionFinder> render_surfaces_finder,
+        std::shared_ptr<IExtensionInitializer> render_surface_initializer,
+        std::shared_ptr<IExtensionCheck> render_surface_check,
+        std::chrono::milliseconds probe_timeout = DEFAULT_PROBE_TIMEOUT);
+    RenderSurfacesProvider(RenderSurfacesProvider&&) = default;
+    /**
+     * Waits for probes which timed out to finish.
+     */
+    ~RenderSurfacesProvider();
+
+    /**
+     * Initializes every render surface found, each on its own thread, and
+     * returns those which initialized within the probe timeout and passed
+     * the check, by id.
+     *
+     * A probe which times out is left to finish in the background, and is
+     * waited for when the provider is destroyed, so a surface whose
+     * hardware is slow to fail does not hold up startup.
+     */
     std::map<std::string, RenderSurfaceOriginBundle> loadRenderSurfaces();
-    
+    /**
+     * Initializes the render surfaces found one at a time, in the order of
+     * `byPriority`, and returns the first which initializes within the
+     * probe timeout and passes the check, with its id. Surfaces after it
+     * are never initialized, so a less preferred device, such as a window,
+     * is not opened when a preferred one works.
+     */
+    std::optional<std::pair<std::string, RenderSurfaceOriginBundle>> loadPreferredRenderSurface(const std::vector<std::string>& priority);
+
+    /**
+     * Ids of `render_surfaces` from most to least preferred. Ids in
+     * `priority` come first, in its order; the rest follow by id.
+     */
+    static std::vector<std::string> byPriority(const std::map<std::string, RenderSurfaceOriginBundle>& render_surfaces, const std::vector<std::string>& priority);
+    /**
+     * Splits a comma separated list of ids, such as "hub75_display,sdl_window".
+     */
+    static std::vector<std::string> parsePriority(const std::string& priority);
+
 private:
+    /**
+     * Starts initializing `render_surface` on a thread of its own.
+     */
+    std::future<IExtensionInitializer::Initialization> startProbe(const ExtensionOriginBundle& render_surface);
+    /**
+     * Waits until `deadline` for the probe of `render_surface` and returns
+     * it as a render surface if it initialized and passed the check.
+     */
+    std::optional<RenderSurfaceOriginBundle> finishProbe(
+        const ExtensionOriginBundle& render_surface,
+        std::future<IExtensionInitializer::Initialization>& probe,
+        std::chrono::steady_clock::time_point deadline);
+
     std::shared_ptr<IExtensionFinder> m_render_surfaces_finder;
     std::shared_ptr<IExtensionInitializer> m_render_surface_initializer;
     std::shared_ptr<IExtensionCheck> m_render_surface_check;
+    std::chrono::milliseconds m_probe_timeout;
+    std::vector<std::thread> m_probes;
 };
 
 } // namespace
 
-#endif
\ No newline at end of file
+#endif
@@ -1,45 +1,156 @@
 #include <protogen/render_surfaces/RenderSurfacesProvider.h>
 #include <protogen/StandardAttributes.hpp>
 
+#include <algorithm>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 using namespace protogen;
 
-protogen::RenderSurfacesProvider::RenderSurfacesProvider(std::shared_ptr<IExtensionFinder> render_surfaces_finder, std::shared_ptr<IExtensionInitializer> render_surface_initializer, std::shared_ptr<IExtensionCheck> render_surface_check)
-    : m_render_surfaces_finder(render_surfaces_finder), m_render_surface_initializer(render_surface_initializer), m_render_surface_check(render_surface_check)
+protogen::RenderSurfacesProvider::RenderSurfacesProvider(std::shared_ptr<IExtensionFinder> render_surfaces_finder, std::shared_ptr<IExtensionInitializer> render_surface_initializer, std::shared_ptr<IExtensionCheck> render_surface_check, std::chrono::milliseconds probe_timeout)
+    : m_render_surfaces_finder(render_surfaces_finder), m_render_surface_initializer(render_surface_initializer), m_render_surface_check(render_surface_check), m_probe_timeout(probe_timeout)
 {
 }
 
+protogen::RenderSurfacesProvider::~RenderSurfacesProvider()
+{
+    for(auto& probe : m_probes) {
+        probe.join();
+    }
+}
+
 std::map<std::string, RenderSurfaceOriginBundle> protogen::RenderSurfacesProvider::loadRenderSurfaces()
 {
     auto found_render_surfaces = m_render_surfaces_finder->find();
+
+    // Start every probe before waiting for any, so startup takes as long as
+    // the slowest probe instead of all of them together.
+    std::vector<std::future<IExtensionInitializer::Initialization>> probes;
+    for(const auto& render_surface : found_render_surfaces) {
+        probes.push_back(startProbe(render_surface));
+    }
+    const auto deadline = std::chrono::steady_clock::now() + m_probe_timeout;
+
 	std::map<std::string, RenderSurfaceOriginBundle> render_surfaces;
-	for(auto& render_surface : found_render_surfaces) {
-		const auto initialization = m_render_surface_initializer->initialize(render_surface);
-		switch(initialization) {
-			case IExtensionInitializer::Initialization::Success:
-				break;
-			case IExtensionInitializer::Initialization::Failure:
-				std::cerr << "Failed to initialize render surface of id `" << render_surface.extension->getAttribute(attributes::A_ID).value_or("<no id>") << "`." << std::endl;
-				continue;
-				break;
-		}
-		if(!m_render_surface_check->check(render_surface)) {
-			std::cerr
-				<< "Render surface of id `"
-				<< render_surface.extension->getAttribute(attributes::A_ID).value_or("<no id>")
-				<< "` failed to pass checks. Here is the issue: "
-				<< m_render_surface_check->error()
-				<< std::endl;
-			continue;
+	for(std::size_t i = 0; i < found_render_surfaces.size(); ++i) {
+		auto render_surface = finishProbe(found_render_surfaces[i], probes[i], deadline);
+		if(render_surface.has_value()) {
+			render_surfaces.insert({
+				render_surface->render_surface->getAttribute(attributes::A_ID).value_or(""),
+				*render_surface
+			});
 		}
-		render_surfaces.insert({
-            render_surface.extension->getAttribute(attributes::A_ID).value_or(""),
-            RenderSurfaceOriginBundle{
-                std::dynamic_pointer_cast<IRenderSurface>(render_surface.extension),
-                render_surface.extension_directory
-            }
-        });
 	}
     return render_surfaces;
 }
+
+std::optional<std::pair<std::string, RenderSurfaceOriginBundle>> protogen::RenderSurfacesProvider::loadPreferredRenderSurface(const std::vector<std::string> &priority)
+{
+    auto found_render_surfaces = m_render_surfaces_finder->find();
+
+    // Order by id the same way byPriority does, without initializing any.
+    std::map<std::string, RenderSurfaceOriginBundle> by_id;
+    std::map<std::string, std::size_t> index_of;
+    for(std::size_t i = 0; i < found_render_surfaces.size(); ++i) {
+        const auto id = found_render_surfaces[i].extension->getAttribute(attributes::A_ID).value_or("");
+        if(index_of.insert({id, i}).second) {
+            by_id.insert({id, {}});
+        }
+    }
+    for(const auto& id : byPriority(by_id, priority)) {
+        const auto& render_surface = found_render_surfaces[index_of.at(id)];
+        auto probe = startProbe(render_surface);
+        auto loaded = finishProbe(render_surface, probe, std::chrono::steady_clock::now() + m_probe_timeout);
+        if(loaded.has_value()) {
+            return std::make_pair(id, *loaded);
+        }
+    }
+    return {};
+}
+
+std::future<IExtensionInitializer::Initialization> protogen::RenderSurfacesProvider::startProbe(const ExtensionOriginBundle &render_surface)
+{
+    std::packaged_task<IExtensionInitializer::Initialization()> probe(
+        [initializer = m_render_surface_initializer, render_surface]() {
+            return initializer->initialize(render_surface);
+        }
+    );
+    auto result = probe.get_future();
+    m_probes.emplace_back(std::move(probe));
+    return result;
+}
+
+std::optional<RenderSurfaceOriginBundle> protogen::RenderSurfacesProvider::finishProbe(const ExtensionOriginBundle &render_surface, std::future<IExtensionInitializer::Initialization> &probe, std::chrono::steady_clock::time_point deadline)
+{
+	const auto id = render_surface.extension->getAttribute(attributes::A_ID).value_or("<no id>");
+	if(probe.wait_until(deadline) != std::future_status::ready) {
+		std::cerr << "Render surface of id `" << id << "` did not initialize within " << m_probe_timeout.count() << " ms." << std::endl;
+		return {};
+	}
+	auto initialization = IExtensionInitializer::Initialization::Failure;
+	try {
+		initialization = probe.get();
+	} catch(const std::exception& e) {
+		std::cerr << "Render surface of id `" << id << "` threw while initializing: " << e.what() << std::endl;
+	}
+	switch(initialization) {
+		case IExtensionInitializer::Initialization::Success:
+			break;
+		case IExtensionInitializer::Initialization::Failure:
+			std::cerr << "Failed to initialize render surface of id `" << id << "`." << std::endl;
+			return {};
+			break;
+	}
+	if(!m_render_surface_check->check(render_surface)) {
+		std::cerr
+			<< "Render surface of id `"
+			<< id
+			<< "` failed to pass checks. Here is the issue: "
+			<< m_render_surface_check->error()
+			<< std::endl;
+		return {};
+	}
+	auto surface = std::dynamic_pointer_cast<IRenderSurface>(render_surface.extension);
+	if(surface.get() == nullptr) {
+		std::cerr << "Extension of id `" << id << "` is not a render surface." << std::endl;
+		return {};
+	}
+	return RenderSurfaceOriginBundle{
+		surface,
+		render_surface.extension_directory
+	};
+}
+
+std::vector<std::string> protogen::RenderSurfacesProvider::byPriority(const std::map<std::string, RenderSurfaceOriginBundle> &render_surfaces, const std::vector<std::string> &priority)
+{
+    std::vector<std::string> ids;
+    for(const auto& id : priority) {
+        if(render_surfaces.contains(id) && std::find(ids.begin(), ids.end(), id) == ids.end()) {
+            ids.push_back(id);
+        }
+    }
+    for(const auto& render_surface : render_surfaces) {
+        if(std::find(ids.begin(), ids.end(), render_surface.first) == ids.end()) {
+            ids.push_back(render_surface.first);
+        }
+    }
+    return ids;
+}
+
+std::vector<std::string> protogen::RenderSurfacesProvider::parsePriority(const std::string &priority)
+{
+    std::vector<std::string> ids;
+    std::stringstream stream(priority);
+    std::string id;
+    while(std::getline(stream, id, ',')) {
+        const auto first = id.find_first_not_of(" \t");
+        if(first == std::string::npos) {
+            continue;
+        }
+        const auto last = id.find_last_not_of(" \t");
+        ids.push_back(id.substr(first, last - first + 1));
+    }
+    return ids;
+}
@@ -0,0 +1,91 @@
+// Shows what the protogen displays, streamed from /protogen/preview.
+// Frames are XOR deltas against the previous frame, run-length encoded.
+// See presentation/include/protogen/presentation/PreviewEncoding.h.
+
+const PREVIEW_FPS = 10
+const FRAME_TYPE_KEY = 0
+const HEADER_SIZE = 9
+
+function base64ToBytes(text) {
+    const binary = atob(text)
+    const bytes = new Uint8Array(binary.length)
+    for(let i = 0; i < binary.length; i++) {
+        bytes[i] = binary.charCodeAt(i)
+    }
+    return bytes
+}
+
+// Applies an encoded frame to `rgb`, the previously decoded frame.
+// Returns the decoded frame, or null if the frame cannot be applied.
+function decodePreviewFrame(data, rgb) {
+    if(data.length < HEADER_SIZE) {
+        return null
+    }
+    const type = data[0]
+    const width = data[1] | (data[2] << 8)
+    const height = data[3] | (data[4] << 8)
+    const count = width * height
+    if(type === FRAME_TYPE_KEY) {
+        rgb = { width: width, height: height, pixels: new Uint8Array(count * 3) }
+    } else if(rgb === null || rgb.width !== width || rgb.height !== height) {
+        return null
+    }
+    const pixels = rgb.pixels
+
+    let position = HEADER_SIZE
+    let i = 0
+    while(i < count && position < data.length) {
+        const run = data[position++]
+        if(run & 0x80) {
+            const literals = (run & 0x7f) + 1
+            for(let j = 0; j < literals * 3; j++) {
+                pixels[i * 3 + j] ^= data[position + j]
+            }
+            position += literals * 3
+            i += literals
+        } else if(run & 0x40) {
+            const repeat = (run & 0x3f) + 1
+            for(let j = 0; j < repeat; j++) {
+                pixels[(i + j) * 3] ^= data[position]
+                pixels[(i + j) * 3 + 1] ^= data[position + 1]
+                pixels[(i + j) * 3 + 2] ^= data[position + 2]
+            }
+            position += 3
+            i += repeat
+        } else {
+            i += (run & 0x3f) + 1
+        }
+    }
+    return i === count ? rgb : null
+}
+
+function startPreview(canvas) {
+    const context = canvas.getContext("2d")
+    let frame = null
+    let image = null
+
+    const source = new EventSource(`${origin}/protogen/preview?fps=${PREVIEW_FPS}`)
+    source.addEventListener("frame", event => {
+        frame = decodePreviewFrame(base64ToBytes(event.data), frame)
+        if(frame === null) {
+            // Out of sync; the server sends a key frame after reconnecting.
+            source.close()
+            setTimeout(() => startPreview(canvas), 1000)
+            return
+        }
+        if(image === null || image.width !== frame.width || image.height !== frame.height) {
+            canvas.width = frame.width
+            canvas.height = frame.height
+            image = context.createImageData(frame.width, frame.height)
+        }
+        for(let i = 0, j = 0; i < frame.pixels.length; i += 3, j += 4) {
+            image.data[j] = frame.pixels[i]
+            image.data[j + 1] = frame.pixels[i + 1]
+            image.data[j + 2] = frame.pixels[i + 2]
+            image.data[j + 3] = 255
+        }
+        context.putImageData(image, 0, 0)
+    })
+}
+
+startPreview(document.getElementById("preview"))
@@ -1,6 +1,8 @@
 #ifndef SSE_H
 #define SSE_H
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <mutex>
 #include <sstream>
@@ -28,6 +30,14 @@ public:
 		return {e};
 	}
 
+	/**
+	 * A comment line, which clients ignore. Useful to keep a connection
+	 * alive and to notice that a client went away.
+	 */
+	static std::string keep_alive_sse_string() {
+		return ": keep-alive\n\n";
+	}
+
 	std::string to_sse_string() const {
 		std::stringstream ss;
 		ss << "event: " << m_event << "\n";
@@ -48,10 +58,8 @@ public:
 	{}
 	void wait_event(httplib::DataSink* sink) {
 		std::unique_lock<std::mutex> lock(m_mutex);
-		int id = m_id;
 		m_cv.wait(lock, [&]{ return m_cid == m_id; });
 		sink->write(m_message.data(), m_message.size());
-		std::cout << "written data to sink from event dispatcher" << std::endl;
 	}
 	void send_event(const Event& event) {
 		std::lock_guard<std::mutex> lock(m_mutex);
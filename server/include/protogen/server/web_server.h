@@ -8,6 +8,9 @@
 #include <protogen/utils/utils.h>
 #include <protogen/state/app_state.h>
 #include <protogen/IProtogenApp.hpp>
+#include <protogen/presentation/PreviewStream.h>
+#include <protogen/presentation/FrameMetrics.h>
+#include <protogen/presentation/CompositorRenderSurface.h>
 
 #include <httplib.h>
 
@@ -15,6 +18,9 @@ namespace protogen {
 
 void setup_web_server(std::shared_ptr<httplib::Server> srv, std::shared_ptr<AppState> app_state, const std::string& html_files_dir, const std::string& static_files_dir);
 void setup_web_server_for_apps(std::shared_ptr<httplib::Server> srv, std::shared_ptr<AppState> app_state);
+void setup_web_server_for_preview(std::shared_ptr<httplib::Server> srv, std::shared_ptr<PreviewStream> preview_stream);
+void setup_web_server_for_metrics(std::shared_ptr<httplib::Server> srv, FrameMetrics& frame_metrics);
+void setup_web_server_for_overlays(std::shared_ptr<httplib::Server> srv, std::shared_ptr<CompositorRenderSurface> compositor);
 
 }   // namespace
 
@@ -1,9 +1,13 @@
 #include <protogen/server/web_server.h>
 #include <protogen/StandardAttributes.hpp>
+#include <protogen/server/sse.h>
+#include <protogen/presentation/SpriteAtlas.h>
 
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
+#include <chrono>
+#include <mutex>
 
 namespace protogen {
 
@@ -39,6 +43,7 @@ void setup_web_server(std::shared_ptr<httplib::Server> srv, std::shared_ptr<AppS
 	});
 
 	setup_web_server_for_apps(srv, app_state);
+	setup_web_server_for_metrics(srv, FrameMetrics::global());
 }
 
 void setup_web_server_for_apps(std::shared_ptr<httplib::Server> srv, std::shared_ptr<AppState> app_state) {
@@ -192,4 +197,129 @@ void setup_web_server_for_apps(std::shared_ptr<httplib::Server> srv, std::shared
 	}
 }
 
+void setup_web_server_for_preview(std::shared_ptr<httplib::Server> srv, std::shared_ptr<PreviewStream> preview_stream) {
+	// Server-sent events with the frames being shown. See PreviewStream.h
+	// and resources/static/preview.js.
+	srv->Get("/protogen/preview", [preview_stream](const auto& req, auto& res){
+		int fps = 10;
+		if(req.has_param("fps")) {
+			try {
+				fps = std::stoi(req.get_param_value("fps"));
+			} catch(const std::exception&) {
+				res.status = httplib::StatusCode::BadRequest_400;
+				res.set_content("fps must be an integer", "text/plain");
+				return;
+			}
+		}
+		const std::size_t tier = preview_stream->subscribe(fps);
+		auto sequence = std::make_shared<uint64_t>(0);
+		res.set_header("Cache-Control", "no-cache");
+		res.set_chunked_content_provider("text/event-stream",
+			[preview_stream, tier, sequence](size_t, httplib::DataSink& sink){
+				const auto message = preview_stream->next(tier, *sequence, std::chrono::seconds(1));
+				std::string text;
+				if(message.has_value()) {
+					*sequence = message->sequence;
+					text = Event::make_event("frame", *message->data).value().to_sse_string();
+				} else {
+					text = Event::keep_alive_sse_string();
+				}
+				// Fails once the client is gone, which ends the stream.
+				return sink.write(text.data(), text.size());
+			},
+			[preview_stream, tier](bool){
+				preview_stream->unsubscribe(tier);
+			}
+		);
+	});
+}
+
+void setup_web_server_for_metrics(std::shared_ptr<httplib::Server> srv, FrameMetrics& frame_metrics) {
+	// Frame time histograms of every render surface and app. See
+	// FrameMetrics::toJson for the format.
+	srv->Get("/protogen/metrics/frames", [&frame_metrics](const auto&, auto& res){
+		res.set_header("Cache-Control", "no-cache");
+		res.set_content(frame_metrics.toJson(), "application/json");
+	});
+	// Starts a new measurement, e.g. before putting the headset under load.
+	srv->Delete("/protogen/metrics/frames", [&frame_metrics](const auto&, auto&){
+		frame_metrics.reset();
+	});
+}
+
+void setup_web_server_for_overlays(std::shared_ptr<httplib::Server> srv, std::shared_ptr<CompositorRenderSurface> compositor) {
+	// Images shown over every app, such as battery or connection indicators
+	// pushed by other programs on the headset. Each is drawn at the top left
+	// corner; transparent pixels place it.
+	struct Overlays {
+		std::mutex mutex;
+		std::map<std::string, std::shared_ptr<CompositorRenderSurface::Layer>> layers;
+	};
+	auto overlays = std::make_shared<Overlays>();
+
+	srv->Get("/protogen/overlays", [overlays](const auto&, auto& res){
+		std::string names_separated_by_newline;
+		std::lock_guard<std::mutex> lock(overlays->mutex);
+		for(const auto& [name, layer] : overlays->layers) {
+			names_separated_by_newline += name;
+			names_separated_by_newline += "\n";
+		}
+		res.set_content(names_separated_by_newline, "text/plain");
+	});
+	// The body is an image file. `level` is `overlay` (the default) or
+	// `notification`, which is drawn above every overlay.
+	srv->Put("/protogen/overlays/:name", [overlays, compositor](const auto& req, auto& res){
+		const auto name = req.path_params.at("name");
+		const std::string level_param = req.has_param("level") ? req.get_param_value("level") : "overlay";
+		if(level_param != "overlay" && level_param != "notification") {
+			res.status = httplib::StatusCode::BadRequest_400;
+			res.set_content("level must be `overlay` or `notification`", "text/plain");
+			return;
+		}
+		const auto level = level_param == "notification" ? CompositorRenderSurface::Level::Notification : CompositorRenderSurface::Level::CoreOverlay;
+		// Decoded once; the layer then only copies the visible pixels.
+		auto atlas = std::make_shared<SpriteAtlas>();
+		SpriteAtlas::SpriteId sprite;
+		try {
+			sprite = atlas->add(Magick::Image(Magick::Blob(req.body.data(), req.body.size())));
+		} catch(const std::exception&) {
+			res.status = httplib::StatusCode::BadRequest_400;
+			res.set_content("body must be an image", "text/plain");
+			return;
+		}
+		const auto drawer = [atlas, sprite](ICanvas& canvas){
+			atlas->draw(canvas, sprite, 0, 0);
+		};
+		{
+			std::lock_guard<std::mutex> lock(overlays->mutex);
+			auto& layer = overlays->layers[name];
+			if(layer != nullptr && layer->level() != level) {
+				compositor->removeLayer(layer);
+				layer = nullptr;
+			}
+			if(layer == nullptr) {
+				layer = compositor->addLayer(level, drawer);
+			} else {
+				layer->setDrawer(drawer);
+			}
+		}
+		compositor->refresh();
+	});
+	srv->Delete("/protogen/overlays/:name", [overlays, compositor](const auto& req, auto& res){
+		const auto name = req.path_params.at("name");
+		{
+			std::lock_guard<std::mutex> lock(overlays->mutex);
+			const auto found = overlays->layers.find(name);
+			if(found == overlays->layers.end()) {
+				res.status = httplib::StatusCode::NotFound_404;
+				res.set_content("", "text/plain");
+				return;
+			}
+			compositor->removeLayer(found->second);
+			overlays->layers.erase(found);
+		}
+		compositor->refresh();
+	});
+}
+
 } // namespace
\ No newline at end of file
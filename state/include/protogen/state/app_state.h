@@ -5,6 +5,7 @@
 #include <optional>
 #include <map>
 #include <set>
+#include <functional>
 
 #include <protogen/utils/utils.h>
 #include <protogen/apps/ProtogenAppInitializer.h>
@@ -20,11 +21,18 @@ public:
 	std::optional<std::shared_ptr<IProtogenApp>> getActiveApp();
 	std::optional<std::string> getActiveAppId() const;
 	std::set<std::string> appIds() const;
+	/**
+	 * Calls `listener` with null before the active app changes, and with
+	 * the new active app once it was set active. Replaces any previous
+	 * listener.
+	 */
+	void setActiveAppListener(std::function<void(std::shared_ptr<IProtogenApp>)> listener);
 	
 	virtual std::string toString() const override;
 private:
 	std::map<std::string, std::shared_ptr<IProtogenApp>> m_apps;
 	std::optional<std::string> m_activeAppId;
+	std::function<void(std::shared_ptr<IProtogenApp>)> m_activeAppListener;
 };
 
 }	// namespace
@@ -5,7 +5,8 @@ namespace protogen {
 
 AppState::AppState()
     : m_apps(),
-    m_activeAppId({})
+    m_activeAppId({}),
+    m_activeAppListener()
 {}
 
 bool AppState::addApp(std::shared_ptr<IProtogenApp> app) {
@@ -23,6 +24,10 @@ bool AppState::setActiveApp(const std::string& app_id) {
         return false;
     }
 
+    if(m_activeAppListener) {
+        m_activeAppListener(nullptr);
+    }
+
     // If an app is already selected, set it to inactive.
     if(auto current_app = getActiveApp()) {
         current_app.value()->setActive(false);
@@ -30,6 +35,9 @@ bool AppState::setActiveApp(const std::string& app_id) {
 
     m_activeAppId = {app_id};
     getActiveApp().value()->setActive(true);
+    if(m_activeAppListener) {
+        m_activeAppListener(getActiveApp().value());
+    }
     return true;
 }
 
@@ -64,6 +72,11 @@ std::set<std::string> AppState::appIds() const
     return appIds;
 }
 
+void AppState::setActiveAppListener(std::function<void(std::shared_ptr<IProtogenApp>)> listener)
+{
+    m_activeAppListener = std::move(listener);
+}
+
 std::string AppState::toString() const
 {
     return "AppState{}";
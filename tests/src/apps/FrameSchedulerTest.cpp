@@ -0,0 +1,138 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/StandardAttributeStore.hpp>
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/apps/FrameScheduler.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+#include "../presentation/MemoryRenderSurface.h"
+
+using namespace protogen;
+using namespace std::chrono_literals;
+
+namespace {
+
+class RenderingApp : public IProtogenApp {
+public:
+    RenderingApp(bool uses_frame_scheduler, std::chrono::milliseconds work = 0ms)
+        : m_attributes(new StandardAttributeStore()), m_usesFrameScheduler(uses_frame_scheduler), m_work(work)
+    {
+        m_attributes->setAttribute(attributes::A_ID, "rendering_app");
+    }
+    Initialization initialize() override { return Initialization::Success; }
+    void setActive(bool) override {}
+    void receiveRenderSurface(std::shared_ptr<IRenderSurface>) override {}
+    bool usesFrameScheduler() const override { return m_usesFrameScheduler; }
+    void render(ICanvas& canvas, const FrameInfo& frame) override {
+        canvas.setPixel(0, 0, 255, 0, 0);
+        std::this_thread::sleep_for(m_work);
+        std::lock_guard<std::mutex> lock(mutex);
+        frames.push_back(frame);
+    }
+    std::optional<std::string> getAttribute(const std::string& key) const override { return m_attributes->getAttribute(key); }
+    std::vector<std::string> listAttributes() const override { return m_attributes->listAttributes(); }
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override { return m_attributes->setAttribute(key, value); }
+    RemoveAttributeResult removeAttribute(const std::string& key) override { return m_attributes->removeAttribute(key); }
+    bool hasAttribute(const std::string& key) const override { return m_attributes->hasAttribute(key); }
+
+    std::size_t frameCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return frames.size();
+    }
+
+    std::mutex mutex;
+    std::vector<FrameInfo> frames;
+private:
+    std::shared_ptr<attributes::IAttributeStore> m_attributes;
+    bool m_usesFrameScheduler;
+    std::chrono::milliseconds m_work;
+};
+
+void waitFor(const std::function<bool()>& condition) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(!condition() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+}
+
+} // namespace
+
+TEST(FrameSchedulerTest, RendersTheCurrentAppOnOneClock) {
+    FrameScheduler scheduler(FrameScheduler::Config{200.0, FrameScheduler::Mode::Fixed, 200.0});
+    auto surface = std::make_shared<MemoryRenderSurface>(4, 4);
+    auto first = std::make_shared<RenderingApp>(true);
+    auto second = std::make_shared<RenderingApp>(true);
+    scheduler.start();
+
+    scheduler.setApp(first, surface);
+    waitFor([&]{ return first->frameCount() >= 5; });
+    scheduler.setApp(second, surface);
+    const std::size_t first_frames = first->frameCount();
+    waitFor([&]{ return second->frameCount() >= 5; });
+    scheduler.stop();
+
+    // The previous app is not rendered once it was replaced.
+    EXPECT_EQ(first->frameCount(), first_frames);
+    ASSERT_GE(first_frames, 5u);
+    ASSERT_GE(second->frameCount(), 5u);
+    EXPECT_EQ(surface->frame.pixel(0, 0), MemoryCanvas::pack(255, 0, 0));
+    EXPECT_EQ(static_cast<uint64_t>(surface->frames), scheduler.frames());
+
+    // Frame numbers continue across apps and deltas restart with each app.
+    EXPECT_EQ(first->frames.front().frame_number, 1u);
+    EXPECT_EQ(second->frames.front().frame_number, first->frames.back().frame_number + 1);
+    EXPECT_EQ(second->frames.front().delta, 0ns);
+    for(std::size_t i = 1; i < second->frames.size(); ++i) {
+        EXPECT_EQ(second->frames[i].frame_number, second->frames[i - 1].frame_number + 1);
+        EXPECT_EQ(second->frames[i].delta, second->frames[i].time - second->frames[i - 1].time);
+        EXPECT_GE(second->frames[i].delta, 5ms);
+        EXPECT_EQ(second->frames[i].period, 5ms);
+    }
+}
+
+TEST(FrameSchedulerTest, DoesNotRenderAppsWhichDrawThemselves) {
+    FrameScheduler scheduler;
+    auto surface = std::make_shared<MemoryRenderSurface>(4, 4);
+    auto app = std::make_shared<RenderingApp>(false);
+    scheduler.start();
+    scheduler.setApp(app, surface);
+    std::this_thread::sleep_for(50ms);
+    scheduler.setApp(nullptr, nullptr);
+    scheduler.stop();
+    EXPECT_EQ(app->frameCount(), 0u);
+    EXPECT_EQ(scheduler.frames(), 0u);
+    EXPECT_EQ(surface->frames, 0);
+}
+
+TEST(FrameSchedulerTest, AdaptsTheFrameRateToSlowApps) {
+    FrameScheduler fixed(FrameScheduler::Config{200.0, FrameScheduler::Mode::Fixed, 10.0});
+    auto slow = std::make_shared<RenderingApp>(true, 20ms);
+    fixed.start();
+    fixed.setApp(slow, std::make_shared<MemoryRenderSurface>(4, 4));
+    waitFor([&]{ return slow->frameCount() >= 4; });
+    fixed.stop();
+    EXPECT_GE(fixed.missedDeadlines(), 3u);
+    EXPECT_DOUBLE_EQ(fixed.fps(), 200.0);
+
+    FrameScheduler adaptive(FrameScheduler::Config{200.0, FrameScheduler::Mode::Adaptive, 10.0});
+    auto adapted = std::make_shared<RenderingApp>(true, 20ms);
+    adaptive.start();
+    adaptive.setApp(adapted, std::make_shared<MemoryRenderSurface>(4, 4));
+    waitFor([&]{ return adapted->frameCount() >= 4; });
+    adaptive.stop();
+    EXPECT_LT(adaptive.fps(), 50.0);
+    EXPECT_GE(adaptive.fps(), 10.0);
+}
+
+TEST(FrameSchedulerTest, ParsesModes) {
+    EXPECT_EQ(FrameScheduler::parseMode("fixed"), FrameScheduler::Mode::Fixed);
+    EXPECT_EQ(FrameScheduler::parseMode("adaptive"), FrameScheduler::Mode::Adaptive);
+    EXPECT_FALSE(FrameScheduler::parseMode("vsync").has_value());
+}
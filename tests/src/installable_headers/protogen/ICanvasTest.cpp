@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cstdlib>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/ICanvas.hpp>
+
+using namespace protogen;
+
+/**
+ * Canvas which only implements the required methods so the default
+ * implementations of ICanvas are exercised.
+ */
+class PixelCanvas : public ICanvas {
+public:
+    PixelCanvas(int width, int height)
+        : m_width(width), m_height(height), m_pixels(width * height, {0, 0, 0})
+    {}
+    int width() const override { return m_width; }
+    int height() const override { return m_height; }
+    void setPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+        ++m_setPixelCalls;
+        if(x < 0 || x >= m_width || y < 0 || y >= m_height) {
+            ++m_outOfBoundsCalls;
+            return;
+        }
+        m_pixels[y * m_width + x] = {red, green, blue};
+    }
+
+    std::array<uint8_t, 3> pixel(int x, int y) const { return m_pixels[y * m_width + x]; }
+    int setPixelCalls() const { return m_setPixelCalls; }
+    int outOfBoundsCalls() const { return m_outOfBoundsCalls; }
+
+private:
+    int m_width;
+    int m_height;
+    std::vector<std::array<uint8_t, 3>> m_pixels;
+    int m_setPixelCalls = 0;
+    int m_outOfBoundsCalls = 0;
+};
+
+namespace {
+
+// 3x2 block where every pixel encodes its own position.
+std::vector<uint8_t> makeBlock() {
+    std::vector<uint8_t> block;
+    for(uint8_t y = 0; y < 2; ++y) {
+        for(uint8_t x = 0; x < 3; ++x) {
+            block.push_back(x);
+            block.push_back(y);
+            block.push_back(7);
+        }
+    }
+    return block;
+}
+
+} // namespace
+
+TEST(ICanvasTest, BlitCopiesBlock) {
+    PixelCanvas canvas(8, 8);
+    const auto block = makeBlock();
+    canvas.blit(block.data(), 3 * 3, 2, 4, 3, 2);
+
+    EXPECT_EQ(canvas.setPixelCalls(), 6);
+    EXPECT_EQ(canvas.pixel(2, 4), (std::array<uint8_t, 3>{0, 0, 7}));
+    EXPECT_EQ(canvas.pixel(4, 5), (std::array<uint8_t, 3>{2, 1, 7}));
+    EXPECT_EQ(canvas.pixel(5, 5), (std::array<uint8_t, 3>{0, 0, 0}));
+}
+
+TEST(ICanvasTest, BlitClipsToCanvas) {
+    PixelCanvas canvas(4, 4);
+    const auto block = makeBlock();
+
+    canvas.blit(block.data(), 3 * 3, -1, -1, 3, 2);
+    EXPECT_EQ(canvas.outOfBoundsCalls(), 0);
+    EXPECT_EQ(canvas.setPixelCalls(), 2);
+    EXPECT_EQ(canvas.pixel(0, 0), (std::array<uint8_t, 3>{1, 1, 7}));
+    EXPECT_EQ(canvas.pixel(1, 0), (std::array<uint8_t, 3>{2, 1, 7}));
+
+    canvas.blit(block.data(), 3 * 3, 3, 3, 3, 2);
+    EXPECT_EQ(canvas.outOfBoundsCalls(), 0);
+    EXPECT_EQ(canvas.pixel(3, 3), (std::array<uint8_t, 3>{0, 0, 7}));
+
+    // Entirely outside.
+    canvas.blit(block.data(), 3 * 3, 10, 0, 3, 2);
+    canvas.blit(block.data(), 3 * 3, 0, -2, 3, 2);
+    EXPECT_EQ(canvas.setPixelCalls(), 3);
+}
+
+TEST(ICanvasTest, BlitMaskedSkipsMaskedPixels) {
+    PixelCanvas canvas(4, 4);
+    canvas.fill(9, 9, 9);
+    const auto block = makeBlock();
+    const std::vector<uint8_t> mask{
+        1, 0, 1,
+        0, 1, 0,
+    };
+    canvas.blitMasked(block.data(), 3 * 3, mask.data(), 3, 0, 0, 3, 2);
+
+    EXPECT_EQ(canvas.pixel(0, 0), (std::array<uint8_t, 3>{0, 0, 7}));
+    EXPECT_EQ(canvas.pixel(1, 0), (std::array<uint8_t, 3>{9, 9, 9}));
+    EXPECT_EQ(canvas.pixel(2, 0), (std::array<uint8_t, 3>{2, 0, 7}));
+    EXPECT_EQ(canvas.pixel(0, 1), (std::array<uint8_t, 3>{9, 9, 9}));
+    EXPECT_EQ(canvas.pixel(1, 1), (std::array<uint8_t, 3>{1, 1, 7}));
+}
+
+TEST(ICanvasTest, BlendBlitDrawsVisiblePixelsOpaque) {
+    PixelCanvas canvas(4, 1);
+    const std::vector<uint8_t> rgba{
+        200, 100, 50, 0,  200, 100, 50, 128,  200, 100, 50, 255,
+    };
+    canvas.blendBlit(rgba.data(), 12, 1, 0, 3, 1);
+
+    EXPECT_EQ(canvas.setPixelCalls(), 2);
+    EXPECT_EQ(canvas.pixel(1, 0), (std::array<uint8_t, 3>{0, 0, 0}));
+    EXPECT_EQ(canvas.pixel(2, 0), (std::array<uint8_t, 3>{200, 100, 50}));
+    EXPECT_EQ(canvas.pixel(3, 0), (std::array<uint8_t, 3>{200, 100, 50}));
+}
+
+/**
+ * Records the rows of every span so tests can check how fills are issued.
+ */
+class SpanCountingCanvas : public PixelCanvas {
+public:
+    using PixelCanvas::PixelCanvas;
+    void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+        m_spanRows.push_back(y);
+        PixelCanvas::drawSpan(x0, x1, y, red, green, blue);
+    }
+    const std::vector<int>& spanRows() const { return m_spanRows; }
+
+private:
+    std::vector<int> m_spanRows;
+};
+
+TEST(ICanvasTest, DrawSpanClipsAndOrders) {
+    PixelCanvas canvas(4, 2);
+    canvas.drawSpan(5, -3, 1, 1, 2, 3);
+    EXPECT_EQ(canvas.setPixelCalls(), 4);
+    EXPECT_EQ(canvas.outOfBoundsCalls(), 0);
+    EXPECT_EQ(canvas.pixel(0, 1), (std::array<uint8_t, 3>{1, 2, 3}));
+    EXPECT_EQ(canvas.pixel(3, 1), (std::array<uint8_t, 3>{1, 2, 3}));
+
+    canvas.drawSpan(0, 3, 2, 1, 2, 3);
+    canvas.drawSpan(4, 8, 0, 1, 2, 3);
+    EXPECT_EQ(canvas.setPixelCalls(), 4);
+}
+
+TEST(ICanvasTest, FillRegionUsesOneSpanPerRow) {
+    SpanCountingCanvas canvas(8, 8);
+    canvas.fillRegion(-2, 1, 5, 3, 1, 1, 1);
+    EXPECT_EQ(canvas.spanRows(), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(canvas.setPixelCalls(), 9);
+    EXPECT_EQ(canvas.outOfBoundsCalls(), 0);
+}
+
+TEST(ICanvasTest, FilledEllipseFillsEachRowOnce) {
+    SpanCountingCanvas canvas(32, 32);
+    canvas.drawEllipse(4, 4, 20, 12, 255, 255, 255, true);
+
+    auto rows = canvas.spanRows();
+    std::sort(rows.begin(), rows.end());
+    EXPECT_EQ(std::adjacent_find(rows.begin(), rows.end()), rows.end());
+    EXPECT_EQ(rows.size(), 13u);
+
+    // Center row spans the full width and the outline is covered.
+    EXPECT_EQ(canvas.pixel(4, 10), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(24, 10), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(14, 4), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(14, 16), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(4, 4), (std::array<uint8_t, 3>{0, 0, 0}));
+}
+
+TEST(ICanvasTest, DrawLineCoversEndPointsWithoutGaps) {
+    const std::vector<std::array<int, 4>> lines{
+        {1, 1, 9, 4}, {9, 4, 1, 1}, {2, 9, 5, 0}, {0, 0, 9, 9}, {3, 7, 3, 2}, {6, 6, 6, 6},
+    };
+    for(const auto& line : lines) {
+        PixelCanvas canvas(10, 10);
+        canvas.drawLine(line[0], line[1], line[2], line[3], 255, 255, 255);
+        const int steps = std::max(std::abs(line[2] - line[0]), std::abs(line[3] - line[1]));
+        EXPECT_EQ(canvas.setPixelCalls(), steps + 1);
+        EXPECT_EQ(canvas.pixel(line[0], line[1]), (std::array<uint8_t, 3>{255, 255, 255}));
+        EXPECT_EQ(canvas.pixel(line[2], line[3]), (std::array<uint8_t, 3>{255, 255, 255}));
+    }
+}
+
+TEST(ICanvasTest, FilledPolygonUsesSpans) {
+    SpanCountingCanvas canvas(16, 16);
+    // U shape: rows 3 to 5 cross both arms, rows 6 to 8 cross the base.
+    const std::vector<std::pair<int, int>> points{
+        {2, 2}, {5, 2}, {5, 5}, {9, 5}, {9, 2}, {12, 2}, {12, 8}, {2, 8},
+    };
+    canvas.drawPolygon(points, 255, 255, 255, true);
+
+    EXPECT_EQ(canvas.outOfBoundsCalls(), 0);
+    EXPECT_EQ(std::count(canvas.spanRows().begin(), canvas.spanRows().end(), 4), 2);
+    EXPECT_EQ(canvas.pixel(3, 4), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(7, 4), (std::array<uint8_t, 3>{0, 0, 0}));
+    EXPECT_EQ(canvas.pixel(11, 4), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(7, 7), (std::array<uint8_t, 3>{255, 255, 255}));
+    EXPECT_EQ(canvas.pixel(13, 7), (std::array<uint8_t, 3>{0, 0, 0}));
+}
+
+TEST(ICanvasTest, FilledPolygonIsClipped) {
+    PixelCanvas canvas(8, 8);
+    const std::vector<std::pair<int, int>> points{{-20, -20}, {30, -10}, {4, 40}};
+    canvas.drawPolygon(points, 1, 2, 3, true);
+    EXPECT_EQ(canvas.pixel(4, 4), (std::array<uint8_t, 3>{1, 2, 3}));
+}
+
+TEST(ICanvasTest, FilledPolygonsCanBeDrawnFromSpans) {
+    // Draws a small filled square from the span filling row 4, which
+    // rasterizes a polygon while another is being rasterized.
+    class NestingCanvas : public PixelCanvas {
+    public:
+        using PixelCanvas::PixelCanvas;
+        void drawSpan(int x0, int x1, int y, uint8_t red, uint8_t green, uint8_t blue) override {
+            if(!m_nested && y == 4 && x1 > x0) {
+                m_nested = true;
+                drawPolygon({{12, 12}, {14, 12}, {14, 14}, {12, 14}}, 9, 9, 9, true);
+            }
+            PixelCanvas::drawSpan(x0, x1, y, red, green, blue);
+        }
+    private:
+        bool m_nested = false;
+    };
+
+    NestingCanvas canvas(16, 16);
+    canvas.drawPolygon({{1, 1}, {8, 1}, {8, 8}, {1, 8}}, 255, 255, 255, true);
+    for(int y = 2; y <= 8; ++y) {
+        EXPECT_EQ(canvas.pixel(4, y), (std::array<uint8_t, 3>{255, 255, 255})) << y;
+    }
+    EXPECT_EQ(canvas.pixel(13, 13), (std::array<uint8_t, 3>{9, 9, 9}));
+}
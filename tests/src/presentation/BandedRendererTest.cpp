@@ -0,0 +1,82 @@
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/BandedRenderer.h>
+#include <protogen/presentation/RecordingCanvas.h>
+#include <protogen/presentation/WorkStealingPool.h>
+
+using namespace protogen;
+
+TEST(WorkStealingPoolTest, RunsEveryIterationOnce) {
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+    for(int repeat = 0; repeat < 20; ++repeat) {
+        std::vector<std::atomic<int>> runs(257);
+        pool.parallelFor(runs.size(), [&](std::size_t i) {
+            ++runs[i];
+        });
+        for(const auto& count : runs) {
+            ASSERT_EQ(count.load(), 1);
+        }
+    }
+    pool.parallelFor(0, [](std::size_t) { FAIL(); });
+}
+
+TEST(MemoryCanvasTest, RowViewsDrawIntoTheirParent) {
+    MemoryCanvas canvas(10, 6);
+    MemoryCanvas rows = canvas.rows(2, 3);
+    EXPECT_EQ(rows.height(), 3);
+    EXPECT_EQ(rows.row(0), canvas.row(2));
+    rows.fill(1, 2, 3);
+    rows.setPixel(0, 5, 9, 9, 9);
+    EXPECT_EQ(canvas.pixel(0, 1), 0u);
+    EXPECT_EQ(canvas.pixel(0, 2), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(canvas.pixel(9, 4), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(canvas.pixel(0, 5), 0u);
+
+    MemoryCanvas copy(rows);
+    copy.clear();
+    EXPECT_EQ(canvas.pixel(0, 2), MemoryCanvas::pack(1, 2, 3));
+}
+
+namespace {
+
+void drawScene(ICanvas& canvas) {
+    canvas.fill(10, 10, 10);
+    for(int i = 0; i < 12; ++i) {
+        canvas.drawPolygon({{i * 7, -5}, {i * 7 + 40, 30 + i * 5}, {i * 3, 90}}, 20 * i, 255 - 20 * i, 7, true);
+        canvas.drawEllipse(i * 6, i * 8, 30, 20, 1, 2, 3, i % 2 == 0);
+        canvas.drawLine(0, i * 9, 79, 99 - i * 9, 255, 255, 255);
+    }
+    std::vector<uint8_t> rgba(16 * 16 * 4);
+    for(std::size_t i = 0; i < rgba.size(); ++i) {
+        rgba[i] = static_cast<uint8_t>(i * 31);
+    }
+    canvas.blendBlit(rgba.data(), 16 * 4, 30, 41, 16, 16);
+    canvas.fillRegion(60, 5, 10, 80, 0, 0, 200);
+}
+
+} // namespace
+
+TEST(BandedRendererTest, MatchesSingleThreadedDrawing) {
+    MemoryCanvas expected(80, 100);
+    drawScene(expected);
+
+    DisplayList list;
+    RecordingCanvas recorder(list, 80, 100);
+    drawScene(recorder);
+
+    for(const std::size_t threads : {1u, 3u, 8u}) {
+        SCOPED_TRACE(threads);
+        BandedRenderer renderer(threads);
+        MemoryCanvas actual(80, 100);
+        renderer.render(list, actual);
+        for(int y = 0; y < 100; ++y) {
+            for(int x = 0; x < 80; ++x) {
+                ASSERT_EQ(actual.pixel(x, y), expected.pixel(x, y)) << x << ", " << y;
+            }
+        }
+    }
+}
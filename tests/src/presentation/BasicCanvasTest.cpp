@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/BasicCanvas.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/PixelFormat.h>
+#include <protogen/presentation/PixelKernels.h>
+
+using namespace protogen;
+
+namespace {
+
+void drawScene(ICanvas& canvas) {
+    canvas.fill(10, 20, 30);
+    canvas.fillRegion(-2, 3, 9, 4, 200, 100, 50);
+    canvas.drawLine(0, 0, 15, 11, 255, 0, 128);
+    canvas.drawEllipse(4, 2, 9, 7, 0, 255, 64, true);
+    std::vector<uint8_t> rgb(5 * 3 * 3);
+    for(std::size_t i = 0; i < rgb.size(); ++i) {
+        rgb[i] = static_cast<uint8_t>(i * 17);
+    }
+    canvas.blit(rgb.data(), 5 * 3, 12, 9, 5, 3);
+    canvas.setPixelRGBA(1, 1, 255, 255, 255, 128);
+}
+
+} // namespace
+
+TEST(PixelFormatTest, PacksChannelsInFormatOrder) {
+    EXPECT_EQ(pixel_formats::Rgb888::pack(1, 2, 3), 0x030201u);
+    EXPECT_EQ(pixel_formats::Bgr888::pack(1, 2, 3), 0x010203u);
+    EXPECT_EQ(pixel_formats::Rbg888::pack(1, 2, 3), 0x020301u);
+    EXPECT_EQ(pixel_formats::Rgb565::pack(255, 0, 255), 0xf81fu);
+    EXPECT_EQ(pixel_formats::Rgb565::unpack(0x07e0), (pixel_formats::Rgb{0, 255, 0}));
+    EXPECT_TRUE(pixel_formats::matchesSequence<pixel_formats::Grb888>("GRB"));
+    EXPECT_FALSE(pixel_formats::matchesSequence<pixel_formats::Grb888>("RGB"));
+}
+
+template<typename Format>
+class BasicCanvasTest : public ::testing::Test {};
+
+using ExactFormats = ::testing::Types<pixel_formats::Rgb888, pixel_formats::Bgr888, pixel_formats::Rbg888, pixel_formats::Grb888>;
+TYPED_TEST_SUITE(BasicCanvasTest, ExactFormats);
+
+TYPED_TEST(BasicCanvasTest, MatchesMemoryCanvas) {
+    MemoryCanvas expected(18, 13);
+    BasicCanvas<TypeParam> canvas(18, 13);
+    drawScene(expected);
+    drawScene(canvas);
+    for(int y = 0; y < expected.height(); ++y) {
+        for(int x = 0; x < expected.width(); ++x) {
+            const uint32_t pixel = expected.pixel(x, y);
+            const pixel_formats::Rgb color{MemoryCanvas::red(pixel), MemoryCanvas::green(pixel), MemoryCanvas::blue(pixel)};
+            ASSERT_EQ(canvas.color(x, y), color) << "at " << x << ", " << y;
+        }
+    }
+}
+
+TEST(BasicCanvasRgb888Test, BlendsLikeTheKernels) {
+    BasicCanvas<pixel_formats::Rgb888> canvas(1, 1);
+    const auto& kernels = pixel_kernels::scalarKernels();
+    for(int alpha = 0; alpha < 256; ++alpha) {
+        canvas.setPixel(0, 0, 200, 37, 0);
+        canvas.setPixelRGBA(0, 0, 13, 255, 101, static_cast<uint8_t>(alpha));
+        uint32_t expected = MemoryCanvas::pack(200, 37, 0);
+        const uint32_t source = MemoryCanvas::pack(13, 255, 101);
+        kernels.blend(&expected, &source, 1, static_cast<uint8_t>(alpha));
+        const auto blended = pixel_formats::Rgb888::unpack(canvas.pixel(0, 0));
+        EXPECT_EQ(blended.red, MemoryCanvas::red(expected)) << alpha;
+        EXPECT_EQ(blended.green, MemoryCanvas::green(expected)) << alpha;
+        EXPECT_EQ(blended.blue, MemoryCanvas::blue(expected)) << alpha;
+    }
+}
+
+TEST(BasicCanvasRgb565Test, KeepsHighBits) {
+    BasicCanvas<pixel_formats::Rgb565> canvas(4, 4);
+    canvas.drawSpan(0, 3, 2, 0xff, 0x84, 0x08);
+    EXPECT_EQ(canvas.color(3, 2), (pixel_formats::Rgb{0xff, 0x86, 0x08}));
+    EXPECT_EQ(canvas.color(3, 1), (pixel_formats::Rgb{0, 0, 0}));
+
+    MemoryCanvas copy(4, 4);
+    canvas.copyTo(copy, Rect{0, 2, 4, 1});
+    EXPECT_EQ(copy.pixel(0, 2), MemoryCanvas::pack(0xff, 0x86, 0x08));
+}
@@ -0,0 +1,173 @@
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/CompositorRenderSurface.h>
+
+#include "MemoryRenderSurface.h"
+
+using namespace protogen;
+
+namespace {
+
+void drawRed(ICanvas& canvas) {
+    canvas.fill(255, 0, 0);
+}
+
+} // namespace
+
+TEST(CompositorRenderSurfaceTest, PassesFramesThroughWithoutLayers) {
+    auto target = std::make_shared<MemoryRenderSurface>(8, 4);
+    CompositorRenderSurface compositor(target);
+    EXPECT_EQ(compositor.resolution().width(), 8u);
+    EXPECT_EQ(compositor.resolution().height(), 4u);
+    EXPECT_EQ(compositor.getAttribute(attributes::A_ID), "memory");
+
+    ICanvas * drawn_on = nullptr;
+    compositor.drawFrame([&drawn_on](ICanvas& canvas){
+        drawn_on = &canvas;
+        canvas.setPixel(1, 1, 1, 2, 3);
+    });
+    EXPECT_EQ(drawn_on, &target->frame);
+    EXPECT_EQ(target->frame.pixel(1, 1), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(target->frames, 1);
+    // Nothing to show over the app.
+    compositor.refresh();
+    EXPECT_EQ(target->frames, 1);
+}
+
+TEST(CompositorRenderSurfaceTest, StacksLayersOverTheApp) {
+    auto target = std::make_shared<MemoryRenderSurface>(8, 4);
+    CompositorRenderSurface compositor(target);
+    // Added out of order; notifications stay above core overlays.
+    compositor.addLayer(CompositorRenderSurface::Level::Notification, [](ICanvas& canvas){
+        canvas.setPixel(2, 0, 0, 0, 255);
+    });
+    compositor.addLayer(CompositorRenderSurface::Level::CoreOverlay, [](ICanvas& canvas){
+        canvas.fillRegion(0, 0, 4, 1, 0, 255, 0);
+        canvas.setPixelRGBA(5, 0, 0, 0, 255, 0);   // Fully transparent.
+        canvas.setPixelRGBA(6, 0, 255, 255, 255, 128);
+    });
+
+    compositor.drawFrame(drawRed);
+    EXPECT_EQ(target->frame.pixel(0, 0), MemoryCanvas::pack(0, 255, 0));
+    EXPECT_EQ(target->frame.pixel(2, 0), MemoryCanvas::pack(0, 0, 255));
+    EXPECT_EQ(target->frame.pixel(5, 0), MemoryCanvas::pack(255, 0, 0));
+    EXPECT_EQ(target->frame.pixel(0, 1), MemoryCanvas::pack(255, 0, 0));
+    // Half of white over red.
+    const uint32_t mixed = target->frame.pixel(6, 0);
+    EXPECT_EQ(MemoryCanvas::red(mixed), 255);
+    EXPECT_NEAR(MemoryCanvas::green(mixed), 128, 1);
+    EXPECT_NEAR(MemoryCanvas::blue(mixed), 128, 1);
+    EXPECT_EQ(MemoryCanvas::alpha(mixed), 255);
+}
+
+TEST(CompositorRenderSurfaceTest, DrawsLayersOnlyWhenInvalidated) {
+    auto target = std::make_shared<MemoryRenderSurface>(8, 4);
+    CompositorRenderSurface compositor(target);
+    int layer_draws = 0;
+    int x = 0;
+    auto layer = compositor.addLayer(CompositorRenderSurface::Level::CoreOverlay, [&layer_draws, &x](ICanvas& canvas){
+        ++layer_draws;
+        canvas.setPixel(x, 3, 255, 255, 255);
+    });
+
+    compositor.drawFrame(drawRed);
+    compositor.drawFrame(drawRed);
+    EXPECT_EQ(layer_draws, 1);
+    EXPECT_EQ(target->frame.pixel(0, 3), MemoryCanvas::pack(255, 255, 255));
+
+    // What the layer drew before is erased when it draws again.
+    x = 7;
+    layer->invalidate();
+    compositor.drawFrame(drawRed);
+    EXPECT_EQ(layer_draws, 2);
+    EXPECT_EQ(target->frame.pixel(0, 3), MemoryCanvas::pack(255, 0, 0));
+    EXPECT_EQ(target->frame.pixel(7, 3), MemoryCanvas::pack(255, 255, 255));
+
+    layer->setVisible(false);
+    compositor.drawFrame(drawRed);
+    EXPECT_EQ(target->frame.pixel(7, 3), MemoryCanvas::pack(255, 0, 0));
+    layer->setVisible(true);
+    compositor.drawFrame(drawRed);
+    EXPECT_EQ(target->frame.pixel(7, 3), MemoryCanvas::pack(255, 255, 255));
+    EXPECT_EQ(layer_draws, 2);
+
+    layer->setDrawer([](ICanvas& canvas){
+        canvas.setPixel(3, 3, 0, 0, 255);
+    });
+    compositor.drawFrame(drawRed);
+    EXPECT_EQ(target->frame.pixel(7, 3), MemoryCanvas::pack(255, 0, 0));
+    EXPECT_EQ(target->frame.pixel(3, 3), MemoryCanvas::pack(0, 0, 255));
+}
+
+TEST(CompositorRenderSurfaceTest, RefreshShowsLayerChangesOverTheLastAppFrame) {
+    auto target = std::make_shared<MemoryRenderSurface>(8, 4);
+    CompositorRenderSurface compositor(target);
+    auto layer = compositor.addLayer(CompositorRenderSurface::Level::Notification, [](ICanvas&){});
+    // No app frame to show the layer over yet.
+    compositor.refresh();
+    EXPECT_EQ(target->frames, 0);
+
+    int app_draws = 0;
+    compositor.drawFrame([&app_draws](ICanvas& canvas){
+        ++app_draws;
+        canvas.setPixel(0, 0, 9, 9, 9);
+    });
+    EXPECT_EQ(target->frames, 1);
+    // Nothing changed.
+    compositor.refresh();
+    EXPECT_EQ(target->frames, 1);
+
+    layer->setDrawer([](ICanvas& canvas){
+        canvas.setPixel(1, 0, 0, 255, 0);
+    });
+    compositor.refresh();
+    EXPECT_EQ(target->frames, 2);
+    EXPECT_EQ(app_draws, 1);
+    EXPECT_EQ(target->frame.pixel(0, 0), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(target->frame.pixel(1, 0), MemoryCanvas::pack(0, 255, 0));
+
+    // Removing the last layer shows the app frame alone.
+    compositor.removeLayer(layer);
+    compositor.refresh();
+    EXPECT_EQ(target->frames, 3);
+    EXPECT_EQ(target->frame.pixel(0, 0), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(target->frame.pixel(1, 0), 0u);
+    // And later frames pass straight through again.
+    compositor.drawFrame([](ICanvas& canvas){
+        canvas.setPixel(1, 0, 1, 1, 1);
+    });
+    EXPECT_EQ(target->frame.pixel(1, 0), MemoryCanvas::pack(1, 1, 1));
+    compositor.refresh();
+    EXPECT_EQ(target->frames, 4);
+}
+
+TEST(CompositorRenderSurfaceTest, HandsOnlyWhatWasDrawnToTheWrappedSurface) {
+    auto target = std::make_shared<MemoryRenderSurface>(16, 8);
+    CompositorRenderSurface compositor(target);
+    compositor.addLayer(CompositorRenderSurface::Level::CoreOverlay, [](ICanvas& canvas){
+        canvas.fillRegion(12, 0, 4, 2, 0, 255, 0);
+    });
+    const auto draw_at = [&compositor](int x){
+        compositor.drawFrame([x](ICanvas& canvas){
+            canvas.setPixel(x, 5, 255, 0, 0);
+        });
+    };
+
+    draw_at(1);
+    EXPECT_EQ(target->frame.pixel(1, 5), MemoryCanvas::pack(255, 0, 0));
+    EXPECT_EQ(target->frame.pixel(12, 0), MemoryCanvas::pack(0, 255, 0));
+    // Nothing else was handed over.
+    EXPECT_EQ(target->frame.pixel(0, 0), 0u);
+    EXPECT_EQ(target->frame.pixel(8, 4), 0u);
+
+    // What the app drew before is not shown anymore.
+    draw_at(3);
+    EXPECT_EQ(target->frame.pixel(1, 5), 0u);
+    EXPECT_EQ(target->frame.pixel(3, 5), MemoryCanvas::pack(255, 0, 0));
+    EXPECT_EQ(target->frame.pixel(15, 1), MemoryCanvas::pack(0, 255, 0));
+}
@@ -0,0 +1,65 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/DirtyRegion.h>
+#include <protogen/presentation/DirtyTrackingCanvas.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+using namespace protogen;
+
+TEST(DirtyRegionTest, MergesTouchingRects) {
+    DirtyRegion region;
+    region.add({0, 0, 2, 2});
+    region.add({2, 0, 2, 2});
+    ASSERT_EQ(region.rects().size(), 1u);
+    EXPECT_EQ(region.area(), 8);
+
+    region.add({10, 10, 1, 1});
+    region.add({1, 1, 1, 1});
+    EXPECT_EQ(region.rects().size(), 2u);
+    EXPECT_EQ(region.area(), 9);
+
+    region.add({0, 0, 0, 5});
+    EXPECT_EQ(region.area(), 9);
+}
+
+TEST(DirtyRegionTest, CollapsesWhenTooFragmented) {
+    DirtyRegion region;
+    for(int i = 0; i <= static_cast<int>(DirtyRegion::MAX_RECTS); ++i) {
+        region.add({i * 4, 0, 1, 1});
+    }
+    ASSERT_EQ(region.rects().size(), 1u);
+    const Rect bounds = region.bounds();
+    EXPECT_EQ(bounds.x, 0);
+    EXPECT_EQ(bounds.width, static_cast<int>(DirtyRegion::MAX_RECTS) * 4 + 1);
+}
+
+TEST(DirtyTrackingCanvasTest, RecordsClippedDrawing) {
+    MemoryCanvas target(16, 8);
+    DirtyTrackingCanvas canvas(target);
+    EXPECT_TRUE(canvas.dirtyRegion().empty());
+
+    canvas.fillRegion(-4, -4, 6, 6, 1, 1, 1);
+    canvas.drawLine(10, 7, 12, 20, 1, 1, 1);
+    ASSERT_EQ(canvas.dirtyRegion().rects().size(), 2u);
+    EXPECT_EQ(canvas.dirtyRegion().area(), 4 + 3);
+    EXPECT_EQ(target.pixel(1, 1), MemoryCanvas::pack(1, 1, 1));
+
+    canvas.resetDirtyRegion();
+    canvas.drawPolygon({{20, 20}, {30, 20}, {30, 30}}, 1, 1, 1, true);
+    EXPECT_TRUE(canvas.dirtyRegion().empty());
+}
+
+TEST(DirtyTrackingCanvasTest, ClearOnlyErasesDrawnPixels) {
+    MemoryCanvas target(8, 8);
+    DirtyTrackingCanvas canvas(target, true);
+    canvas.setPixel(3, 3, 9, 9, 9);
+    canvas.clear();
+    EXPECT_EQ(MemoryCanvas::red(target.pixel(3, 3)), 0);
+    EXPECT_EQ(canvas.dirtyRegion().area(), 1);
+
+    DirtyTrackingCanvas unknown(target);
+    unknown.clear();
+    EXPECT_EQ(unknown.dirtyRegion().area(), 64);
+}
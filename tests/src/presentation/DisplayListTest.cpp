@@ -0,0 +1,83 @@
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/DisplayList.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/RecordingCanvas.h>
+
+using namespace protogen;
+
+namespace {
+
+void drawScene(ICanvas& canvas) {
+    canvas.fill(1, 2, 3);
+    canvas.setPixel(0, 0, 255, 0, 0);
+    canvas.fillRegion(-3, 2, 6, 4, 0, 255, 0);
+    canvas.drawSpan(20, 4, 9, 0, 0, 255);
+    canvas.drawLine(0, 15, 15, 0, 9, 9, 9);
+    canvas.drawPolygon({{5, 5}, {14, 7}, {8, 14}}, 200, 100, 50, true);
+    canvas.drawEllipse(2, 2, 9, 6, 7, 7, 7, false);
+    canvas.setPixelRGBA(15, 15, 255, 255, 255, 128);
+
+    std::vector<uint8_t> rgb(5 * 4 * 3);
+    std::vector<uint8_t> mask(5 * 4);
+    std::vector<uint8_t> rgba(5 * 4 * 4);
+    for(std::size_t i = 0; i < mask.size(); ++i) {
+        rgb[i * 3] = static_cast<uint8_t>(i * 10);
+        rgb[i * 3 + 1] = static_cast<uint8_t>(i);
+        rgb[i * 3 + 2] = 77;
+        mask[i] = i % 3;
+        std::memcpy(&rgba[i * 4], &rgb[i * 3], 3);
+        rgba[i * 4 + 3] = static_cast<uint8_t>(i * 13);
+    }
+    canvas.blit(rgb.data(), 5 * 3, 13, -1, 5, 4);
+    canvas.blitMasked(rgb.data(), 5 * 3, mask.data(), 5, 1, 10, 5, 4);
+    canvas.blendBlit(rgba.data(), 5 * 4, -2, 12, 5, 4);
+}
+
+void expectSamePixels(const MemoryCanvas& a, const MemoryCanvas& b) {
+    for(int y = 0; y < a.height(); ++y) {
+        for(int x = 0; x < a.width(); ++x) {
+            ASSERT_EQ(a.pixel(x, y), b.pixel(x, y)) << "at " << x << ", " << y;
+        }
+    }
+}
+
+} // namespace
+
+TEST(DisplayListTest, ReplayMatchesDirectDrawing) {
+    MemoryCanvas direct(16, 16);
+    drawScene(direct);
+
+    DisplayList list;
+    RecordingCanvas recorder(list, 16, 16);
+    drawScene(recorder);
+    EXPECT_EQ(list.size(), 11u);
+
+    MemoryCanvas replayed(16, 16);
+    list.replay(replayed);
+    expectSamePixels(direct, replayed);
+}
+
+TEST(DisplayListTest, ClearKeepsStorage) {
+    DisplayList list;
+    RecordingCanvas recorder(list, 16, 16);
+    drawScene(recorder);
+    const std::size_t bytes = list.bytes();
+    EXPECT_GT(bytes, 0u);
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.bytes(), 0u);
+    drawScene(recorder);
+    EXPECT_EQ(list.bytes(), bytes);
+
+    DisplayList moved(std::move(list));
+    EXPECT_EQ(moved.size(), 11u);
+    EXPECT_TRUE(list.empty());
+    MemoryCanvas canvas(16, 16);
+    list.replay(canvas);
+    EXPECT_EQ(canvas.pixel(3, 3), 0u);
+}
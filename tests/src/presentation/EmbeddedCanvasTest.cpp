@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/EmbeddedCanvas.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+using namespace protogen;
+
+TEST(EmbeddedCanvasTest, TranslatesAndClipsToWindow) {
+    MemoryCanvas target(10, 10);
+    EmbeddedCanvas canvas(target, Window{4, 2, Resolution(3, 3)});
+    canvas.setPixel(0, 0, 1, 1, 1);
+    canvas.setPixel(3, 0, 2, 2, 2);
+    canvas.drawSpan(-5, 10, 2, 3, 3, 3);
+    EXPECT_EQ(target.pixel(4, 2), MemoryCanvas::pack(1, 1, 1));
+    EXPECT_EQ(target.pixel(7, 2), 0u);
+    EXPECT_EQ(target.pixel(3, 4), 0u);
+    EXPECT_EQ(target.pixel(4, 4), MemoryCanvas::pack(3, 3, 3));
+    EXPECT_EQ(target.pixel(6, 4), MemoryCanvas::pack(3, 3, 3));
+    EXPECT_EQ(target.pixel(7, 4), 0u);
+
+    const uint8_t rgb[4 * 3] = {10, 10, 10, 20, 20, 20, 30, 30, 30, 40, 40, 40};
+    canvas.blit(rgb, 4 * 3, 1, 1, 4, 1);
+    EXPECT_EQ(target.pixel(5, 3), MemoryCanvas::pack(10, 10, 10));
+    EXPECT_EQ(target.pixel(6, 3), MemoryCanvas::pack(20, 20, 20));
+    EXPECT_EQ(target.pixel(7, 3), 0u);
+}
+
+TEST(EmbeddedCanvasTest, ClearAndFillOnlyTouchTheWindow) {
+    MemoryCanvas target(6, 6);
+    target.fill(5, 5, 5);
+    EmbeddedCanvas canvas(target, Window{1, 1, Resolution(2, 3)});
+    canvas.clear();
+    EXPECT_EQ(target.pixel(1, 1), MemoryCanvas::pack(0, 0, 0));
+    EXPECT_EQ(target.pixel(2, 3), MemoryCanvas::pack(0, 0, 0));
+    EXPECT_EQ(target.pixel(3, 1), MemoryCanvas::pack(5, 5, 5));
+    EXPECT_EQ(target.pixel(1, 4), MemoryCanvas::pack(5, 5, 5));
+    canvas.fill(7, 7, 7);
+    EXPECT_EQ(target.pixel(2, 3), MemoryCanvas::pack(7, 7, 7));
+    EXPECT_EQ(target.pixel(0, 0), MemoryCanvas::pack(5, 5, 5));
+}
@@ -0,0 +1,85 @@
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/render_surface.h>
+
+using namespace protogen;
+
+TEST(FakeRenderSurfaceTest, DrawsAtTheChosenResolution) {
+    FakeRenderSurface surface(Resolution(64, 16));
+    EXPECT_EQ(surface.resolution().width(), 64u);
+    EXPECT_EQ(surface.resolution().height(), 16u);
+    surface.drawFrame([](ICanvas& canvas){
+        EXPECT_EQ(canvas.width(), 64);
+        EXPECT_EQ(canvas.height(), 16);
+        canvas.setPixel(63, 15, 1, 2, 3);
+    });
+    EXPECT_EQ(surface.canvas().pixel(63, 15), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(surface.getAttribute(attributes::A_PRESENTED_FRAMES), "1");
+    EXPECT_TRUE(surface.hasAttribute(attributes::A_DRAWER_TIME));
+}
+
+TEST(FakeRenderSurfaceTest, OnlyTimesDrawersWithoutRasterizing) {
+    FakeRenderSurface surface;
+    surface.drawFrame([](ICanvas& canvas){
+        EXPECT_EQ(canvas.width(), static_cast<int>(FakeRenderSurface::DEFAULT_WIDTH));
+        EXPECT_EQ(canvas.height(), static_cast<int>(FakeRenderSurface::DEFAULT_HEIGHT));
+        canvas.fill(255, 255, 255);
+    });
+    EXPECT_EQ(surface.canvas().width(), 0);
+    EXPECT_EQ(surface.report().frames, 1u);
+    EXPECT_EQ(surface.report().drawer_time_ns.count, 1u);
+    EXPECT_EQ(surface.report().counts.totalCalls(), 0u);
+}
+
+TEST(FakeRenderSurfaceTest, CountsPrimitivesPixelsAndSpans) {
+    FakeRenderSurface surface(Resolution(10, 10));
+    const auto draw = [](ICanvas& canvas){
+        canvas.fill(0, 0, 0);
+        canvas.setPixel(1, 1, 255, 0, 0);
+        canvas.setPixel(-1, 1, 255, 0, 0);     // Clipped away.
+        canvas.fillRegion(8, 8, 4, 4, 0, 255, 0); // 2x2 visible.
+        canvas.drawSpan(0, 4, 3, 0, 0, 255);
+        canvas.drawPolygon({{0, 0}, {9, 0}, {9, 9}, {0, 9}}, 1, 1, 1, true);
+    };
+    surface.drawFrame(draw);
+    surface.drawFrame(draw);
+
+    const auto report = surface.report();
+    EXPECT_EQ(report.frames, 2u);
+    EXPECT_EQ(report.drawer_time_ns.count, 2u);
+    EXPECT_EQ(report.counts.calls[DrawCounts::Fill], 2u);
+    EXPECT_EQ(report.counts.calls[DrawCounts::SetPixel], 4u);
+    EXPECT_EQ(report.counts.calls[DrawCounts::FillRegion], 2u);
+    EXPECT_EQ(report.counts.calls[DrawCounts::DrawSpan], 2u);
+    // The polygon is one call; its outline and fill are not.
+    EXPECT_EQ(report.counts.calls[DrawCounts::DrawPolygon], 2u);
+    EXPECT_EQ(report.counts.calls[DrawCounts::DrawLine], 0u);
+    // Ten rows of fill plus the span drawn directly, per frame, and any
+    // spans the outline is drawn with.
+    EXPECT_GE(report.counts.spans, 2u * 11u);
+    EXPECT_GE(report.counts.pixels, 2u * (100u + 1u + 4u + 5u + 100u));
+
+    std::ostringstream out;
+    report.print(out);
+    EXPECT_NE(out.str().find("2 frames"), std::string::npos);
+    EXPECT_NE(out.str().find("drawPolygon"), std::string::npos);
+    EXPECT_EQ(out.str().find("blendBlit"), std::string::npos);
+
+    surface.resetReport();
+    EXPECT_EQ(surface.report().frames, 0u);
+    EXPECT_EQ(surface.report().counts.totalCalls(), 0u);
+}
+
+TEST(FakeRenderSurfaceTest, TimesEachSurfaceOnItsOwn) {
+    FakeRenderSurface first(Resolution(4, 4));
+    FakeRenderSurface second(Resolution(4, 4));
+    first.drawFrame([](ICanvas&){});
+    first.drawFrame([](ICanvas&){});
+    second.drawFrame([](ICanvas&){});
+    EXPECT_EQ(first.report().drawer_time_ns.count, 2u);
+    EXPECT_EQ(second.report().drawer_time_ns.count, 1u);
+}
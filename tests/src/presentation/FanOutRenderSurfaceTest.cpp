@@ -0,0 +1,62 @@
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/FanOutRenderSurface.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+#include "MemoryRenderSurface.h"
+
+using namespace protogen;
+
+TEST(FanOutRenderSurfaceTest, DrawsOnceForEveryOutput) {
+    auto first = std::make_shared<MemoryRenderSurface>(8, 4);
+    auto second = std::make_shared<MemoryRenderSurface>(8, 4);
+    FanOutRenderSurface surface({{first, FanOutRenderSurface::Fit::Scale}, {second, FanOutRenderSurface::Fit::Crop}}, Resolution(8, 4));
+    ASSERT_EQ(surface.initialize(), IExtension::Initialization::Success);
+
+    int draws = 0;
+    for(int i = 0; i < 3; ++i) {
+        surface.drawFrame([&draws, i](ICanvas& canvas){
+            ++draws;
+            canvas.setPixel(0, 0, 255, 255, 255);
+            canvas.setPixel(i, 2, 10, 20, 30);
+        });
+    }
+    EXPECT_EQ(draws, 3);
+    for(const auto& output : {first, second}) {
+        EXPECT_EQ(output->frame.pixel(0, 0), MemoryCanvas::pack(255, 255, 255));
+        EXPECT_EQ(output->frame.pixel(2, 2), MemoryCanvas::pack(10, 20, 30));
+        EXPECT_EQ(output->frame.pixel(1, 2), MemoryCanvas::pack(0, 0, 0));
+    }
+}
+
+TEST(FanOutRenderSurfaceTest, ScalesToOutputResolution) {
+    auto output = std::make_shared<MemoryRenderSurface>(8, 4);
+    FanOutRenderSurface surface({{output, FanOutRenderSurface::Fit::Scale}}, Resolution(4, 2));
+    surface.drawFrame([](ICanvas& canvas){
+        canvas.setPixel(1, 1, 1, 2, 3);
+    });
+    for(int y = 0; y < 4; ++y) {
+        for(int x = 0; x < 8; ++x) {
+            const bool lit = (x == 2 || x == 3) && (y == 2 || y == 3);
+            EXPECT_EQ(output->frame.pixel(x, y), lit ? MemoryCanvas::pack(1, 2, 3) : 0u) << x << ", " << y;
+        }
+    }
+}
+
+TEST(FanOutRenderSurfaceTest, CropsAroundTheCenter) {
+    auto smaller = std::make_shared<MemoryRenderSurface>(2, 2);
+    auto larger = std::make_shared<MemoryRenderSurface>(6, 6);
+    FanOutRenderSurface surface({{smaller, FanOutRenderSurface::Fit::Crop}, {larger, FanOutRenderSurface::Fit::Crop}}, Resolution(4, 4));
+    surface.drawFrame([](ICanvas& canvas){
+        canvas.fill(0, 0, 0);
+        canvas.setPixel(1, 1, 9, 9, 9);
+        canvas.setPixel(3, 3, 7, 7, 7);
+    });
+    EXPECT_EQ(smaller->frame.pixel(0, 0), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(larger->frame.pixel(2, 2), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(larger->frame.pixel(4, 4), MemoryCanvas::pack(7, 7, 7));
+    EXPECT_EQ(larger->frame.pixel(0, 0), 0u);
+}
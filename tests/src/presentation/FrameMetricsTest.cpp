@@ -0,0 +1,119 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/FrameMetrics.h>
+#include <protogen/presentation/FrameTimingRenderSurface.h>
+#include <protogen/presentation/render_surface.h>
+
+using namespace protogen;
+
+TEST(FrameMetricsTest, RecordsFrameTimings) {
+    using namespace std::chrono_literals;
+    FrameTimings timings;
+    const auto start = std::chrono::steady_clock::now();
+    timings.recordFrame(start, 2ms);
+    timings.recordPresent(1ms);
+    timings.recordFrame(start + 16ms, 3ms);
+    timings.recordMissedDeadline();
+
+    const auto snapshot = timings.snapshot();
+    EXPECT_EQ(snapshot.frames, 2u);
+    EXPECT_EQ(snapshot.missed_deadlines, 1u);
+    EXPECT_EQ(snapshot.drawer_time.count, 2u);
+    EXPECT_EQ(snapshot.drawer_time.min, 2000000u);
+    EXPECT_EQ(snapshot.drawer_time.max, 3000000u);
+    EXPECT_EQ(snapshot.present_time.count, 1u);
+    // The first frame has no interval.
+    EXPECT_EQ(snapshot.frame_interval.count, 1u);
+    EXPECT_EQ(snapshot.frame_interval.max, 16000000u);
+
+    timings.reset();
+    EXPECT_EQ(timings.snapshot().frames, 0u);
+    timings.recordFrame(start + 32ms, 1ms);
+    EXPECT_EQ(timings.snapshot().frame_interval.count, 0u);
+}
+
+TEST(FrameMetricsTest, SharesTimingsById) {
+    FrameMetrics metrics;
+    const auto a = metrics.timings(FrameMetrics::Source::Surface, "a");
+    EXPECT_EQ(metrics.timings(FrameMetrics::Source::Surface, "a"), a);
+    EXPECT_NE(metrics.timings(FrameMetrics::Source::App, "a"), a);
+    EXPECT_EQ(metrics.snapshot().size(), 2u);
+}
+
+TEST(FrameMetricsTest, KeepsInstancesApart) {
+    FrameMetrics metrics;
+    const auto first = metrics.addInstance(FrameMetrics::Source::Surface, "a");
+    const auto second = metrics.addInstance(FrameMetrics::Source::Surface, "a");
+    EXPECT_NE(first, second);
+    EXPECT_EQ(metrics.timings(FrameMetrics::Source::Surface, "a"), first);
+    EXPECT_EQ(metrics.timings(FrameMetrics::Source::Surface, "a#2"), second);
+    EXPECT_EQ(metrics.snapshot().size(), 2u);
+}
+
+TEST(FrameMetricsTest, WritesJson) {
+    using namespace std::chrono_literals;
+    FrameMetrics metrics;
+    EXPECT_EQ(metrics.toJson(), "{\"surfaces\": {}, \"apps\": {}}");
+
+    metrics.timings(FrameMetrics::Source::Surface, "hub75_display")->recordFrame(std::chrono::steady_clock::now(), 1500us);
+    metrics.timings(FrameMetrics::Source::App, "quote\"app")->recordMissedDeadline();
+    const auto json = metrics.toJson();
+    EXPECT_NE(json.find("\"surfaces\": {\"hub75_display\": {\"frames\": 1, \"missed_deadlines\": 0, \"drawer_time_us\": {\"count\": 1, \"mean\": 1500.0, \"min\": 1500.0"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"apps\": {\"quote\\\"app\": {\"frames\": 0, \"missed_deadlines\": 1"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"frame_interval_us\": {\"count\": 0"), std::string::npos) << json;
+
+    metrics.reset();
+    EXPECT_NE(metrics.toJson().find("\"hub75_display\": {\"frames\": 0"), std::string::npos);
+}
+
+TEST(FrameMetricsTest, RecordsFromManyThreads) {
+    FrameMetrics metrics;
+    const auto timings = metrics.timings(FrameMetrics::Source::App, "app");
+    std::vector<std::thread> threads;
+    for(int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([timings]{
+            for(int frame = 0; frame < 1000; ++frame) {
+                timings->recordFrame(std::chrono::steady_clock::now(), std::chrono::microseconds(frame));
+                timings->recordPresent(std::chrono::microseconds(frame));
+                timings->recordMissedDeadline();
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    const auto snapshot = timings->snapshot();
+    EXPECT_EQ(snapshot.frames, 4000u);
+    EXPECT_EQ(snapshot.missed_deadlines, 4000u);
+    EXPECT_EQ(snapshot.drawer_time.count, 4000u);
+    EXPECT_EQ(snapshot.present_time.count, 4000u);
+}
+
+TEST(FrameMetricsTest, TimesFramesOfWrappedSurface) {
+    const auto timings = std::make_shared<FrameTimings>();
+    FrameTimingRenderSurface surface(std::make_shared<FakeRenderSurface>(Resolution(8, 8)), timings);
+    EXPECT_EQ(surface.resolution().width(), 8u);
+    EXPECT_EQ(surface.getAttribute(attributes::A_ID), "fake_render_surface");
+
+    bool drawn = false;
+    surface.drawFrame([&drawn](ICanvas& canvas){
+        EXPECT_EQ(canvas.width(), 8);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        drawn = true;
+    });
+    surface.drawFrame([](ICanvas&){});
+    EXPECT_TRUE(drawn);
+
+    const auto snapshot = timings->snapshot();
+    EXPECT_EQ(snapshot.frames, 2u);
+    EXPECT_EQ(snapshot.present_time.count, 2u);
+    EXPECT_EQ(snapshot.frame_interval.count, 1u);
+    EXPECT_GE(snapshot.drawer_time.max, 2000000u);
+    EXPECT_GE(snapshot.frame_interval.max, 2000000u);
+}
@@ -0,0 +1,248 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/FrameRecording.h>
+#include <protogen/presentation/FrameReplay.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/RecorderSink.h>
+#include <protogen/presentation/TeeRenderSurface.h>
+
+#include "MemoryRenderSurface.h"
+
+using namespace protogen;
+
+namespace {
+
+/**
+ * Keeps a copy of every frame it shows.
+ */
+class KeepingRenderSurface : public MemoryRenderSurface {
+public:
+    using MemoryRenderSurface::MemoryRenderSurface;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override {
+        MemoryRenderSurface::drawFrame(drawer);
+        history.push_back(frame);
+    }
+
+    std::vector<MemoryCanvas> history;
+};
+
+std::string temporaryPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("protogen_" + name + "_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".rec")).string();
+}
+
+void drawScene(ICanvas& canvas, int frame) {
+    canvas.fill(0, 0, 40);
+    canvas.fillRegion(frame % canvas.width(), 2, 5, 4, 255, frame * 10, 0);
+    canvas.setPixel(canvas.width() - 1, canvas.height() - 1, frame, 1, 2);
+}
+
+bool sameColors(const MemoryCanvas& a, const MemoryCanvas& b) {
+    for(int y = 0; y < a.height(); ++y) {
+        for(int x = 0; x < a.width(); ++x) {
+            if(MemoryCanvas::red(a.pixel(x, y)) != MemoryCanvas::red(b.pixel(x, y))
+                || MemoryCanvas::green(a.pixel(x, y)) != MemoryCanvas::green(b.pixel(x, y))
+                || MemoryCanvas::blue(a.pixel(x, y)) != MemoryCanvas::blue(b.pixel(x, y))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(FrameRecordingTest, ReplaysEveryRecordedFrame) {
+    const std::string path = temporaryPath("replay");
+    auto shown = std::make_shared<KeepingRenderSurface>(16, 8);
+    {
+        auto recorder = std::make_shared<RecorderSink>(shown->resolution(), path, 4);
+        ASSERT_EQ(recorder->initialize(), IInitializable::Initialization::Success);
+        TeeRenderSurface tee(shown);
+        tee.addSink(recorder, TeeRenderSurface::Delivery::EveryFrame);
+        for(int i = 0; i < 10; ++i) {
+            tee.drawFrame([i](ICanvas& canvas){ drawScene(canvas, i); });
+        }
+        EXPECT_EQ(recorder->frameCount(), 10u);
+    }
+    ASSERT_EQ(shown->history.size(), 10u);
+
+    FrameRecording recording(path);
+    EXPECT_EQ(recording.width(), 16);
+    EXPECT_EQ(recording.height(), 8);
+    ASSERT_EQ(recording.frameCount(), 10u);
+    EXPECT_EQ(recording.timestamp(0).count(), 0);
+    for(std::size_t i = 1; i < recording.frameCount(); ++i) {
+        EXPECT_GE(recording.timestamp(i), recording.timestamp(i - 1));
+        EXPECT_EQ(recording.isKeyFrame(i), i % 4 == 0);
+    }
+    EXPECT_EQ(recording.duration(), recording.timestamp(9));
+
+    auto replayed = std::make_shared<KeepingRenderSurface>(16, 8);
+    FrameReplay replay(recording, replayed);
+    const auto result = replay.run(FrameReplay::Timing::AsFastAsPossible, 2);
+    EXPECT_EQ(result.frames, 20u);
+    EXPECT_EQ(result.malformed_frames, 0u);
+    ASSERT_EQ(replayed->history.size(), 20u);
+    for(std::size_t i = 0; i < replayed->history.size(); ++i) {
+        EXPECT_TRUE(sameColors(replayed->history[i], shown->history[i % 10])) << "frame " << i;
+    }
+
+    std::vector<uint8_t> rgb;
+    ASSERT_TRUE(recording.seek(6, rgb));
+    const auto expected = shown->history[6].pixel(15, 7);
+    EXPECT_EQ(rgb[(7 * 16 + 15) * 3], MemoryCanvas::red(expected));
+
+    std::filesystem::remove(path);
+}
+
+TEST(FrameRecordingTest, ReplaysAtTheOriginalTiming) {
+    const std::string path = temporaryPath("timing");
+    auto shown = std::make_shared<MemoryRenderSurface>(4, 4);
+    {
+        auto recorder = std::make_shared<RecorderSink>(shown->resolution(), path);
+        ASSERT_EQ(recorder->initialize(), IInitializable::Initialization::Success);
+        TeeRenderSurface tee(shown);
+        tee.addSink(recorder, TeeRenderSurface::Delivery::EveryFrame);
+        for(int i = 0; i < 3; ++i) {
+            tee.drawFrame([i](ICanvas& canvas){ drawScene(canvas, i); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    FrameRecording recording(path);
+    ASSERT_EQ(recording.frameCount(), 3u);
+    EXPECT_GE(recording.duration(), std::chrono::milliseconds(40));
+
+    FrameReplay replay(recording, std::make_shared<MemoryRenderSurface>(4, 4));
+    const auto result = replay.run(FrameReplay::Timing::Original);
+    EXPECT_EQ(result.frames, 3u);
+    EXPECT_GE(result.elapsed, recording.duration());
+
+    std::filesystem::remove(path);
+}
+
+TEST(FrameRecordingTest, ReadsUnfinishedRecordings) {
+    const std::string path = temporaryPath("unfinished");
+    auto shown = std::make_shared<MemoryRenderSurface>(8, 4);
+    {
+        auto recorder = std::make_shared<RecorderSink>(shown->resolution(), path);
+        ASSERT_EQ(recorder->initialize(), IInitializable::Initialization::Success);
+        TeeRenderSurface tee(shown);
+        tee.addSink(recorder, TeeRenderSurface::Delivery::EveryFrame);
+        for(int i = 0; i < 5; ++i) {
+            tee.drawFrame([i](ICanvas& canvas){ drawScene(canvas, i); });
+        }
+    }
+
+    // Cut the file in the middle of the last frame, as if recording had
+    // stopped there, and forget the index.
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto header = *reinterpret_cast<const frame_recording::Header *>(bytes.data());
+    std::vector<uint64_t> offsets(header.frame_count);
+    std::memcpy(offsets.data(), bytes.data() + header.index_offset, offsets.size() * sizeof(uint64_t));
+    bytes.resize(offsets.back() + sizeof(frame_recording::FrameHeader) + 1);
+    header.frame_count = 0;
+    header.index_offset = 0;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    FrameRecording recording(path);
+    ASSERT_EQ(recording.frameCount(), 4u);
+    std::vector<uint8_t> rgb;
+    ASSERT_TRUE(recording.seek(3, rgb));
+    EXPECT_EQ(rgb[(3 * 8 + 7) * 3], 3);
+
+    std::filesystem::remove(path);
+}
+
+TEST(FrameRecordingTest, SkipsToTheNextKeyFrameAfterAMalformedFrame) {
+    const std::string path = temporaryPath("malformed");
+    auto shown = std::make_shared<KeepingRenderSurface>(8, 4);
+    {
+        auto recorder = std::make_shared<RecorderSink>(shown->resolution(), path, 4);
+        ASSERT_EQ(recorder->initialize(), IInitializable::Initialization::Success);
+        TeeRenderSurface tee(shown);
+        tee.addSink(recorder, TeeRenderSurface::Delivery::EveryFrame);
+        for(int i = 0; i < 10; ++i) {
+            tee.drawFrame([i](ICanvas& canvas){ drawScene(canvas, i); });
+        }
+    }
+
+    // Break the type of delta frame 5.
+    uint64_t offset = 0;
+    {
+        FrameRecording recording(path);
+        ASSERT_FALSE(recording.isKeyFrame(5));
+        std::ifstream in(path, std::ios::binary);
+        frame_recording::Header header;
+        in.read(reinterpret_cast<char *>(&header), sizeof(header));
+        in.seekg(static_cast<std::streamoff>(header.index_offset + 5 * sizeof(uint64_t)));
+        in.read(reinterpret_cast<char *>(&offset), sizeof(offset));
+    }
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset + sizeof(frame_recording::FrameHeader)));
+        file.put(static_cast<char>(0x7f));
+    }
+
+    FrameRecording recording(path);
+    auto replayed = std::make_shared<KeepingRenderSurface>(8, 4);
+    FrameReplay replay(recording, replayed);
+    const auto result = replay.run(FrameReplay::Timing::AsFastAsPossible);
+    // Frames 5 to 7 are not drawn; frame 8 is the next key frame.
+    EXPECT_EQ(result.malformed_frames, 3u);
+    ASSERT_EQ(result.frames, 7u);
+    ASSERT_EQ(replayed->history.size(), 7u);
+    EXPECT_TRUE(sameColors(replayed->history[4], shown->history[4]));
+    EXPECT_TRUE(sameColors(replayed->history[5], shown->history[8]));
+    EXPECT_TRUE(sameColors(replayed->history[6], shown->history[9]));
+
+    std::filesystem::remove(path);
+}
+
+TEST(FrameRecordingTest, FlushesWhileRecording) {
+    const std::string path = temporaryPath("flushed");
+    auto shown = std::make_shared<MemoryRenderSurface>(8, 4);
+    auto recorder = std::make_shared<RecorderSink>(shown->resolution(), path);
+    ASSERT_EQ(recorder->initialize(), IInitializable::Initialization::Success);
+    TeeRenderSurface tee(shown);
+    tee.addSink(recorder, TeeRenderSurface::Delivery::EveryFrame);
+    tee.drawFrame([](ICanvas& canvas){ drawScene(canvas, 7); });
+
+    // Read while the recorder still has the file open.
+    FrameRecording recording(path);
+    ASSERT_EQ(recording.frameCount(), 1u);
+    std::vector<uint8_t> rgb;
+    ASSERT_TRUE(recording.seek(0, rgb));
+    EXPECT_EQ(rgb[(3 * 8 + 7) * 3], 7);
+
+    std::filesystem::remove(path);
+}
+
+TEST(FrameRecordingTest, RejectsOtherFiles) {
+    const std::string path = temporaryPath("other");
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << std::string(128, 'x');
+    }
+    EXPECT_THROW(FrameRecording recording(path), std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(FrameRecording recording(path), std::system_error);
+}
@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/Histogram.h>
+
+using namespace protogen;
+
+TEST(HistogramTest, SmallValuesHaveTheirOwnBuckets) {
+    for(uint64_t value = 0; value < Histogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(Histogram::bucketOf(value), value);
+        EXPECT_EQ(Histogram::bucketUpperBound(value), value);
+    }
+}
+
+TEST(HistogramTest, BucketsAreContiguousAndBounded) {
+    for(std::size_t bucket = 0; bucket + 1 < Histogram::BUCKETS; ++bucket) {
+        const uint64_t upper = Histogram::bucketUpperBound(bucket);
+        EXPECT_EQ(Histogram::bucketOf(upper), bucket);
+        EXPECT_EQ(Histogram::bucketOf(upper + 1), bucket + 1);
+    }
+    EXPECT_EQ(Histogram::bucketOf(UINT64_MAX), Histogram::BUCKETS - 1);
+    EXPECT_EQ(Histogram::bucketUpperBound(Histogram::BUCKETS - 1), UINT64_MAX);
+    // Buckets are never wider than 1/16 of the values in them.
+    for(const uint64_t value : {100ull, 1000ull, 16667ull, 123456789ull}) {
+        const uint64_t upper = Histogram::bucketUpperBound(Histogram::bucketOf(value));
+        EXPECT_LE(upper - value, value / Histogram::SUB_BUCKETS);
+    }
+}
+
+TEST(HistogramTest, ReportsPercentiles) {
+    Histogram histogram;
+    EXPECT_EQ(histogram.snapshot().percentile(50), 0u);
+    for(uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.min, 1u);
+    EXPECT_EQ(snapshot.max, 1000u);
+    EXPECT_DOUBLE_EQ(snapshot.mean(), 500.5);
+    EXPECT_GE(snapshot.percentile(50), 500u);
+    EXPECT_LE(snapshot.percentile(50), 500u + 500u / Histogram::SUB_BUCKETS);
+    EXPECT_GE(snapshot.percentile(99), 990u);
+    EXPECT_LE(snapshot.percentile(99), 1000u);
+    EXPECT_EQ(snapshot.percentile(100), 1000u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count, 0u);
+    EXPECT_EQ(histogram.snapshot().min, 0u);
+}
+
+TEST(HistogramTest, RecordsFromManyThreads) {
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram, t]{
+            for(int i = 0; i < 10000; ++i) {
+                histogram.record(t * 100 + i % 7);
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 40000u);
+    EXPECT_EQ(snapshot.min, 0u);
+    EXPECT_EQ(snapshot.max, 306u);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/ImageScaler.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+using namespace protogen;
+
+TEST(ImageScalerTest, NearestRepeatsPixelsByWholeFactors) {
+    MemoryCanvas source(2, 2);
+    source.setPixel(0, 0, 1, 0, 0);
+    source.setPixel(1, 0, 2, 0, 0);
+    source.setPixel(0, 1, 3, 0, 0);
+    source.setPixel(1, 1, 4, 0, 0);
+    MemoryCanvas target(6, 4);
+    ImageScaler scaler(2, 2, 6, 4, ImageScaler::Filter::Nearest);
+    scaler.scale(source, target);
+    for(int y = 0; y < 4; ++y) {
+        for(int x = 0; x < 6; ++x) {
+            EXPECT_EQ(target.pixel(x, y), source.pixel(x / 3, y / 2)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(ImageScalerTest, NearestDownscalesFromPixelCenters) {
+    MemoryCanvas source(4, 1);
+    for(int x = 0; x < 4; ++x) {
+        source.setPixel(x, 0, x, 0, 0);
+    }
+    MemoryCanvas target(2, 1);
+    ImageScaler scaler(4, 1, 2, 1, ImageScaler::Filter::Nearest);
+    scaler.scale(source, target);
+    EXPECT_EQ(target.pixel(0, 0), source.pixel(1, 0));
+    EXPECT_EQ(target.pixel(1, 0), source.pixel(3, 0));
+}
+
+TEST(ImageScalerTest, BilinearMixesNeighbours) {
+    MemoryCanvas source(2, 2);
+    source.fillRegion(0, 0, 2, 1, 0, 0, 0);
+    source.fillRegion(0, 1, 2, 1, 0, 0, 0);
+    source.setPixel(1, 0, 200, 0, 0);
+    source.setPixel(1, 1, 200, 0, 0);
+    MemoryCanvas target(4, 2);
+    ImageScaler scaler(2, 2, 4, 2, ImageScaler::Filter::Bilinear);
+    scaler.scale(source, target);
+    for(int y = 0; y < 2; ++y) {
+        EXPECT_EQ(target.pixel(0, y), MemoryCanvas::pack(0, 0, 0));
+        EXPECT_EQ(target.pixel(1, y), MemoryCanvas::pack(50, 0, 0));
+        EXPECT_EQ(target.pixel(2, y), MemoryCanvas::pack(150, 0, 0));
+        EXPECT_EQ(target.pixel(3, y), MemoryCanvas::pack(200, 0, 0));
+    }
+}
+
+TEST(ImageScalerTest, BilinearAtTheSameSizeCopies) {
+    MemoryCanvas source(5, 3);
+    for(int y = 0; y < 3; ++y) {
+        for(int x = 0; x < 5; ++x) {
+            source.setPixel(x, y, x * 40, y * 60, 7);
+        }
+    }
+    MemoryCanvas target(5, 3);
+    ImageScaler scaler(5, 3, 5, 3, ImageScaler::Filter::Bilinear);
+    scaler.scale(source, target);
+    for(int y = 0; y < 3; ++y) {
+        for(int x = 0; x < 5; ++x) {
+            EXPECT_EQ(target.pixel(x, y), source.pixel(x, y));
+        }
+    }
+}
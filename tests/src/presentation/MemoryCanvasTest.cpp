@@ -0,0 +1,200 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/PixelKernels.h>
+
+using namespace protogen;
+
+namespace {
+
+std::vector<uint32_t> randomPixels(std::size_t count, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::vector<uint32_t> pixels(count);
+    for(auto& pixel : pixels) {
+        pixel = generator();
+    }
+    return pixels;
+}
+
+} // namespace
+
+// Odd lengths make sure the scalar tails of the SIMD kernels are exercised.
+class PixelKernelsTest : public testing::TestWithParam<std::size_t> {};
+
+TEST_P(PixelKernelsTest, AllKernelsMatchScalar) {
+    const std::size_t count = GetParam();
+    const auto& scalar = pixel_kernels::scalarKernels();
+    const auto source = randomPixels(count, 1);
+    const auto destination = randomPixels(count, 2);
+    std::vector<uint8_t> rgb(count * 3);
+    for(std::size_t i = 0; i < rgb.size(); ++i) {
+        rgb[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    for(const auto * kernels : pixel_kernels::availableKernels()) {
+        SCOPED_TRACE(kernels->name);
+
+        std::vector<uint32_t> expected(count), actual(count);
+        scalar.fill(expected.data(), 0x12345678, count);
+        kernels->fill(actual.data(), 0x12345678, count);
+        EXPECT_EQ(actual, expected);
+
+        kernels->copy(actual.data(), source.data(), count);
+        EXPECT_EQ(actual, source);
+
+        for(const uint8_t alpha : {0, 1, 127, 128, 254, 255}) {
+            expected = destination;
+            actual = destination;
+            scalar.blend(expected.data(), source.data(), count, alpha);
+            kernels->blend(actual.data(), source.data(), count, alpha);
+            EXPECT_EQ(actual, expected) << "alpha " << int(alpha);
+        }
+
+        scalar.expandRgb(expected.data(), rgb.data(), count);
+        kernels->expandRgb(actual.data(), rgb.data(), count);
+        EXPECT_EQ(actual, expected);
+
+        std::vector<uint8_t> packed_expected(count * 3), packed_actual(count * 3);
+        scalar.packRgb(packed_expected.data(), source.data(), count);
+        kernels->packRgb(packed_actual.data(), source.data(), count);
+        EXPECT_EQ(packed_actual, packed_expected);
+
+        const auto * rgba = reinterpret_cast<const uint8_t *>(source.data());
+        scalar.premultiply(expected.data(), rgba, count);
+        kernels->premultiply(actual.data(), rgba, count);
+        EXPECT_EQ(actual, expected);
+
+        // Random sources are not valid premultiplied pixels, which also
+        // exercises saturation.
+        expected = destination;
+        actual = destination;
+        scalar.blendPremultiplied(expected.data(), source.data(), count);
+        kernels->blendPremultiplied(actual.data(), source.data(), count);
+        EXPECT_EQ(actual, expected);
+
+        uint64_t sums_expected[4] = {1, 2, 3, 4};
+        uint64_t sums_actual[4] = {1, 2, 3, 4};
+        scalar.sumChannels(source.data(), count, sums_expected);
+        kernels->sumChannels(source.data(), count, sums_actual);
+        for(int c = 0; c < 4; ++c) {
+            EXPECT_EQ(sums_actual[c], sums_expected[c]) << "byte " << c;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Lengths, PixelKernelsTest, testing::Values(0, 1, 3, 7, 16, 37, 128));
+
+TEST(PixelKernelsTest, BlendRoundsExactly) {
+    const auto& scalar = pixel_kernels::scalarKernels();
+    uint32_t destination = MemoryCanvas::pack(0, 0, 0, 0);
+    const uint32_t source = MemoryCanvas::pack(255, 100, 1, 255);
+    scalar.blend(&destination, &source, 1, 128);
+    EXPECT_EQ(MemoryCanvas::red(destination), 128);
+    EXPECT_EQ(MemoryCanvas::green(destination), 50);
+    EXPECT_EQ(MemoryCanvas::blue(destination), 1);
+    EXPECT_EQ(MemoryCanvas::alpha(destination), 128);
+}
+
+TEST(PixelKernelsTest, PremultipliedBlendIsSourceOver) {
+    const auto& scalar = pixel_kernels::scalarKernels();
+    const uint8_t straight[4] = {255, 100, 0, 128};
+    uint32_t source;
+    scalar.premultiply(&source, straight, 1);
+    EXPECT_EQ(source, MemoryCanvas::pack(128, 50, 0, 128));
+
+    uint32_t destination = MemoryCanvas::pack(0, 0, 255, 255);
+    scalar.blendPremultiplied(&destination, &source, 1);
+    EXPECT_EQ(destination, MemoryCanvas::pack(128, 50, 127, 255));
+}
+
+TEST(MemoryCanvasTest, RowsAreAligned) {
+    MemoryCanvas canvas(13, 5);
+    EXPECT_GE(canvas.stride(), 13);
+    for(int y = 0; y < canvas.height(); ++y) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(canvas.row(y)) % 32, 0u);
+    }
+}
+
+TEST(MemoryCanvasTest, ClearIsTransparentAndDrawingIsOpaque) {
+    MemoryCanvas canvas(4, 4);
+    EXPECT_EQ(canvas.pixel(2, 2), 0u);
+    canvas.setPixel(2, 2, 1, 2, 3);
+    EXPECT_EQ(canvas.pixel(2, 2), MemoryCanvas::pack(1, 2, 3, 255));
+    canvas.setPixel(-1, 9, 1, 2, 3);
+    canvas.clear();
+    EXPECT_EQ(canvas.pixel(2, 2), 0u);
+}
+
+TEST(MemoryCanvasTest, FillsAreClipped) {
+    MemoryCanvas canvas(8, 4);
+    canvas.fillRegion(-2, 2, 4, 10, 9, 9, 9);
+    canvas.drawSpan(10, 6, 0, 1, 1, 1);
+    EXPECT_EQ(canvas.pixel(0, 2), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(canvas.pixel(1, 3), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(canvas.pixel(2, 3), 0u);
+    EXPECT_EQ(canvas.pixel(5, 0), 0u);
+    EXPECT_EQ(canvas.pixel(6, 0), MemoryCanvas::pack(1, 1, 1));
+    EXPECT_EQ(canvas.pixel(7, 0), MemoryCanvas::pack(1, 1, 1));
+}
+
+TEST(MemoryCanvasTest, BlitAndCopyTo) {
+    MemoryCanvas source(3, 2);
+    const std::vector<uint8_t> rgb{
+        1, 2, 3,  4, 5, 6,  7, 8, 9,
+        10, 11, 12,  13, 14, 15,  16, 17, 18,
+    };
+    source.blit(rgb.data(), 9, 0, 0, 3, 2);
+    EXPECT_EQ(source.pixel(2, 1), MemoryCanvas::pack(16, 17, 18));
+
+    MemoryCanvas target(4, 4);
+    source.copyTo(target, 2, 3);
+    EXPECT_EQ(target.pixel(2, 3), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(target.pixel(3, 3), MemoryCanvas::pack(4, 5, 6));
+    EXPECT_EQ(target.pixel(1, 3), 0u);
+}
+
+TEST(MemoryCanvasTest, BlendBlitCompositesWithAlpha) {
+    MemoryCanvas canvas(4, 2);
+    canvas.fill(0, 0, 255);
+    const std::vector<uint8_t> rgba{
+        255, 0, 0, 0,  255, 0, 0, 128,  255, 0, 0, 255,
+    };
+    canvas.blendBlit(rgba.data(), 12, 2, 1, 3, 1);
+    EXPECT_EQ(canvas.pixel(1, 1), MemoryCanvas::pack(0, 0, 255));
+    EXPECT_EQ(canvas.pixel(2, 1), MemoryCanvas::pack(0, 0, 255));
+    EXPECT_EQ(canvas.pixel(3, 1), MemoryCanvas::pack(128, 0, 127));
+
+    canvas.setPixelRGBA(0, 0, 255, 255, 255, 255);
+    EXPECT_EQ(canvas.pixel(0, 0), MemoryCanvas::pack(255, 255, 255));
+}
+
+TEST(MemoryCanvasTest, CompositeStacksLayers) {
+    MemoryCanvas layer(2, 1);
+    layer.setPixelRGBA(0, 0, 255, 0, 0, 128);
+
+    MemoryCanvas target(2, 1);
+    target.fill(0, 255, 0);
+    target.compositeFrom(layer);
+    EXPECT_EQ(target.pixel(0, 0), MemoryCanvas::pack(128, 127, 0));
+    // Untouched layer pixels are transparent.
+    EXPECT_EQ(target.pixel(1, 0), MemoryCanvas::pack(0, 255, 0));
+}
+
+TEST(MemoryCanvasTest, ViewsOnlyClearTheirOwnPixels) {
+    MemoryCanvas canvas(8, 4);
+    canvas.fill(1, 2, 3);
+    MemoryCanvas view(canvas.row(1) + 2, 3, 2, canvas.stride());
+    view.clear();
+    EXPECT_EQ(canvas.pixel(2, 1), 0u);
+    EXPECT_EQ(canvas.pixel(4, 2), 0u);
+    EXPECT_EQ(canvas.pixel(5, 1), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(canvas.pixel(1, 2), MemoryCanvas::pack(1, 2, 3));
+    view.fill(9, 9, 9);
+    EXPECT_EQ(canvas.pixel(4, 2), MemoryCanvas::pack(9, 9, 9));
+    EXPECT_EQ(canvas.pixel(5, 2), MemoryCanvas::pack(1, 2, 3));
+    EXPECT_EQ(canvas.pixel(2, 3), MemoryCanvas::pack(1, 2, 3));
+}
@@ -0,0 +1,48 @@
+#ifndef PROTOGEN_MEMORYRENDERSURFACE_H
+#define PROTOGEN_MEMORYRENDERSURFACE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <protogen/IRenderSurface.hpp>
+#include <protogen/StandardAttributeStore.hpp>
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+
+namespace protogen {
+
+/**
+ * A render surface for tests which draws into `frame`. Like real surfaces,
+ * every frame starts black. Its id is `memory`.
+ */
+class MemoryRenderSurface : public IRenderSurface {
+public:
+    MemoryRenderSurface(int width, int height) : frame(width, height), m_attributes(new StandardAttributeStore()) {
+        m_attributes->setAttribute(attributes::A_ID, "memory");
+    }
+    Initialization initialize() override { return Initialization::Success; }
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override {
+        frame.clear();
+        drawer(frame);
+        ++frames;
+    }
+    Resolution resolution() const override { return Resolution(frame.width(), frame.height()); }
+    std::optional<std::string> getAttribute(const std::string& key) const override { return m_attributes->getAttribute(key); }
+    std::vector<std::string> listAttributes() const override { return m_attributes->listAttributes(); }
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override { return m_attributes->setAttribute(key, value); }
+    RemoveAttributeResult removeAttribute(const std::string& key) override { return m_attributes->removeAttribute(key); }
+    bool hasAttribute(const std::string& key) const override { return m_attributes->hasAttribute(key); }
+
+    MemoryCanvas frame;
+    std::atomic<int> frames{0}; // Frames drawn so far.
+private:
+    std::shared_ptr<attributes::IAttributeStore> m_attributes;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/PowerGovernor.h>
+
+using namespace protogen;
+
+namespace {
+
+PowerGovernor::Config testConfig() {
+    // 1 mA per full channel, 100 mA idle, 1100 mA budget.
+    return PowerGovernor::Config{1.0, 1.0, 1.0, 100.0, 1100.0, 0.5, 5.0};
+}
+
+} // namespace
+
+TEST(PowerGovernorTest, EstimatesFromChannelTotals) {
+    PowerGovernor governor(testConfig());
+    EXPECT_DOUBLE_EQ(governor.estimateMilliamps(0, 0, 0), 100.0);
+    EXPECT_DOUBLE_EQ(governor.estimateMilliamps(255 * 10, 255 * 20, 0), 130.0);
+}
+
+TEST(PowerGovernorTest, StaysAtFullBrightnessWithinBudget) {
+    PowerGovernor governor(testConfig());
+    EXPECT_EQ(governor.update(1000.0), 255);
+    EXPECT_DOUBLE_EQ(governor.milliwatts(), 5000.0);
+}
+
+TEST(PowerGovernorTest, DimsAtOnceAndRecoversGradually) {
+    PowerGovernor governor(testConfig());
+    // 2100 mA of LEDs with room for 1000 mA.
+    const uint8_t limited = governor.update(2200.0);
+    EXPECT_EQ(limited, 121);
+    EXPECT_LE(governor.milliwatts(), 1100.0 * 5.0);
+
+    const uint8_t recovering = governor.update(500.0);
+    EXPECT_GT(recovering, limited);
+    EXPECT_LT(recovering, 255);
+    for(int i = 0; i < 20; ++i) {
+        governor.update(500.0);
+    }
+    EXPECT_EQ(governor.brightness(), 255);
+}
+
+TEST(PowerGovernorTest, ZeroBudgetTurnsLimitingOff) {
+    auto config = testConfig();
+    config.budget_ma = 0;
+    PowerGovernor governor(config);
+    EXPECT_EQ(governor.update(100000.0), 255);
+}
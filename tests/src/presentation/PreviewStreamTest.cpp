@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/PreviewEncoding.h>
+#include <protogen/presentation/PreviewStream.h>
+
+using namespace protogen;
+
+namespace {
+
+std::vector<uint8_t> makeFrame(int width, int height, int seed) {
+    std::vector<uint8_t> rgb(width * height * 3, 0);
+    // A solid block, a gradient row and a few scattered pixels.
+    for(int y = 2; y < 6; ++y) {
+        for(int x = seed % 10; x < seed % 10 + 8; ++x) {
+            rgb[(y * width + x) * 3] = 200;
+            rgb[(y * width + x) * 3 + 2] = 40;
+        }
+    }
+    for(int x = 0; x < width; ++x) {
+        rgb[(9 * width + x) * 3 + 1] = static_cast<uint8_t>(x * 7 + seed);
+    }
+    for(int i = 0; i < 5; ++i) {
+        rgb[((i * 31 + seed * 7) % (width * height)) * 3] = 255;
+    }
+    return rgb;
+}
+
+} // namespace
+
+TEST(PreviewEncodingTest, KeyAndDeltaFramesRoundTrip) {
+    const int width = 150;
+    const int height = 12;
+    std::vector<uint8_t> previous(width * height * 3, 0);
+    std::vector<uint8_t> decoded;
+    std::vector<uint8_t> encoded;
+    for(int seed = 0; seed < 6; ++seed) {
+        const auto frame = makeFrame(width, height, seed);
+        const auto type = seed == 0 ? preview::FrameType::Key : preview::FrameType::Delta;
+        preview::encode(type, width, height, seed, frame, previous, encoded);
+        ASSERT_TRUE(preview::decode(encoded.data(), encoded.size(), decoded)) << "frame " << seed;
+        ASSERT_EQ(decoded, frame) << "frame " << seed;
+        previous = frame;
+    }
+
+    // An unchanged frame only costs the header and skip runs.
+    preview::encode(preview::FrameType::Delta, width, height, 7, previous, previous, encoded);
+    EXPECT_LE(encoded.size(), preview::HEADER_SIZE + (width * height + 63) / 64);
+    EXPECT_TRUE(preview::decode(encoded.data(), encoded.size(), decoded));
+    EXPECT_EQ(decoded, previous);
+}
+
+TEST(PreviewEncodingTest, RejectsMismatchedFrames) {
+    std::vector<uint8_t> encoded;
+    const std::vector<uint8_t> frame(4 * 4 * 3, 1);
+    preview::encode(preview::FrameType::Delta, 4, 4, 1, frame, frame, encoded);
+    std::vector<uint8_t> wrong_size(3 * 4 * 3, 0);
+    EXPECT_FALSE(preview::decode(encoded.data(), encoded.size(), wrong_size));
+    encoded.pop_back();
+    std::vector<uint8_t> right_size(4 * 4 * 3, 0);
+    EXPECT_FALSE(preview::decode(encoded.data(), encoded.size(), right_size));
+}
+
+TEST(PreviewEncodingTest, Base64) {
+    EXPECT_EQ(preview::toBase64({}), "");
+    EXPECT_EQ(preview::toBase64({'f'}), "Zg==");
+    EXPECT_EQ(preview::toBase64({'f', 'o'}), "Zm8=");
+    EXPECT_EQ(preview::toBase64({'f', 'o', 'o', 'b'}), "Zm9vYg==");
+}
+
+TEST(PreviewStreamTest, SharesMessagesPerTier) {
+    PreviewStream stream(20, 10);
+    EXPECT_FALSE(stream.hasSubscribers());
+    const std::size_t tier = stream.subscribe(12);
+    EXPECT_EQ(PreviewStream::TIER_RATES[tier], 10);
+    EXPECT_EQ(stream.subscribe(10), tier);
+    EXPECT_TRUE(stream.hasSubscribers());
+
+    auto time = std::chrono::steady_clock::now();
+    stream.pushFrame(makeFrame(20, 10, 1), time);
+    // Too soon for 10 frames per second.
+    stream.pushFrame(makeFrame(20, 10, 2), time + std::chrono::milliseconds(20));
+
+    const auto first = stream.next(tier, 0, std::chrono::milliseconds(0));
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->sequence, 1u);
+    const auto again = stream.next(tier, 0, std::chrono::milliseconds(0));
+    EXPECT_EQ(again->data, first->data);
+    EXPECT_FALSE(stream.next(tier, first->sequence, std::chrono::milliseconds(0)).has_value());
+
+    stream.pushFrame(makeFrame(20, 10, 3), time + std::chrono::milliseconds(100));
+    stream.pushFrame(makeFrame(20, 10, 4), time + std::chrono::milliseconds(200));
+    // A client which kept up gets a delta, one which fell behind a key frame.
+    const auto delta = stream.next(tier, 2, std::chrono::milliseconds(0));
+    const auto key = stream.next(tier, 1, std::chrono::milliseconds(0));
+    ASSERT_TRUE(delta.has_value());
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(delta->sequence, 3u);
+    EXPECT_EQ(key->sequence, 3u);
+    EXPECT_NE(*delta->data, *key->data);
+
+    stream.unsubscribe(tier);
+    stream.unsubscribe(tier);
+    EXPECT_FALSE(stream.hasSubscribers());
+}
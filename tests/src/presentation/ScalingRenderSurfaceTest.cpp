@@ -0,0 +1,40 @@
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/ScalingRenderSurface.h>
+
+#include "MemoryRenderSurface.h"
+
+using namespace protogen;
+
+TEST(ScalingRenderSurfaceTest, DrawsAtTheLogicalResolution) {
+    auto physical = std::make_shared<MemoryRenderSurface>(128, 32);
+    ScalingRenderSurface surface(physical, Resolution(64, 16), ImageScaler::Filter::Nearest);
+    EXPECT_EQ(surface.resolution().width(), 64u);
+    EXPECT_EQ(surface.resolution().height(), 16u);
+    EXPECT_EQ(surface.getAttribute(attributes::A_ID), "memory");
+
+    surface.drawFrame([](ICanvas& canvas){
+        EXPECT_EQ(canvas.width(), 64);
+        canvas.setPixel(63, 15, 9, 8, 7);
+    });
+    EXPECT_EQ(physical->frame.pixel(126, 30), MemoryCanvas::pack(9, 8, 7));
+    EXPECT_EQ(physical->frame.pixel(127, 31), MemoryCanvas::pack(9, 8, 7));
+    EXPECT_EQ(physical->frame.pixel(125, 31), MemoryCanvas::pack(0, 0, 0));
+}
+
+TEST(ScalingRenderSurfaceTest, ParsesSettings) {
+    const auto resolution = ScalingRenderSurface::parseResolution("128x32");
+    ASSERT_TRUE(resolution.has_value());
+    EXPECT_EQ(resolution->width(), 128u);
+    EXPECT_EQ(resolution->height(), 32u);
+    EXPECT_FALSE(ScalingRenderSurface::parseResolution("128").has_value());
+    EXPECT_FALSE(ScalingRenderSurface::parseResolution("0x32").has_value());
+    EXPECT_FALSE(ScalingRenderSurface::parseResolution("128x32px").has_value());
+    EXPECT_EQ(ScalingRenderSurface::parseFilter("bilinear"), ImageScaler::Filter::Bilinear);
+    EXPECT_FALSE(ScalingRenderSurface::parseFilter("cubic").has_value());
+}
@@ -0,0 +1,131 @@
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/SplitScreen.h>
+
+#include "MemoryRenderSurface.h"
+
+using namespace protogen;
+
+namespace {
+
+/**
+ * Holds the first frame until `release` is set.
+ */
+class BlockingRenderSurface : public MemoryRenderSurface {
+public:
+    using MemoryRenderSurface::MemoryRenderSurface;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override {
+        if(frames == 0) {
+            entered.set_value();
+            release.get_future().wait();
+        }
+        MemoryRenderSurface::drawFrame(drawer);
+    }
+
+    std::promise<void> entered;
+    std::promise<void> release;
+};
+
+/**
+ * Throws from its first frame.
+ */
+class ThrowingRenderSurface : public MemoryRenderSurface {
+public:
+    using MemoryRenderSurface::MemoryRenderSurface;
+    void drawFrame(const std::function<void(ICanvas&)>& drawer) override {
+        if(!thrown) {
+            thrown = true;
+            throw std::runtime_error("frame lost");
+        }
+        MemoryRenderSurface::drawFrame(drawer);
+    }
+
+    bool thrown = false;
+};
+
+} // namespace
+
+TEST(SplitScreenTest, RejectsWindowsWhichDoNotFitOrOverlap) {
+    auto split_screen = SplitScreen::make(std::make_shared<MemoryRenderSurface>(16, 8));
+    EXPECT_TRUE(split_screen->addWindow(Window{0, 0, Resolution(8, 8)}).has_value());
+    EXPECT_FALSE(split_screen->addWindow(Window{7, 0, Resolution(4, 4)}).has_value());
+    EXPECT_FALSE(split_screen->addWindow(Window{12, 0, Resolution(8, 8)}).has_value());
+    EXPECT_TRUE(split_screen->addWindow(Window{8, 0, Resolution(8, 8)}).has_value());
+}
+
+TEST(SplitScreenTest, WindowsDrawConcurrently) {
+    auto parent = std::make_shared<MemoryRenderSurface>(16, 8);
+    auto split_screen = SplitScreen::make(parent);
+    auto left = split_screen->addWindow(Window{0, 0, Resolution(8, 8)}).value();
+    auto right = split_screen->addWindow(Window{8, 0, Resolution(8, 8)}).value();
+    EXPECT_EQ(right->resolution().width(), 8u);
+
+    auto draw = [](std::shared_ptr<IRenderSurface> surface, uint8_t value){
+        for(int i = 0; i < 200; ++i) {
+            surface->drawFrame([value](ICanvas& canvas){
+                canvas.fill(value, value, value);
+                canvas.setPixel(100, 100, 1, 1, 1);
+            });
+        }
+    };
+    std::thread left_thread(draw, left, 10);
+    std::thread right_thread(draw, right, 20);
+    left_thread.join();
+    right_thread.join();
+
+    for(int y = 0; y < 8; ++y) {
+        EXPECT_EQ(parent->frame.pixel(7, y), MemoryCanvas::pack(10, 10, 10));
+        EXPECT_EQ(parent->frame.pixel(8, y), MemoryCanvas::pack(20, 20, 20));
+    }
+}
+
+TEST(SplitScreenTest, NamesWindowsAfterTheParent) {
+    auto split_screen = SplitScreen::make(std::make_shared<MemoryRenderSurface>(16, 8));
+    auto left = split_screen->addWindow(Window{0, 0, Resolution(8, 8)}).value();
+    auto right = split_screen->addWindow(Window{8, 0, Resolution(8, 8)}).value();
+    EXPECT_EQ(left->getAttribute(attributes::A_ID), "memory_window_1");
+    EXPECT_EQ(right->getAttribute(attributes::A_ID), "memory_window_2");
+    EXPECT_EQ(right->getAttribute(attributes::A_NAME), "Window 2 of Split Screen");
+}
+
+TEST(SplitScreenTest, PresentsFramesFinishedMeanwhileOnce) {
+    auto parent = std::make_shared<BlockingRenderSurface>(16, 8);
+    auto split_screen = SplitScreen::make(parent);
+    auto left = split_screen->addWindow(Window{0, 0, Resolution(8, 8)}).value();
+    auto right = split_screen->addWindow(Window{8, 0, Resolution(8, 8)}).value();
+    const auto fill = [](uint8_t value){
+        return [value](ICanvas& canvas){ canvas.fill(value, value, value); };
+    };
+
+    std::thread presenting([&]{ left->drawFrame(fill(10)); });
+    parent->entered.get_future().wait();
+    // Returns without waiting for the parent.
+    right->drawFrame(fill(20));
+    right->drawFrame(fill(30));
+    parent->release.set_value();
+    presenting.join();
+
+    EXPECT_EQ(parent->frames, 2);
+    EXPECT_EQ(parent->frame.pixel(0, 0), MemoryCanvas::pack(10, 10, 10));
+    EXPECT_EQ(parent->frame.pixel(15, 7), MemoryCanvas::pack(30, 30, 30));
+}
+
+TEST(SplitScreenTest, KeepsPresentingAfterTheParentThrew) {
+    auto parent = std::make_shared<ThrowingRenderSurface>(16, 8);
+    auto split_screen = SplitScreen::make(parent);
+    auto left = split_screen->addWindow(Window{0, 0, Resolution(8, 8)}).value();
+    const auto fill = [](ICanvas& canvas){ canvas.fill(10, 10, 10); };
+
+    EXPECT_THROW(left->drawFrame(fill), std::runtime_error);
+    left->drawFrame(fill);
+    EXPECT_EQ(parent->frames, 1);
+    EXPECT_EQ(parent->frame.pixel(0, 0), MemoryCanvas::pack(10, 10, 10));
+}
@@ -0,0 +1,120 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/SpriteAtlas.h>
+#include <protogen/presentation/BasicCanvas.h>
+#include <protogen/presentation/MemoryCanvas.h>
+
+using namespace protogen;
+
+namespace {
+
+/**
+ * Counts blit and blend calls on top of a MemoryCanvas.
+ */
+class CountingCanvas : public MemoryCanvas {
+public:
+    using MemoryCanvas::MemoryCanvas;
+    void blit(const uint8_t* rgb, int stride, int x, int y, int width, int height) override {
+        ++m_blits;
+        MemoryCanvas::blit(rgb, stride, x, y, width, height);
+    }
+    void blendBlit(const uint8_t* rgba, int stride, int x, int y, int width, int height) override {
+        ++m_blends;
+        MemoryCanvas::blendBlit(rgba, stride, x, y, width, height);
+    }
+    int m_blits = 0;
+    int m_blends = 0;
+};
+
+std::vector<uint8_t> solid(int width, int height, uint8_t alpha) {
+    std::vector<uint8_t> rgba;
+    for(int i = 0; i < width * height; ++i) {
+        rgba.insert(rgba.end(), {static_cast<uint8_t>(i), 20, 30, alpha});
+    }
+    return rgba;
+}
+
+} // namespace
+
+TEST(SpriteAtlasTest, OpaqueSpriteIsOneBlit) {
+    SpriteAtlas atlas;
+    auto rgba = solid(6, 4, 0);
+    // Opaque 3x2 block in the middle of transparent padding.
+    for(int y = 1; y < 3; ++y) {
+        for(int x = 2; x < 5; ++x) {
+            rgba[(y * 6 + x) * 4 + 3] = 255;
+        }
+    }
+    const auto id = atlas.add(rgba.data(), 6 * 4, 6, 4);
+    EXPECT_EQ(id, 0u);
+    EXPECT_EQ(atlas.width(id), 6);
+    EXPECT_EQ(atlas.height(id), 4);
+
+    CountingCanvas canvas(8, 8);
+    atlas.draw(canvas, id, 1, 1);
+    EXPECT_EQ(canvas.m_blits, 1);
+    EXPECT_EQ(canvas.m_blends, 0);
+    EXPECT_EQ(canvas.pixel(3, 2), MemoryCanvas::pack(8, 20, 30));
+    EXPECT_EQ(canvas.pixel(5, 3), MemoryCanvas::pack(16, 20, 30));
+    EXPECT_EQ(canvas.pixel(2, 2), 0u);
+    EXPECT_EQ(canvas.pixel(6, 2), 0u);
+}
+
+TEST(SpriteAtlasTest, MatchesBlendingTheWholeImage) {
+    const int width = 7;
+    const int height = 5;
+    std::vector<uint8_t> rgba = solid(width, height, 255);
+    const uint8_t alphas[] = {0, 255, 128, 255, 0, 1, 255};
+    for(int y = 0; y < height; ++y) {
+        for(int x = 0; x < width; ++x) {
+            rgba[(y * width + x) * 4 + 3] = alphas[(x + y / 2) % 7];
+        }
+    }
+    SpriteAtlas atlas;
+    atlas.add(solid(2, 2, 255).data(), 2 * 4, 2, 2);
+    const auto id = atlas.add(rgba.data(), width * 4, width, height);
+    EXPECT_EQ(id, 1u);
+    EXPECT_EQ(atlas.size(), 2u);
+
+    MemoryCanvas expected(10, 10);
+    expected.fill(50, 60, 70);
+    MemoryCanvas actual(expected);
+    expected.blendBlit(rgba.data(), width * 4, -1, 4, width, height);
+    atlas.draw(actual, id, -1, 4);
+    for(int y = 0; y < 10; ++y) {
+        for(int x = 0; x < 10; ++x) {
+            ASSERT_EQ(actual.pixel(x, y), expected.pixel(x, y)) << x << ", " << y;
+        }
+    }
+
+    // Unknown ids and fully transparent sprites draw nothing.
+    const auto empty = atlas.add(solid(3, 3, 0).data(), 3 * 4, 3, 3);
+    CountingCanvas canvas(4, 4);
+    atlas.draw(canvas, empty, 0, 0);
+    atlas.draw(canvas, 42, 0, 0);
+    EXPECT_EQ(canvas.m_blits + canvas.m_blends, 0);
+}
+
+TEST(SpriteAtlasTest, CopiesPixelsOntoCanvasesOfItsFormat) {
+    auto rgba = solid(3, 2, 255);
+    rgba[1 * 4 + 3] = 0;
+    rgba[4 * 4 + 3] = 128;
+    BasicSpriteAtlas<pixel_formats::Rbg888> atlas;
+    const auto id = atlas.add(rgba.data(), 3 * 4, 3, 2);
+
+    BasicCanvas<pixel_formats::Rbg888> canvas(4, 3);
+    canvas.fill(50, 60, 70);
+    BasicCanvas<pixel_formats::Rbg888> expected(canvas);
+    expected.blendBlit(rgba.data(), 3 * 4, 2, 1, 3, 2);
+    // Partly outside the canvas.
+    atlas.draw(canvas, id, 2, 1);
+    for(int y = 0; y < 3; ++y) {
+        for(int x = 0; x < 4; ++x) {
+            ASSERT_EQ(canvas.pixel(x, y), expected.pixel(x, y)) << x << ", " << y;
+        }
+    }
+    EXPECT_EQ(canvas.pixel(2, 1), pixel_formats::Rbg888::pack(0, 20, 30));
+    EXPECT_EQ(canvas.pixel(3, 1), pixel_formats::Rbg888::pack(50, 60, 70));
+}
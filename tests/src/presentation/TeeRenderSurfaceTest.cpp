@@ -0,0 +1,154 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <protogen/FrameTap.hpp>
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/presentation/FrameTapSink.h>
+#include <protogen/presentation/MemoryCanvas.h>
+#include <protogen/presentation/TeeRenderSurface.h>
+
+#include "MemoryRenderSurface.h"
+
+using namespace protogen;
+
+namespace {
+
+/**
+ * Counts frames and keeps the color of the top-left pixel of the last one.
+ */
+class CountingSink : public TeeRenderSurface::Sink {
+public:
+    void consumeFrame(const TeeRenderSurface::RecordedFrame& frame) override {
+        MemoryCanvas canvas(1, 1);
+        frame.list.replay(canvas);
+        pixel = canvas.pixel(0, 0);
+        last_frame = frame.frame_number;
+        ++frames;
+    }
+
+    std::atomic<uint32_t> pixel{0};
+    std::atomic<uint64_t> last_frame{0};
+    std::atomic<int> frames{0};
+};
+
+} // namespace
+
+TEST(TeeRenderSurfaceTest, RecordsOnceForEverySink) {
+    auto inner = std::make_shared<MemoryRenderSurface>(4, 4);
+    TeeRenderSurface surface(inner);
+    ASSERT_EQ(surface.initialize(), IExtension::Initialization::Success);
+    EXPECT_EQ(surface.getAttribute(attributes::A_ID), "memory");
+    auto every_frame = std::make_shared<CountingSink>();
+    auto latest = std::make_shared<CountingSink>();
+    auto other_latest = std::make_shared<CountingSink>();
+    surface.addSink(every_frame, TeeRenderSurface::Delivery::EveryFrame);
+    surface.addSink(latest, TeeRenderSurface::Delivery::Latest);
+    surface.addSink(other_latest, TeeRenderSurface::Delivery::Latest);
+
+    int draws = 0;
+    for(int i = 1; i <= 5; ++i) {
+        surface.drawFrame([&draws, i](ICanvas& canvas){
+            ++draws;
+            canvas.setPixel(0, 0, i, 0, 0);
+        });
+    }
+    EXPECT_EQ(draws, 5);
+    EXPECT_EQ(inner->frames, 5);
+    EXPECT_EQ(inner->frame.pixel(0, 0), MemoryCanvas::pack(5, 0, 0));
+    EXPECT_EQ(every_frame->frames, 5);
+    EXPECT_EQ(every_frame->last_frame, 5u);
+
+    // Sinks on the consumer thread may skip frames, but get the last one.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while((latest->last_frame < 5 || other_latest->last_frame < 5) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for(const auto& sink : {latest, other_latest}) {
+        EXPECT_EQ(sink->last_frame, 5u);
+        EXPECT_EQ(sink->pixel, MemoryCanvas::pack(5, 0, 0));
+        EXPECT_LE(sink->frames, 5);
+    }
+}
+
+TEST(TeeRenderSurfaceTest, NumbersFramesDrawnFromManyThreads) {
+    auto inner = std::make_shared<MemoryRenderSurface>(4, 4);
+    TeeRenderSurface surface(inner);
+    auto every_frame = std::make_shared<CountingSink>();
+    surface.addSink(every_frame, TeeRenderSurface::Delivery::EveryFrame);
+    surface.addSink(std::make_shared<CountingSink>(), TeeRenderSurface::Delivery::Latest);
+
+    std::vector<std::thread> threads;
+    for(int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&surface, thread]{
+            for(int frame = 0; frame < 50; ++frame) {
+                surface.drawFrame([thread](ICanvas& canvas){
+                    canvas.fill(thread, thread, thread);
+                });
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(inner->frames, 200);
+    EXPECT_EQ(every_frame->frames, 200);
+    EXPECT_EQ(every_frame->last_frame, 200u);
+}
+
+TEST(TeeRenderSurfaceTest, ExportsShownFramesToSharedMemory) {
+    const std::string name = "/protogen_frame_tap_test_" + std::to_string(getpid());
+    auto inner = std::make_shared<MemoryRenderSurface>(20, 10);
+    auto frame_tap = std::make_shared<FrameTapSink>(inner->resolution(), name);
+    ASSERT_EQ(frame_tap->initialize(), IInitializable::Initialization::Success);
+    TeeRenderSurface surface(inner);
+    surface.addSink(frame_tap, TeeRenderSurface::Delivery::Latest);
+
+    for(int i = 0; i < 3; ++i) {
+        surface.drawFrame([i](ICanvas& canvas){
+            canvas.fillRegion(2, 3, 5, 4, 10 * i, 20, 30);
+        });
+    }
+    EXPECT_EQ(inner->frame.pixel(2, 3), MemoryCanvas::pack(20, 20, 30));
+
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    struct stat info;
+    ASSERT_EQ(fstat(fd, &info), 0);
+    void * memory = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(memory, MAP_FAILED);
+    const auto * header = static_cast<const frame_tap::Header *>(memory);
+    EXPECT_EQ(std::string(header->magic, 8), std::string(frame_tap::MAGIC, 8));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(header->latest_frame.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(header->latest_frame.load(), 3u);
+
+    const frame_tap::SlotHeader * slot = frame_tap::slot(header, 3);
+    uint32_t sequence;
+    ASSERT_TRUE(frame_tap::beginRead(slot, sequence));
+    EXPECT_EQ(slot->frame_number, 3u);
+    EXPECT_EQ(slot->width, 20u);
+    EXPECT_EQ(slot->height, 10u);
+    const unsigned char * pixel = frame_tap::pixels(slot) + 3 * slot->stride + 2 * 4;
+    EXPECT_EQ(pixel[0], 20);
+    EXPECT_EQ(pixel[1], 20);
+    EXPECT_EQ(pixel[2], 30);
+    EXPECT_EQ(frame_tap::pixels(slot)[0], 0);
+    EXPECT_TRUE(frame_tap::endRead(slot, sequence));
+
+    munmap(memory, info.st_size);
+}
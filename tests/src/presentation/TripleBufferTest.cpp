@@ -0,0 +1,54 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <protogen/presentation/TripleBuffer.h>
+
+using namespace protogen;
+
+TEST(TripleBufferTest, AcquiresNewestValue) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.acquire());
+
+    buffer.back() = 1;
+    EXPECT_FALSE(buffer.publish());
+    buffer.back() = 2;
+    EXPECT_TRUE(buffer.publish());
+
+    ASSERT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 2);
+    EXPECT_FALSE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 2);
+
+    buffer.back() = 3;
+    EXPECT_FALSE(buffer.publish());
+    ASSERT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.front(), 3);
+}
+
+TEST(TripleBufferTest, ConsumerSeesCompleteIncreasingValues) {
+    struct Value {
+        int first;
+        int second;
+    };
+    TripleBuffer<Value> buffer;
+    const int count = 100000;
+
+    std::thread producer([&buffer] {
+        for(int i = 1; i <= count; ++i) {
+            buffer.back() = {i, -i};
+            buffer.publish();
+        }
+    });
+
+    int last = 0;
+    while(last < count) {
+        if(buffer.acquire()) {
+            const Value value = buffer.front();
+            EXPECT_EQ(value.first, -value.second);
+            EXPECT_GT(value.first, last);
+            last = value.first;
+        }
+    }
+    producer.join();
+}
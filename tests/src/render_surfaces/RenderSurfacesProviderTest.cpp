@@ -0,0 +1,174 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <protogen/StandardAttributeStore.hpp>
+#include <protogen/StandardAttributes.hpp>
+#include <protogen/extensions/checks/RequiredAttributesCheck.h>
+#include <protogen/extensions/finders/StaticExtensionFinder.h>
+#include <protogen/render_surfaces/RenderSurfacesProvider.h>
+
+using namespace protogen;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * Initializes with `probe`, and counts how often it was initialized.
+ */
+class ProbedRenderSurface : public IRenderSurface {
+public:
+    ProbedRenderSurface(const std::string& id, std::function<Initialization()> probe)
+        : probes(0), m_probe(std::move(probe)), m_attributes(new StandardAttributeStore())
+    {
+        m_attributes->setAttribute(attributes::A_ID, id);
+        m_attributes->setAttribute(attributes::A_NAME, id);
+        m_attributes->setAttribute(attributes::A_DESCRIPTION, "A render surface for tests.");
+        m_attributes->setAttribute(attributes::A_AUTHOR, "tests");
+    }
+    Initialization initialize() override {
+        ++probes;
+        return m_probe();
+    }
+    void drawFrame(const std::function<void(ICanvas&)>&) override {}
+    Resolution resolution() const override { return Resolution(1, 1); }
+    std::optional<std::string> getAttribute(const std::string& key) const override { return m_attributes->getAttribute(key); }
+    std::vector<std::string> listAttributes() const override { return m_attributes->listAttributes(); }
+    SetAttributeResult setAttribute(const std::string& key, const std::string& value) override { return m_attributes->setAttribute(key, value); }
+    RemoveAttributeResult removeAttribute(const std::string& key) override { return m_attributes->removeAttribute(key); }
+    bool hasAttribute(const std::string& key) const override { return m_attributes->hasAttribute(key); }
+
+    std::atomic<int> probes;
+private:
+    std::function<Initialization()> m_probe;
+    std::shared_ptr<attributes::IAttributeStore> m_attributes;
+};
+
+class DirectInitializer : public IExtensionInitializer {
+public:
+    Initialization initialize(ExtensionOriginBundle extension) override {
+        return extension.extension->initialize() == IExtension::Initialization::Success ? Initialization::Success : Initialization::Failure;
+    }
+};
+
+/**
+ * Holds probes until it is opened.
+ */
+class Gate {
+public:
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]{ return m_open; });
+    }
+    void open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_changed.notify_all();
+    }
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_open = false;
+};
+
+std::shared_ptr<ProbedRenderSurface> probed(const std::string& id, IExtension::Initialization result = IExtension::Initialization::Success) {
+    return std::make_shared<ProbedRenderSurface>(id, [result]{ return result; });
+}
+
+RenderSurfacesProvider makeProvider(const std::vector<std::shared_ptr<ProbedRenderSurface>>& surfaces, std::chrono::milliseconds timeout) {
+    std::vector<ExtensionOriginBundle> bundles;
+    for(const auto& surface : surfaces) {
+        bundles.push_back(ExtensionOriginBundle{surface, {}});
+    }
+    return RenderSurfacesProvider(
+        std::shared_ptr<IExtensionFinder>(new StaticExtensionFinder(bundles)),
+        std::shared_ptr<IExtensionInitializer>(new DirectInitializer()),
+        std::shared_ptr<IExtensionCheck>(new RequiredAttributesCheck()),
+        timeout
+    );
+}
+
+} // namespace
+
+TEST(RenderSurfacesProviderTest, ProbesConcurrently) {
+    // Every probe waits for all of them to have started, which only
+    // happens if they run at the same time.
+    std::mutex mutex;
+    std::condition_variable started_changed;
+    int started = 0;
+    const auto together = [&]{
+        std::unique_lock<std::mutex> lock(mutex);
+        ++started;
+        started_changed.notify_all();
+        const bool all = started_changed.wait_for(lock, 10s, [&]{ return started == 3; });
+        return all ? IExtension::Initialization::Success : IExtension::Initialization::Failure;
+    };
+    auto provider = makeProvider({
+        std::make_shared<ProbedRenderSurface>("a", together),
+        std::make_shared<ProbedRenderSurface>("b", together),
+        std::make_shared<ProbedRenderSurface>("c", together),
+    }, 60s);
+    EXPECT_EQ(provider.loadRenderSurfaces().size(), 3u);
+}
+
+TEST(RenderSurfacesProviderTest, SkipsFailedAndSlowProbes) {
+    Gate gate;
+    auto slow = std::make_shared<ProbedRenderSurface>("slow", [&gate]{
+        gate.wait();
+        return IExtension::Initialization::Success;
+    });
+    {
+        auto provider = makeProvider({probed("fast"), probed("failing", IExtension::Initialization::Failure), slow}, 500ms);
+        const auto render_surfaces = provider.loadRenderSurfaces();
+        ASSERT_EQ(render_surfaces.size(), 1u);
+        EXPECT_TRUE(render_surfaces.contains("fast"));
+        // The provider waits for the slow probe when it is destroyed.
+        gate.open();
+    }
+    EXPECT_EQ(slow->probes, 1);
+}
+
+TEST(RenderSurfacesProviderTest, ProbesInPriorityOrderUntilOneWorks) {
+    Gate gate;
+    auto hub75 = probed("hub75_display", IExtension::Initialization::Failure);
+    auto slow = std::make_shared<ProbedRenderSurface>("slow", [&gate]{
+        gate.wait();
+        return IExtension::Initialization::Success;
+    });
+    auto window = probed("sdl_window");
+    auto other = probed("a");
+    {
+        auto provider = makeProvider({other, window, slow, hub75}, 500ms);
+        const auto preferred = provider.loadPreferredRenderSurface({"hub75_display", "slow", "sdl_window"});
+        ASSERT_TRUE(preferred.has_value());
+        EXPECT_EQ(preferred->first, "sdl_window");
+        EXPECT_EQ(preferred->second.render_surface, window);
+        gate.open();
+    }
+    EXPECT_EQ(hub75->probes, 1);
+    EXPECT_EQ(slow->probes, 1);
+    EXPECT_EQ(window->probes, 1);
+    // Never initialized once a preferred surface worked.
+    EXPECT_EQ(other->probes, 0);
+
+    auto provider = makeProvider({probed("failing", IExtension::Initialization::Failure)}, 500ms);
+    EXPECT_FALSE(provider.loadPreferredRenderSurface({}).has_value());
+}
+
+TEST(RenderSurfacesProviderTest, OrdersByPriority) {
+    std::map<std::string, RenderSurfaceOriginBundle> render_surfaces = {
+        {"a", {}}, {"b", {}}, {"hub75_display", {}}, {"sdl_window", {}},
+    };
+    const auto priority = RenderSurfacesProvider::parsePriority(" sdl_window, missing,,hub75_display ");
+    EXPECT_EQ(priority, (std::vector<std::string>{"sdl_window", "missing", "hub75_display"}));
+    EXPECT_EQ(
+        RenderSurfacesProvider::byPriority(render_surfaces, priority),
+        (std::vector<std::string>{"sdl_window", "hub75_display", "a", "b"})
+    );
+}
@@ -1,19 +1,25 @@
 #include <protogen/utils/utils.h>
 
+#include <vector>
+
 namespace protogen {
 
 void writeImageToCanvas(const Magick::Image &img, ICanvas* canvas) {
         const unsigned int width = img.columns();
         const unsigned int height = img.rows();
         const Magick::PixelPacket* pixels = img.getConstPixels(0, 0, width, height);
-        for(unsigned int y = 0; y < height; ++y) {
-                for(unsigned int x = 0; x < width; ++x) {
-                        const Magick::PixelPacket& pixel = pixels[y * width + x];
-                        if(pixel.opacity < 255) {
-                                canvas->setPixel(x, y, pixel.red, pixel.green, pixel.blue);
-                        }
-                }
+
+        // Convert the image once and hand it to the canvas in a single blend.
+        // Magick opacity is the inverse of alpha.
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        for(unsigned int i = 0; i < width * height; ++i) {
+                const Magick::PixelPacket& pixel = pixels[i];
+                rgba[i * 4] = pixel.red;
+                rgba[i * 4 + 1] = pixel.green;
+                rgba[i * 4 + 2] = pixel.blue;
+                rgba[i * 4 + 3] = 255 - pixel.opacity;
         }
+        canvas->blendBlit(rgba.data(), width * 4, 0, 0, width, height);
 }
 
 std::string read_file_to_str(const std::string& filename) {